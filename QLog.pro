@@ -36,6 +36,11 @@ DEFINES += QT_DEPRECATED_WARNINGS QT_MESSAGELOGCONTEXT
 # In order to do so, uncomment the following line.
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Uncomment the following line to remove the function entry tracing
+# (FCT_IDENTIFICATION) from the build completely.
+#DEFINES += QLOG_NO_FUNCTION_TRACING
+
 macx:QT_CONFIG -= no-pkg-config
 
 CONFIG += c++11 force_debug_info
@@ -51,10 +56,13 @@ SOURCES += \
         core/CWKey.cpp \
         core/CWKeyer.cpp \
         core/CWWinKey.cpp \
+        core/CallbookCache.cpp \
         core/CallbookManager.cpp \
+        core/CallbookPrefetcher.cpp \
         core/Callsign.cpp \
         core/ClubLog.cpp \
         core/CredentialStore.cpp \
+        core/DxClusterIngest.cpp \
         core/Eqsl.cpp \
         core/Fldigi.cpp \
         core/GenericCallbook.cpp \
@@ -64,9 +72,11 @@ SOURCES += \
         core/HostsPortString.cpp \
         core/KSTChat.cpp \
         core/LOVDownloader.cpp \
+        core/LOVIngestWorker.cpp \
         core/LogLocale.cpp \
         core/LogParam.cpp \
         core/Lotw.cpp \
+        core/LotwUploadJob.cpp \
         core/MembershipQE.cpp \
         core/Migration.cpp \
         core/NetworkNotification.cpp \
@@ -76,6 +86,8 @@ SOURCES += \
         core/Rig.cpp \
         core/Rotator.cpp \
         core/SerialPort.cpp \
+        core/UdpForwarder.cpp \
+        core/UploadOutbox.cpp \
         core/Wsjtx.cpp \
         core/debug.cpp \
         core/main.cpp \
@@ -83,9 +95,14 @@ SOURCES += \
         data/AntProfile.cpp \
         data/CWKeyProfile.cpp \
         data/CWShortcutProfile.cpp \
+        data/CallsignSearchIndex.cpp \
         data/Data.cpp \
+        data/DxSpotStore.cpp \
         data/Dxcc.cpp \
+        data/DxccPrefixIndex.cpp \
+        data/DxccStatusIndex.cpp \
         data/MainLayoutProfile.cpp \
+        data/ReferenceSnapshot.cpp \
         data/RigProfile.cpp \
         data/RotProfile.cpp \
         data/RotUsrButtonsProfile.cpp \
@@ -93,12 +110,18 @@ SOURCES += \
         logformat/AdiFormat.cpp \
         logformat/AdxFormat.cpp \
         logformat/CSVFormat.cpp \
+        logformat/ContactBulkInserter.cpp \
+        logformat/ContactDupIndex.cpp \
+        logformat/ExportFieldIndex.cpp \
         logformat/JsonFormat.cpp \
         logformat/LogFormat.cpp \
+        logformat/LogFormatWorker.cpp \
+        logformat/QSLMerger.cpp \
         models/AlertTableModel.cpp \
         models/AwardsTableModel.cpp \
         models/DxccTableModel.cpp \
         models/LogbookModel.cpp \
+        models/ReferenceSnapshotModel.cpp \
         models/RigTypeModel.cpp \
         models/RotTypeModel.cpp \
         models/SqlListModel.cpp \
@@ -160,10 +183,13 @@ HEADERS += \
         core/CWKey.h \
         core/CWKeyer.h \
         core/CWWinKey.h \
+        core/CallbookCache.h \
         core/CallbookManager.h \
+        core/CallbookPrefetcher.h \
         core/Callsign.h \
         core/ClubLog.h \
         core/CredentialStore.h \
+        core/DxClusterIngest.h \
         core/Eqsl.h \
         core/Fldigi.h \
         core/GenericCallbook.h \
@@ -173,9 +199,12 @@ HEADERS += \
         core/HostsPortString.h \
         core/KSTChat.h \
         core/LOVDownloader.h \
+        core/LOVIngestWorker.h \
         core/LogLocale.h \
         core/LogParam.h \
+        core/LookupCache.h \
         core/Lotw.h \
+        core/LotwUploadJob.h \
         core/MembershipQE.h \
         core/Migration.h \
         core/NetworkNotification.h \
@@ -185,6 +214,8 @@ HEADERS += \
         core/Rig.h \
         core/Rotator.h \
         core/SerialPort.h \
+        core/UdpForwarder.h \
+        core/UploadOutbox.h \
         core/Wsjtx.h \
         core/debug.h \
         core/zonedetect.h \
@@ -192,12 +223,17 @@ HEADERS += \
         data/Band.h \
         data/CWKeyProfile.h \
         data/CWShortcutProfile.h \
+        data/CallsignSearchIndex.h \
         data/Data.h \
         data/DxSpot.h \
+        data/DxSpotStore.h \
         data/Dxcc.h \
+        data/DxccPrefixIndex.h \
+        data/DxccStatusIndex.h \
         data/MainLayoutProfile.h \
         data/POTAEntity.h \
         data/ProfileManager.h \
+        data/ReferenceSnapshot.h \
         data/RigProfile.h \
         data/RotProfile.h \
         data/RotUsrButtonsProfile.h \
@@ -212,12 +248,18 @@ HEADERS += \
         logformat/AdiFormat.h \
         logformat/AdxFormat.h \
         logformat/CSVFormat.h \
+        logformat/ContactBulkInserter.h \
+        logformat/ContactDupIndex.h \
+        logformat/ExportFieldIndex.h \
         logformat/JsonFormat.h \
         logformat/LogFormat.h \
+        logformat/LogFormatWorker.h \
+        logformat/QSLMerger.h \
         models/AlertTableModel.h \
         models/AwardsTableModel.h \
         models/DxccTableModel.h \
         models/LogbookModel.h \
+        models/ReferenceSnapshotModel.h \
         models/RigTypeModel.h \
         models/RotTypeModel.h \
         models/SqlListModel.h \
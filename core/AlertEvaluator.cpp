@@ -32,18 +32,26 @@ void AlertEvaluator::dxSpot(const DxSpot & spot)
 
     qCDebug(function_parameters) << "DX Spot";
 
-    QStringList matchedRules;
-
-    for ( const AlertRule *rule : qAsConst(ruleList) )
+    AlertSpotAttributes attributes;
+
+    attributes.source = SpotAlert::DXSPOT;
+    attributes.dxcc = spot.dxcc.dxcc;
+    attributes.spotterDxcc = spot.dxcc_spotter.dxcc;
+    attributes.status = spot.status;
+    attributes.modeID = valueID(Data::freqToDXCCMode(spot.freq));
+    attributes.bandID = valueID(spot.band);
+    attributes.dxContinentID = valueID(spot.dxcc.cont);
+    attributes.spotterContinentID = valueID(spot.dxcc_spotter.cont);
+    attributes.callsign = spot.callsign;
+    attributes.comment = spot.comment;
+
+    if ( dxSpotRules.memberRequired )
     {
-        qCDebug(runtime) << "Processing " << *rule;
-
-        if ( rule->match(spot) )
-        {
-            matchedRules << rule->ruleName;
-        }
+        attributes.members = spot.memberList2Set();
     }
 
+    QStringList matchedRules = matchingRules(dxSpotRules, attributes);
+
     if ( matchedRules.size() > 0 )
     {
         SpotAlert alert;
@@ -72,17 +80,27 @@ void AlertEvaluator::WSJTXCQSpot(const WsjtxEntry &wsjtx)
 
     qCDebug(function_parameters) << "WSJTX CQ Spot";
 
-    QStringList matchedRules;
-
-    for ( const AlertRule *rule : qAsConst(ruleList) )
+    const QString dxccMode = Data::freqToDXCCMode(wsjtx.freq);
+    AlertSpotAttributes attributes;
+
+    attributes.source = SpotAlert::WSJTXCQSPOT;
+    attributes.dxcc = wsjtx.dxcc.dxcc;
+    attributes.spotterDxcc = wsjtx.dxcc_spotter.dxcc;
+    attributes.status = wsjtx.status;
+    attributes.modeID = valueID(dxccMode);
+    attributes.bandID = valueID(wsjtx.band);
+    attributes.dxContinentID = valueID(wsjtx.dxcc.cont);
+    attributes.spotterContinentID = valueID(wsjtx.dxcc_spotter.cont);
+    attributes.callsign = wsjtx.callsign;
+    attributes.comment = wsjtx.decode.message;
+
+    if ( wsjtxRules.memberRequired )
     {
-        qCDebug(runtime) << "Processing " << *rule;
-        if ( rule->match(wsjtx) )
-        {
-            matchedRules << rule->ruleName;
-        }
+        attributes.members = wsjtx.memberList2Set();
     }
 
+    QStringList matchedRules = matchingRules(wsjtxRules, attributes);
+
     if ( matchedRules.size() > 0 )
     {
         SpotAlert alert;
@@ -94,7 +112,7 @@ void AlertEvaluator::WSJTXCQSpot(const WsjtxEntry &wsjtx)
         alert.callsign_member = wsjtx.callsign_member;
         alert.freq = wsjtx.freq;
         alert.band = wsjtx.band;
-        alert.mode = Data::freqToDXCCMode(wsjtx.freq);
+        alert.mode = dxccMode;
         alert.dxcc = wsjtx.dxcc;
         alert.comment = wsjtx.decode.message;
         alert.status = wsjtx.status;
@@ -141,6 +159,112 @@ void AlertEvaluator::loadRules()
             qInfo()<< "Cannot get filters names from DB" << ruleStmt.lastError();
         }
     }
+
+    compileRules();
+}
+
+void AlertEvaluator::compileRules()
+{
+    FCT_IDENTIFICATION;
+
+    valueIDs.clear();
+    dxSpotRules.clear();
+    wsjtxRules.clear();
+
+    for ( int i = 0; i < ruleList.size(); i++ )
+    {
+        AlertRule *rule = ruleList.at(i);
+
+        /* disabled rules are not indexed - they are never evaluated */
+        if ( !rule->isValid() || !rule->enabled )
+        {
+            continue;
+        }
+
+        rule->compile(valueIDs);
+
+        if ( rule->sourceMap & SpotAlert::DXSPOT )
+        {
+            dxSpotRules.add(i, rule);
+        }
+
+        if ( rule->sourceMap & SpotAlert::WSJTXCQSPOT )
+        {
+            wsjtxRules.add(i, rule);
+        }
+    }
+
+    qCDebug(runtime) << "Compiled" << ruleList.size() << "rules;"
+                     << "values:" << valueIDs.size();
+}
+
+int AlertEvaluator::valueID(const QString &value) const
+{
+    FCT_IDENTIFICATION;
+
+    return valueIDs.value(value, -1);
+}
+
+QStringList AlertEvaluator::matchingRules(const RuleIndex &index,
+                                          const AlertSpotAttributes &spot) const
+{
+    FCT_IDENTIFICATION;
+
+    QStringList ret;
+
+    const QVector<int> countryRules = index.byCountry.value(spot.dxcc);
+    auto countryIt = countryRules.constBegin();
+    auto anyIt = index.anyCountry.constBegin();
+
+    /* only candidates for the DX Country are evaluated. Both lists are sorted,
+     * they are merged to keep the order of the rules */
+    while ( countryIt != countryRules.constEnd()
+            || anyIt != index.anyCountry.constEnd() )
+    {
+        int ruleIndex;
+
+        if ( anyIt == index.anyCountry.constEnd()
+             || ( countryIt != countryRules.constEnd() && *countryIt < *anyIt ) )
+        {
+            ruleIndex = *countryIt++;
+        }
+        else
+        {
+            ruleIndex = *anyIt++;
+        }
+
+        const AlertRule *rule = ruleList.at(ruleIndex);
+
+        qCDebug(runtime) << "Processing " << *rule;
+
+        if ( rule->match(spot) )
+        {
+            ret << rule->ruleName;
+        }
+    }
+
+    return ret;
+}
+
+void AlertEvaluator::RuleIndex::add(int ruleIndex, const AlertRule *rule)
+{
+    if ( rule->dxCountry == 0 )
+    {
+        anyCountry.append(ruleIndex);
+    }
+    else
+    {
+        byCountry[rule->dxCountry].append(ruleIndex);
+    }
+
+    memberRequired |= rule->isMemberRequired();
+}
+
+void AlertEvaluator::RuleIndex::clear()
+{
+    byCountry.clear();
+    anyCountry.clear();
+    memberRequired = false;
 }
 
 AlertRule::AlertRule(QObject *parent) :
@@ -150,7 +274,12 @@ AlertRule::AlertRule(QObject *parent) :
     dxCountry(-1),
     dxLogStatusMap(0),
     spotterCountry(-1),
-    ruleValid(false)
+    ruleValid(false),
+    anyMode(false),
+    anyBand(false),
+    anyDxContinent(false),
+    anySpotterContinent(false),
+    anyMember(false)
 {
     FCT_IDENTIFICATION;
 }
@@ -265,84 +394,52 @@ bool AlertRule::load(const QString &in_ruleName)
     return true;
 }
 
-bool AlertRule::match(const WsjtxEntry &wsjtx) const
+void AlertRule::compile(QHash<QString, int> &valueIDs)
 {
     FCT_IDENTIFICATION;
 
-    bool ret = false;
-
-    qCDebug(function_parameters) << "Country: " << wsjtx.dxcc.dxcc
-                                 << "Status: " << wsjtx.status
-                                 << "Mode: " << Data::freqToDXCCMode(wsjtx.freq)
-                                 << "Band: " << wsjtx.band
-                                 << "spotter Country: " << wsjtx.dxcc_spotter.dxcc
-                                 << "Continent: " << wsjtx.dxcc.cont
-                                 << "Spotter Continent: " << wsjtx.dxcc_spotter.cont
-                                 << "Callsign: " << wsjtx.callsign
-                                 << "Message: " << wsjtx.decode.message
-                                 << "DX Member: " << wsjtx.memberList2StringList();
-
-    /* the first part validates a primitive types */
-    if ( isValid()
-         && enabled
-         && (sourceMap & SpotAlert::WSJTXCQSPOT)
-         && (dxCountry == 0 || dxCountry == wsjtx.dxcc.dxcc)
-         && (wsjtx.status & dxLogStatusMap)
-         && (mode == "*" || mode.contains("|" + Data::freqToDXCCMode(wsjtx.freq)))
-         && (band == "*" || band.contains("|" + wsjtx.band))
-         && (spotterCountry == 0 || spotterCountry == wsjtx.dxcc_spotter.dxcc )
-         && (dxContinent == "*" || dxContinent.contains("|" + wsjtx.dxcc.cont))
-         && (spotterContinent == "*" || spotterContinent.contains("|" + wsjtx.dxcc_spotter.cont))
-         && (dxMember == QStringList("*") || wsjtx.memberList2Set().intersects(dxMemberSet))
-       )
-    {
-        qCDebug(runtime) << "Rule match - phase 1 - OK";
-
-        qCDebug(runtime) << "Callsign RE" << callsignRE.pattern();
-        qCDebug(runtime) << "Comment RE" << commentRE.pattern();
-
-        /* primitive types are OK, lets go to validate RE */
-        QRegularExpressionMatch callsignMatch = callsignRE.match(wsjtx.callsign);
-        QRegularExpressionMatch commentMatch = commentRE.match(wsjtx.decode.message);
-
-        ret = callsignMatch.hasMatch()
-              && commentMatch.hasMatch();
-    }
-
-    qCDebug(runtime) << "Rule name: " << ruleName << " - result " << ret;
+    anyMode = ( mode == "*" );
+    anyBand = ( band == "*" );
+    anyDxContinent = ( dxContinent == "*" );
+    anySpotterContinent = ( spotterContinent == "*" );
+    anyMember = ( dxMember == QStringList("*") );
 
-    return ret;
+    modeMask = compileValueList(mode, valueIDs);
+    bandMask = compileValueList(band, valueIDs);
+    dxContinentMask = compileValueList(dxContinent, valueIDs);
+    spotterContinentMask = compileValueList(spotterContinent, valueIDs);
 }
 
-bool AlertRule::match(const DxSpot &spot) const
+bool AlertRule::match(const AlertSpotAttributes &spot) const
 {
     FCT_IDENTIFICATION;
 
     bool ret = false;
 
-    qCDebug(function_parameters) << "Country: " << spot.dxcc.dxcc
+    qCDebug(function_parameters) << "Source: " << spot.source
+                                 << "Country: " << spot.dxcc
                                  << "Status: " << spot.status
-                                 << "Mode: " << Data::freqToDXCCMode(spot.freq)
-                                 << "Band: " << spot.band
-                                 << "spotter Country: " << spot.dxcc_spotter.dxcc
-                                 << "Continent: " << spot.dxcc.cont
-                                 << "Spotter Continent: " << spot.dxcc_spotter.cont
+                                 << "Mode ID: " << spot.modeID
+                                 << "Band ID: " << spot.bandID
+                                 << "spotter Country: " << spot.spotterDxcc
+                                 << "Continent ID: " << spot.dxContinentID
+                                 << "Spotter Continent ID: " << spot.spotterContinentID
                                  << "Callsign: " << spot.callsign
                                  << "Message: " << spot.comment
-                                 << "DX Member: " << spot.memberList2StringList();
+                                 << "DX Member: " << spot.members;
 
     /* the first part validates a primitive types */
     if ( isValid()
          && enabled
-         && (sourceMap & SpotAlert::DXSPOT)
-         && (dxCountry == 0 || dxCountry == spot.dxcc.dxcc)
+         && (sourceMap & spot.source)
+         && (dxCountry == 0 || dxCountry == spot.dxcc)
          && (spot.status & dxLogStatusMap)
-         && (mode == "*" || mode.contains("|" + Data::freqToDXCCMode(spot.freq)))
-         && (band == "*" || band.contains("|" + spot.band))
-         && (spotterCountry == 0 || spotterCountry == spot.dxcc_spotter.dxcc )
-         && (dxContinent == "*" || dxContinent.contains("|" + spot.dxcc.cont))
-         && (spotterContinent == "*" || spotterContinent.contains("|" + spot.dxcc_spotter.cont))
-         && (dxMember == QStringList("*") || spot.memberList2Set().intersects(dxMemberSet))
+         && (anyMode || containsValue(modeMask, spot.modeID))
+         && (anyBand || containsValue(bandMask, spot.bandID))
+         && (spotterCountry == 0 || spotterCountry == spot.spotterDxcc )
+         && (anyDxContinent || containsValue(dxContinentMask, spot.dxContinentID))
+         && (anySpotterContinent || containsValue(spotterContinentMask, spot.spotterContinentID))
+         && (anyMember || spot.members.intersects(dxMemberSet))
        )
     {
         qCDebug(runtime) << "Rule match - phase 1 - OK";
@@ -370,6 +467,62 @@ bool AlertRule::isValid() const
     return ruleValid;
 }
 
+bool AlertRule::isMemberRequired() const
+{
+    FCT_IDENTIFICATION;
+
+    return !anyMember;
+}
+
+QBitArray AlertRule::compileValueList(const QString &valueList,
+                                      QHash<QString, int> &valueIDs)
+{
+    FCT_IDENTIFICATION;
+
+    QBitArray ret;
+
+    if ( valueList == "*" )
+    {
+        return ret;
+    }
+
+    /* NOTHING|20m|40m - the first item is only a placeholder */
+    const QStringList values = valueList.split('|');
+
+    for ( int i = 1; i < values.size(); i++ )
+    {
+        const QString &value = values.at(i);
+
+        if ( value.isEmpty() )
+        {
+            continue;
+        }
+
+        auto it = valueIDs.constFind(value);
+
+        if ( it == valueIDs.constEnd() )
+        {
+            it = valueIDs.insert(value, valueIDs.size());
+        }
+
+        if ( it.value() >= ret.size() )
+        {
+            ret.resize(it.value() + 1);
+        }
+
+        ret.setBit(it.value());
+    }
+
+    return ret;
+}
+
+bool AlertRule::containsValue(const QBitArray &valueMask, int valueID)
+{
+    return valueID >= 0
+           && valueID < valueMask.size()
+           && valueMask.testBit(valueID);
+}
+
 AlertRule::operator QString() const
 {
     return QString("AlerRule: ")
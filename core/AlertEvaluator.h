@@ -6,6 +6,24 @@
 #include "data/WsjtxEntry.h"
 #include "data/SpotAlert.h"
 #include <QRegularExpression>
+#include <QBitArray>
+
+/* Spot attributes used by the Alert Rules. They are evaluated only once per spot;
+ * string values are translated to the value IDs of the compiled rules */
+struct AlertSpotAttributes
+{
+    int source = 0;
+    int dxcc = 0;
+    int spotterDxcc = 0;
+    int status = 0;
+    int modeID = -1;
+    int bandID = -1;
+    int dxContinentID = -1;
+    int spotterContinentID = -1;
+    QString callsign;
+    QString comment;
+    QSet<QString> members;
+};
 
 class AlertRule : public QObject
 {
@@ -17,9 +35,10 @@ public:
 
     bool save();
     bool load(const QString &);
-    bool match(const WsjtxEntry &wsjtx) const;
-    bool match(const DxSpot & spot) const;
+    void compile(QHash<QString, int> &valueIDs);
+    bool match(const AlertSpotAttributes &spot) const;
     bool isValid() const;
+    bool isMemberRequired() const;
     operator QString() const;
 public:
     QString ruleName;
@@ -36,10 +55,25 @@ public:
     int spotterCountry;
     QString spotterContinent;
 private:
+    static QBitArray compileValueList(const QString &valueList,
+                                      QHash<QString, int> &valueIDs);
+    static bool containsValue(const QBitArray &valueMask, int valueID);
+
     bool ruleValid;
     QRegularExpression callsignRE;
     QRegularExpression commentRE;
     QSet<QString> dxMemberSet;
+
+    /* compiled filters - a bit is set for every accepted value ID */
+    QBitArray modeMask;
+    QBitArray bandMask;
+    QBitArray dxContinentMask;
+    QBitArray spotterContinentMask;
+    bool anyMode;
+    bool anyBand;
+    bool anyDxContinent;
+    bool anySpotterContinent;
+    bool anyMember;
 };
 
 class AlertEvaluator : public QObject
@@ -60,7 +94,26 @@ signals:
     void spotAlert(SpotAlert alert);
 
 private:
+    /* Enabled rules of one source indexed by DX Country */
+    struct RuleIndex
+    {
+        QHash<int, QVector<int>> byCountry;
+        QVector<int> anyCountry;
+        bool memberRequired = false;
+
+        void add(int ruleIndex, const AlertRule *rule);
+        void clear();
+    };
+
+    void compileRules();
+    int valueID(const QString &value) const;
+    QStringList matchingRules(const RuleIndex &index,
+                              const AlertSpotAttributes &spot) const;
+
     QList<AlertRule *>ruleList;
+    QHash<QString, int> valueIDs;
+    RuleIndex dxSpotRules;
+    RuleIndex wsjtxRules;
 };
 
 #endif // ALERTEVALUATOR_H
@@ -0,0 +1,223 @@
+#include <QSettings>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include "CallbookCache.h"
+#include "core/debug.h"
+
+// Number of stored records after which the cache is pruned
+#define CALLBOOK_CACHE_PRUNE_INTERVAL 100
+
+MODULE_IDENTIFICATION("qlog.core.callbookcache");
+
+bool CallbookCache::lookup(const QString &callsign,
+                           QMap<QString, QString> &data)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign;
+
+    QSqlQuery query;
+
+    if ( ! query.prepare("SELECT data FROM callbook_cache "
+                         "WHERE callsign = :callsign AND fetched_at >= :expiration") )
+    {
+        qWarning() << "Cannot prepare Select statement" << query.lastError();
+        return false;
+    }
+
+    query.bindValue(":callsign", callsign);
+    query.bindValue(":expiration", expirationTime());
+
+    if ( ! query.exec() )
+    {
+        qWarning() << "Cannot get Callbook Cache record" << query.lastError();
+        return false;
+    }
+
+    if ( ! query.next() )
+    {
+        misses++;
+        qCDebug(runtime) << "Cache miss" << callsign << "hits" << hits << "misses" << misses;
+        return false;
+    }
+
+    const QVariantMap record = QJsonDocument::fromJson(query.value(0).toByteArray()).object().toVariantMap();
+
+    data.clear();
+
+    for ( auto it = record.cbegin(); it != record.cend(); ++it )
+    {
+        data.insert(it.key(), it.value().toString());
+    }
+
+    /* last_used drives the size limit - the least used records are removed first */
+    QSqlQuery update;
+
+    if ( ! update.prepare("UPDATE callbook_cache SET last_used = :now WHERE callsign = :callsign") )
+    {
+        qWarning() << "Cannot prepare Update statement" << update.lastError();
+    }
+    else
+    {
+        update.bindValue(":now", QDateTime::currentSecsSinceEpoch());
+        update.bindValue(":callsign", callsign);
+
+        if ( ! update.exec() )
+        {
+            qWarning() << "Cannot update Callbook Cache record" << update.lastError();
+        }
+    }
+
+    hits++;
+    qCDebug(runtime) << "Cache hit" << callsign << "hits" << hits << "misses" << misses;
+
+    return true;
+}
+
+bool CallbookCache::contains(const QString &callsign)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign;
+
+    QSqlQuery query;
+
+    if ( ! query.prepare("SELECT 1 FROM callbook_cache "
+                         "WHERE callsign = :callsign AND fetched_at >= :expiration") )
+    {
+        qWarning() << "Cannot prepare Select statement" << query.lastError();
+        return false;
+    }
+
+    query.bindValue(":callsign", callsign);
+    query.bindValue(":expiration", expirationTime());
+
+    if ( ! query.exec() )
+    {
+        qWarning() << "Cannot get Callbook Cache record" << query.lastError();
+        return false;
+    }
+
+    return query.next();
+}
+
+void CallbookCache::store(const QString &callsign,
+                          const QMap<QString, QString> &data)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign;
+
+    if ( callsign.isEmpty() || data.isEmpty() )
+    {
+        return;
+    }
+
+    QJsonObject record;
+
+    for ( auto it = data.cbegin(); it != data.cend(); ++it )
+    {
+        record.insert(it.key(), it.value());
+    }
+
+    QSqlQuery query;
+
+    if ( ! query.prepare("INSERT OR REPLACE INTO callbook_cache(callsign, data, fetched_at, last_used) "
+                         "VALUES (:callsign, :data, :fetched, :used)") )
+    {
+        qWarning() << "Cannot prepare Insert statement" << query.lastError();
+        return;
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    query.bindValue(":callsign", callsign);
+    query.bindValue(":data", QString::fromUtf8(QJsonDocument(record).toJson(QJsonDocument::Compact)));
+    query.bindValue(":fetched", now);
+    query.bindValue(":used", now);
+
+    if ( ! query.exec() )
+    {
+        qWarning() << "Cannot store Callbook Cache record" << query.lastError();
+        return;
+    }
+
+    if ( ++storesSincePrune >= CALLBOOK_CACHE_PRUNE_INTERVAL )
+    {
+        prune();
+    }
+}
+
+void CallbookCache::prune()
+{
+    FCT_IDENTIFICATION;
+
+    storesSincePrune = 0;
+
+    QSqlQuery query;
+
+    if ( ! query.prepare("DELETE FROM callbook_cache WHERE fetched_at < :expiration") )
+    {
+        qWarning() << "Cannot prepare Delete statement" << query.lastError();
+        return;
+    }
+
+    query.bindValue(":expiration", expirationTime());
+
+    if ( ! query.exec() )
+    {
+        qWarning() << "Cannot remove expired Callbook Cache records" << query.lastError();
+        return;
+    }
+
+    const int expired = query.numRowsAffected();
+
+    if ( ! query.prepare("DELETE FROM callbook_cache WHERE callsign NOT IN "
+                         " (SELECT callsign FROM callbook_cache ORDER BY last_used DESC LIMIT :maxEntries)") )
+    {
+        qWarning() << "Cannot prepare Delete statement" << query.lastError();
+        return;
+    }
+
+    query.bindValue(":maxEntries", getMaxEntries());
+
+    if ( ! query.exec() )
+    {
+        qWarning() << "Cannot limit Callbook Cache size" << query.lastError();
+        return;
+    }
+
+    qCDebug(runtime) << "Pruned - expired" << expired << "over limit" << query.numRowsAffected();
+}
+
+int CallbookCache::getTTLDays()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    return settings.value(CallbookCache::CONFIG_TTL_KEY, 30).toInt();
+}
+
+int CallbookCache::getMaxEntries()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    return settings.value(CallbookCache::CONFIG_MAX_ENTRIES_KEY, 20000).toInt();
+}
+
+qint64 CallbookCache::expirationTime()
+{
+    return QDateTime::currentSecsSinceEpoch() - static_cast<qint64>(getTTLDays()) * 86400;
+}
+
+const QString CallbookCache::CONFIG_TTL_KEY = "callbook/cache_ttl_days";
+const QString CallbookCache::CONFIG_MAX_ENTRIES_KEY = "callbook/cache_max_entries";
+quint64 CallbookCache::hits = 0;
+quint64 CallbookCache::misses = 0;
+int CallbookCache::storesSincePrune = 0;
@@ -0,0 +1,34 @@
+#ifndef CALLBOOKCACHE_H
+#define CALLBOOKCACHE_H
+
+#include <QMap>
+#include <QString>
+
+/* Persistent cache of the callbook results stored in the QLog DB.
+ * Records older than TTL are not returned and the number of records
+ * is limited - the least recently used records are removed first */
+class CallbookCache
+{
+public:
+    static bool lookup(const QString &callsign,
+                       QMap<QString, QString> &data);
+    static bool contains(const QString &callsign);
+    static void store(const QString &callsign,
+                      const QMap<QString, QString> &data);
+    static void prune();
+
+    static int getTTLDays();
+    static int getMaxEntries();
+
+    const static QString CONFIG_TTL_KEY;
+    const static QString CONFIG_MAX_ENTRIES_KEY;
+
+private:
+    static qint64 expirationTime();
+
+    static quint64 hits;
+    static quint64 misses;
+    static int storesSincePrune;
+};
+
+#endif // CALLBOOKCACHE_H
@@ -5,6 +5,7 @@
 #include "core/HamQTH.h"
 #include "core/QRZ.h"
 #include "core/Callsign.h"
+#include "core/CallbookCache.h"
 
 MODULE_IDENTIFICATION("qlog.ui.callbookmanager");
 
@@ -28,6 +29,15 @@ void CallbookManager::queryCallsign(const QString &callsign)
         return;
     }
 
+    QMap<QString, QString> cachedData;
+
+    if ( cachedResult(callsign, cachedData) )
+    {
+        queryCache.insert(callsign, new QMap<QString, QString>(cachedData));
+        emit callsignResult(cachedData);
+        return;
+    }
+
     // create an empty object in cache
     // if there is the second query for the same call immediatelly after
     // the first query, then it returns a result of empty object
@@ -53,27 +63,79 @@ bool CallbookManager::isActive()
     return ret;
 }
 
-GenericCallbook *CallbookManager::createCallbook(const QString &callbookID)
+GenericCallbook *CallbookManager::createCallbook(const QString &callbookID,
+                                                 QObject *parent)
 {
     FCT_IDENTIFICATION;
 
+    qCDebug(function_parameters) << callbookID;
+
     GenericCallbook *ret = nullptr;
 
     if (callbookID == HamQTH::CALLBOOK_NAME )
     {
-        ret = new HamQTH(this);
+        ret = new HamQTH(parent);
     }
     else if ( callbookID == QRZ::CALLBOOK_NAME )
     {
-        ret = new QRZ(this);
+        ret = new QRZ(parent);
     }
 
-    if ( ret )
+    return ret;
+}
+
+QMap<QString, QString> CallbookManager::partialResult(const QString &queryCallsign,
+                                                      const QMap<QString, QString> &data)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << queryCallsign;
+
+    // If not exists full match record for example for SP/OK1xxx in a callbook
+    // then callbooks return a partial result (usually base callsign) OK1xxx. In this case, QLog
+    // takes only selected fields from the callbook response.
+
+    QMap<QString, QString> newdata;
+
+    newdata["call"] = queryCallsign;
+    newdata["fname"] = data["fname"];
+    newdata["lname"] = data["lname"];
+    newdata["lic_year"] = data["lic_year"];
+    newdata["qsl_via"] = data["qsl_via"];
+    newdata["email"] = data["email"];
+    newdata["born"] = data["born"];
+    newdata["name"] = data["name"];
+    newdata["url"] = data["url"];
+
+    return newdata;
+}
+
+bool CallbookManager::cachedResult(const QString &callsign,
+                                   QMap<QString, QString> &data)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign;
+
+    if ( CallbookCache::lookup(callsign, data) )
     {
-        connect(ret, &GenericCallbook::callsignResult, this, &CallbookManager::processCallsignResult);
+        return true;
     }
 
-    return ret;
+    /* the prefetcher stores results under the callsign returned by the callbook
+     * therefore only the base callsign can be present for SP/OK1xxx */
+    Callsign queryCall(callsign);
+
+    if ( queryCall.isValid()
+         && queryCall.getBase() != callsign
+         && CallbookCache::lookup(queryCall.getBase(), data) )
+    {
+        qCDebug(runtime) << "Partial match in cache";
+        data = partialResult(callsign, data);
+        return true;
+    }
+
+    return false;
 }
 
 void CallbookManager::initCallbooks()
@@ -86,11 +148,12 @@ void CallbookManager::initCallbooks()
     QString primaryCallbookSelection = settings.value(GenericCallbook::CONFIG_PRIMARY_CALLBOOK_KEY).toString();
     QString secondaryCallbookSelection = settings.value(GenericCallbook::CONFIG_SECONDARY_CALLBOOK_KEY).toString();
 
-    primaryCallbook = createCallbook(primaryCallbookSelection);
-    secondaryCallbook = createCallbook(secondaryCallbookSelection);
+    primaryCallbook = createCallbook(primaryCallbookSelection, this);
+    secondaryCallbook = createCallbook(secondaryCallbookSelection, this);
 
     if ( !primaryCallbook.isNull() )
     {
+        connect(primaryCallbook, &GenericCallbook::callsignResult, this, &CallbookManager::processCallsignResult);
         connect(primaryCallbook, &GenericCallbook::callsignNotFound, this, &CallbookManager::primaryCallbookCallsignNotFound);
         connect(primaryCallbook, &GenericCallbook::loginFailed, this, [this]()
         {
@@ -107,6 +170,7 @@ void CallbookManager::initCallbooks()
 
     if ( !secondaryCallbook.isNull() )
     {
+        connect(secondaryCallbook, &GenericCallbook::callsignResult, this, &CallbookManager::processCallsignResult);
         connect(secondaryCallbook, &GenericCallbook::callsignNotFound, this, &CallbookManager::secondaryCallbookCallsignNotFound);
         connect(secondaryCallbook, &GenericCallbook::loginFailed, this, [this]()
         {
@@ -165,6 +229,7 @@ void CallbookManager::processCallsignResult(const QMap<QString, QString> &data)
     FCT_IDENTIFICATION;
 
     queryCache.insert(data["call"], new QMap<QString, QString>(data));
+    CallbookCache::store(data["call"], data);
 
     // Callbook returned queried callsign
     if ( data["call"] == currentQueryCallsign )
@@ -181,25 +246,11 @@ void CallbookManager::processCallsignResult(const QMap<QString, QString> &data)
         return;
     }
 
-    // If not exists full match record for example for SP/OK1xxx in a callbook
-    // then callbooks return a partial result (usually base callsign) OK1xxx. In this case, QLog
-    // takes only selected fields from the callbook response.
-
     if ( queryCall.getBase() == data["call"] )
     {
         qCDebug(runtime) << "Partial match for result - forwarding limited set of information";
 
-        QMap<QString, QString> newdata;
-
-        newdata["call"] = currentQueryCallsign;
-        newdata["fname"] = data["fname"];
-        newdata["lname"] = data["lname"];
-        newdata["lic_year"] = data["lic_year"];
-        newdata["qsl_via"] = data["qsl_via"];
-        newdata["email"] = data["email"];
-        newdata["born"] = data["born"];
-        newdata["name"] = data["name"];
-        newdata["url"] = data["url"];
+        const QMap<QString, QString> newdata = partialResult(currentQueryCallsign, data);
 
         queryCache.insert(currentQueryCallsign, new QMap<QString, QString>(newdata));
         emit callsignResult(newdata);
@@ -14,6 +14,11 @@ public:
     void queryCallsign(const QString &callsign);
     bool isActive();
 
+    static GenericCallbook *createCallbook(const QString &callbookID,
+                                           QObject *parent = nullptr);
+    static QMap<QString, QString> partialResult(const QString &queryCallsign,
+                                                const QMap<QString, QString> &data);
+
 signals:
     void loginFailed(QString);
     void callsignResult(const QMap<QString, QString>& data);
@@ -30,7 +35,8 @@ private slots:
     void processCallsignResult(const QMap<QString, QString>& data);
 
 private:
-    GenericCallbook *createCallbook(const QString&);
+    bool cachedResult(const QString &callsign,
+                      QMap<QString, QString> &data);
 
 private:
     QPointer<GenericCallbook> primaryCallbook;
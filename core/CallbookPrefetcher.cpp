@@ -0,0 +1,280 @@
+#include <QSettings>
+#include "CallbookPrefetcher.h"
+#include "core/CallbookManager.h"
+#include "core/CallbookCache.h"
+#include "core/HamQTH.h"
+#include "core/QRZ.h"
+#include "core/Callsign.h"
+#include "core/debug.h"
+
+// Minimal delay between two background queries (ms)
+#define PREFETCH_INTERVAL_QRZ 1000
+#define PREFETCH_INTERVAL_HAMQTH 2000
+#define PREFETCH_INTERVAL_DEFAULT 5000
+
+// Pause after a lookup error (ms)
+#define PREFETCH_ERROR_PAUSE 60000
+
+// Maximal time to wait for a callbook reply (ms)
+#define PREFETCH_QUERY_TIMEOUT 30000
+
+// Maximal number of waiting callsigns; the oldest ones are dropped
+#define PREFETCH_QUEUE_SIZE 100
+
+// Maximal number of remembered already tried callsigns
+#define PREFETCH_TRIED_SIZE 5000
+
+MODULE_IDENTIFICATION("qlog.core.callbookprefetcher");
+
+CallbookPrefetcher::CallbookPrefetcher(QObject *parent) :
+    QObject(parent),
+    queryTimer(new QTimer(this)),
+    timeoutTimer(new QTimer(this)),
+    enabled(false),
+    queried(0),
+    found(0),
+    dropped(0)
+{
+    FCT_IDENTIFICATION;
+
+    queryTimer->setSingleShot(true);
+    connect(queryTimer, &QTimer::timeout, this, &CallbookPrefetcher::queryNext);
+
+    timeoutTimer->setSingleShot(true);
+    connect(timeoutTimer, &QTimer::timeout, this, &CallbookPrefetcher::queryTimeout);
+
+    CallbookCache::prune();
+
+    initCallbooks();
+}
+
+void CallbookPrefetcher::initCallbooks()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    timeoutTimer->stop();
+    currentCallsign.clear();
+
+    if ( !callbook.isNull() )
+    {
+        callbook->abortQuery();
+        callbook->deleteLater();
+        callbook.clear();
+    }
+
+    callbookID = settings.value(GenericCallbook::CONFIG_PRIMARY_CALLBOOK_KEY).toString();
+    enabled = settings.value(CallbookPrefetcher::CONFIG_PREFETCH_ENABLED_KEY, false).toBool();
+
+    qCDebug(runtime) << "Callbook" << callbookID << "enabled" << enabled;
+
+    if ( !enabled )
+    {
+        queue.clear();
+        queuedCallsigns.clear();
+        return;
+    }
+
+    callbook = CallbookManager::createCallbook(callbookID, this);
+
+    if ( callbook.isNull() )
+    {
+        return;
+    }
+
+    connect(callbook, &GenericCallbook::callsignResult, this, &CallbookPrefetcher::processCallsignResult);
+    connect(callbook, &GenericCallbook::callsignNotFound, this, &CallbookPrefetcher::queryFinished);
+    connect(callbook, &GenericCallbook::loginFailed, this, [this]()
+    {
+        /* the user is informed by the foreground lookup */
+        qCDebug(runtime) << "Login failed - prefetching is stopped";
+        enabled = false;
+    });
+    connect(callbook, &GenericCallbook::lookupError, this, [this]()
+    {
+        queryFinished();
+        scheduleNext(PREFETCH_ERROR_PAUSE);
+    });
+
+    scheduleNext();
+}
+
+void CallbookPrefetcher::prefetchCallsign(const QString &callsign)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign;
+
+    if ( !enabled || callbook.isNull() )
+    {
+        return;
+    }
+
+    const QString call = callsign.toUpper();
+
+    if ( call.isEmpty()
+         || call == currentCallsign
+         || queuedCallsigns.contains(call)
+         || triedCallsigns.contains(call) )
+    {
+        return;
+    }
+
+    if ( ! Callsign(call).isValid() )
+    {
+        return;
+    }
+
+    if ( triedCallsigns.size() >= PREFETCH_TRIED_SIZE )
+    {
+        triedCallsigns.clear();
+    }
+
+    if ( CallbookCache::contains(call) )
+    {
+        triedCallsigns.insert(call);
+        return;
+    }
+
+    if ( queue.size() >= PREFETCH_QUEUE_SIZE )
+    {
+        queuedCallsigns.remove(queue.takeFirst());
+        dropped++;
+    }
+
+    queue.append(call);
+    queuedCallsigns.insert(call);
+
+    if ( currentCallsign.isEmpty() && !queryTimer->isActive() )
+    {
+        scheduleNext();
+    }
+}
+
+void CallbookPrefetcher::prefetchSpot(const DxSpot &spot)
+{
+    FCT_IDENTIFICATION;
+
+    prefetchCallsign(spot.callsign);
+}
+
+void CallbookPrefetcher::prefetchWsjtxEntry(const WsjtxEntry &entry)
+{
+    FCT_IDENTIFICATION;
+
+    prefetchCallsign(entry.callsign);
+}
+
+void CallbookPrefetcher::queryNext()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !enabled || callbook.isNull() || !currentCallsign.isEmpty() )
+    {
+        return;
+    }
+
+    while ( !queue.isEmpty() )
+    {
+        /* the newest callsign is the most probable next QSO */
+        const QString call = queue.takeLast();
+        queuedCallsigns.remove(call);
+
+        /* the callsign could have been looked up by the operator meanwhile */
+        if ( CallbookCache::contains(call) )
+        {
+            continue;
+        }
+
+        currentCallsign = call;
+        triedCallsigns.insert(call);
+        queried++;
+
+        lastQuery.start();
+        timeoutTimer->start(PREFETCH_QUERY_TIMEOUT);
+
+        qCDebug(runtime) << "Prefetching" << call << "waiting" << queue.size();
+
+        callbook->queryCallsign(call);
+        return;
+    }
+}
+
+void CallbookPrefetcher::processCallsignResult(const QMap<QString, QString> &data)
+{
+    FCT_IDENTIFICATION;
+
+    CallbookCache::store(data.value("call"), data);
+    found++;
+
+    queryFinished();
+}
+
+void CallbookPrefetcher::queryFinished()
+{
+    FCT_IDENTIFICATION;
+
+    if ( currentCallsign.isEmpty() )
+    {
+        return;
+    }
+
+    timeoutTimer->stop();
+
+    qCDebug(runtime) << "Finished" << currentCallsign
+                     << "Queried:" << queried
+                     << "Found:" << found
+                     << "Dropped:" << dropped
+                     << "Waiting:" << queue.size();
+
+    currentCallsign.clear();
+    scheduleNext();
+}
+
+void CallbookPrefetcher::queryTimeout()
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(runtime) << "Query timeout" << currentCallsign;
+
+    if ( !callbook.isNull() )
+    {
+        callbook->abortQuery();
+    }
+
+    queryFinished();
+}
+
+void CallbookPrefetcher::scheduleNext(int minDelay)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << minDelay;
+
+    qint64 delay = minDelay;
+
+    if ( lastQuery.isValid() )
+    {
+        delay = qMax(delay, providerInterval(callbookID) - lastQuery.elapsed());
+    }
+
+    queryTimer->start(static_cast<int>(qMax(delay, qint64(0))));
+}
+
+int CallbookPrefetcher::providerInterval(const QString &callbookID)
+{
+    if ( callbookID == QRZ::CALLBOOK_NAME )
+    {
+        return PREFETCH_INTERVAL_QRZ;
+    }
+
+    if ( callbookID == HamQTH::CALLBOOK_NAME )
+    {
+        return PREFETCH_INTERVAL_HAMQTH;
+    }
+
+    return PREFETCH_INTERVAL_DEFAULT;
+}
+
+const QString CallbookPrefetcher::CONFIG_PREFETCH_ENABLED_KEY = "callbook/prefetch";
@@ -0,0 +1,59 @@
+#ifndef CALLBOOKPREFETCHER_H
+#define CALLBOOKPREFETCHER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSet>
+#include "core/GenericCallbook.h"
+#include "data/DxSpot.h"
+#include "data/WsjtxEntry.h"
+
+/* Warms the Callbook Cache for the callsigns which appear in the DX Cluster,
+ * Bandmap and WSJTX CQ list. The primary callbook is queried in background
+ * with its own session. Queries are serialized and the delay between them
+ * is limited per callbook provider. The newest callsigns are queried first.
+ * Every query counts to the user's callbook quota therefore prefetching
+ * is enabled only on request in Settings */
+class CallbookPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CallbookPrefetcher(QObject *parent = nullptr);
+
+    const static QString CONFIG_PREFETCH_ENABLED_KEY;
+
+public slots:
+    void initCallbooks();
+    void prefetchCallsign(const QString &callsign);
+    void prefetchSpot(const DxSpot &spot);
+    void prefetchWsjtxEntry(const WsjtxEntry &entry);
+
+private slots:
+    void queryNext();
+    void processCallsignResult(const QMap<QString, QString> &data);
+    void queryFinished();
+    void queryTimeout();
+
+private:
+    void scheduleNext(int minDelay = 0);
+    static int providerInterval(const QString &callbookID);
+
+    QPointer<GenericCallbook> callbook;
+    QString callbookID;
+    QStringList queue;
+    QSet<QString> queuedCallsigns;
+    QSet<QString> triedCallsigns;
+    QString currentCallsign;
+    QTimer *queryTimer;
+    QTimer *timeoutTimer;
+    QElapsedTimer lastQuery;
+    bool enabled;
+    quint64 queried;
+    quint64 found;
+    quint64 dropped;
+};
+
+#endif // CALLBOOKPREFETCHER_H
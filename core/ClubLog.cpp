@@ -9,6 +9,7 @@
 #include "ClubLog.h"
 #include "debug.h"
 #include "core/CredentialStore.h"
+#include "core/UploadOutbox.h"
 
 #define API_KEY "21507885dece41ca049fec7fe02a813f2105aff2"
 #define API_LIVE_UPLOAD_URL "https://clublog.org/realtime.php"
@@ -149,7 +150,7 @@ void ClubLog::uploadAdif(QByteArray& data)
     QString callsign = getRegisteredCallsign();
     QString password = getPassword();
 
-    QUrl url(API_LOG_UPLOAD_URL);
+    QUrl url(UploadOutbox::uploadURL("clublog", API_LOG_UPLOAD_URL));
 
     QHttpMultiPart* multipart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
 
@@ -0,0 +1,198 @@
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QRegularExpression>
+
+#include "DxClusterIngest.h"
+#include "data/Data.h"
+#include "core/MembershipQE.h"
+#include "core/debug.h"
+
+#define SPOT_BATCH_INTERVAL 200
+
+MODULE_IDENTIFICATION("qlog.core.dxclusteringest");
+
+QDebug operator<<(QDebug debug, const DxClusterIngestStats &stats)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << "Spots: " << stats.spots
+                    << "; Parse: " << stats.parseTime << "us"
+                    << "; DXCC: " << stats.dxccTime << "us"
+                    << "; Band/Status: " << stats.statusTime << "us"
+                    << "; Member: " << stats.memberTime << "us"
+                    << "; Queue: " << stats.queueTime << "us";
+    return debug;
+}
+
+DxClusterIngest::DxClusterIngest(QObject *parent) :
+    QObject(parent),
+    dbConnectionName("dxClusterIngest"),
+    dbConnected(false),
+    clubQuery(nullptr),
+    batchTimer(new QTimer(this)),
+    canceled(0)
+{
+    FCT_IDENTIFICATION;
+
+    batchTimer->setInterval(SPOT_BATCH_INTERVAL);
+    batchTimer->setSingleShot(true);
+    connect(batchTimer, &QTimer::timeout, this, &DxClusterIngest::flushBatch);
+}
+
+DxClusterIngest::~DxClusterIngest()
+{
+    FCT_IDENTIFICATION;
+
+    delete clubQuery;
+
+    if ( QSqlDatabase::contains(dbConnectionName) )
+    {
+        {
+            qCDebug(runtime) << "Closing connection to DB";
+            QSqlDatabase db = QSqlDatabase::database(dbConnectionName);
+            db.close();
+        }
+
+        QSqlDatabase::removeDatabase(dbConnectionName);
+    }
+}
+
+void DxClusterIngest::cancel()
+{
+    FCT_IDENTIFICATION;
+
+    canceled.storeRelease(1);
+}
+
+void DxClusterIngest::processLines(const QStringList &lines)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << lines.size();
+
+    static QRegularExpression dxSpotRE("^DX de ([a-zA-Z0-9\\/]+).*:\\s+([0-9|.]+)\\s+([a-zA-Z0-9\\/]+)[^\\s]*\\s+(.*)\\s+(\\d{4}Z)",
+                                       QRegularExpression::CaseInsensitiveOption);
+
+    QElapsedTimer stageTimer;
+
+    for ( const QString &line : lines )
+    {
+        if ( canceled.loadAcquire() )
+        {
+            return;
+        }
+
+        stageTimer.start();
+
+        QRegularExpressionMatch dxSpotMatch = dxSpotRE.match(line);
+
+        if ( !dxSpotMatch.hasMatch() )
+        {
+            continue;
+        }
+
+        DxSpot spot;
+
+        spot.time = QDateTime::currentDateTime().toTimeSpec(Qt::UTC);
+        spot.spotter = dxSpotMatch.captured(1);
+        spot.freq = dxSpotMatch.captured(2).toDouble() / 1000;
+        spot.callsign = dxSpotMatch.captured(3);
+        spot.comment = dxSpotMatch.captured(4);
+        spot.mode = Data::freqToDXCCMode(spot.freq);
+        pendingStats.parseTime += stageTimer.nsecsElapsed() / 1000;
+
+        stageTimer.start();
+        spot.dxcc = Data::instance()->lookupDxcc(spot.callsign);
+        spot.dxcc_spotter = Data::instance()->lookupDxcc(spot.spotter);
+        pendingStats.dxccTime += stageTimer.nsecsElapsed() / 1000;
+
+        stageTimer.start();
+        spot.band = Data::band(spot.freq).name;
+        spot.status = Data::dxccStatus(spot.dxcc.dxcc, spot.band, spot.mode);
+        pendingStats.statusTime += stageTimer.nsecsElapsed() / 1000;
+
+        stageTimer.start();
+        spot.callsign_member = queryMembership(spot.callsign);
+        pendingStats.memberTime += stageTimer.nsecsElapsed() / 1000;
+
+        if ( pendingSpots.isEmpty() )
+        {
+            batchAge.start();
+        }
+
+        pendingSpots.append(spot);
+        pendingStats.spots++;
+    }
+
+    if ( !pendingSpots.isEmpty() && !batchTimer->isActive() )
+    {
+        batchTimer->start();
+    }
+}
+
+void DxClusterIngest::flushBatch()
+{
+    FCT_IDENTIFICATION;
+
+    if ( pendingSpots.isEmpty() || canceled.loadAcquire() )
+    {
+        return;
+    }
+
+    pendingStats.queueTime = batchAge.nsecsElapsed() / 1000;
+
+    emit spotsReady(pendingSpots, pendingStats);
+
+    pendingSpots.clear();
+    pendingStats = DxClusterIngestStats();
+}
+
+bool DxClusterIngest::openDatabase()
+{
+    FCT_IDENTIFICATION;
+
+    if ( dbConnected )
+    {
+        return true;
+    }
+
+    // the connection was already tried and failed
+    if ( QSqlDatabase::contains(dbConnectionName) )
+    {
+        return false;
+    }
+
+    qCDebug(runtime) << "Opening connection to DB";
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", dbConnectionName);
+    db.setDatabaseName(Data::dbFilename());
+    dbConnected = db.open();
+
+    if ( !dbConnected )
+    {
+        qWarning() << "Cannot open DB Connection for DX Cluster" << db.lastError();
+        return false;
+    }
+
+    clubQuery = new QSqlQuery(db);
+
+    if ( ! MembershipQE::prepareClubQuery(*clubQuery) )
+    {
+        qWarning() << "Cannot prepare Membership query" << clubQuery->lastError();
+        delete clubQuery;
+        clubQuery = nullptr;
+    }
+
+    return true;
+}
+
+QList<ClubInfo> DxClusterIngest::queryMembership(const QString &callsign)
+{
+    FCT_IDENTIFICATION;
+
+    if ( !openDatabase() || !clubQuery )
+    {
+        return QList<ClubInfo>();
+    }
+
+    return MembershipQE::query(*clubQuery, callsign);
+}
@@ -0,0 +1,63 @@
+#ifndef DXCLUSTERINGEST_H
+#define DXCLUSTERINGEST_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QAtomicInt>
+#include "data/DxSpot.h"
+
+/* Accumulated per-stage processing time of one spot batch (in microseconds) */
+struct DxClusterIngestStats
+{
+    int spots = 0;
+    qint64 parseTime = 0;
+    qint64 dxccTime = 0;
+    qint64 statusTime = 0;
+    qint64 memberTime = 0;
+    qint64 queueTime = 0;
+};
+
+Q_DECLARE_METATYPE(DxClusterIngestStats)
+
+QDebug operator<<(QDebug debug, const DxClusterIngestStats &stats);
+
+/* Parses and enriches DX Cluster spot lines. The object lives in a worker thread
+ * and uses its own DB connection. Enriched spots are delivered in batches,
+ * at most once per SPOT_BATCH_INTERVAL */
+class DxClusterIngest : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DxClusterIngest(QObject *parent = nullptr);
+    ~DxClusterIngest();
+
+    /* can be called from any thread */
+    void cancel();
+
+public slots:
+    void processLines(const QStringList &lines);
+
+signals:
+    void spotsReady(QList<DxSpot> spots, DxClusterIngestStats stats);
+
+private slots:
+    void flushBatch();
+
+private:
+    bool openDatabase();
+    QList<ClubInfo> queryMembership(const QString &callsign);
+
+    const QString dbConnectionName;
+    bool dbConnected;
+    QSqlQuery *clubQuery;
+    QTimer *batchTimer;
+    QElapsedTimer batchAge;
+    QList<DxSpot> pendingSpots;
+    DxClusterIngestStats pendingStats;
+    QAtomicInt canceled;
+};
+
+#endif // DXCLUSTERINGEST_H
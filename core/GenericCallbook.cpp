@@ -28,6 +28,15 @@ const QString GenericCallbook::getWebLookupURL(const QString &callsign,
     return url;
 }
 
+const QString GenericCallbook::getAPIURL(const QString &callbookID,
+                                         const QString &defaultURL)
+{
+    QSettings setting;
+
+    /* the URL can be redirected to a local stand-in of the callbook XML API */
+    return setting.value("callbook/" + callbookID + "/apiurl", defaultURL).toString();
+}
+
 const QString GenericCallbook::SECURE_STORAGE_KEY = "Callbook";
 const QString GenericCallbook::CONFIG_USERNAME_KEY = "genericcallbook/username";
 const QString GenericCallbook::CONFIG_PRIMARY_CALLBOOK_KEY = "callbook/primary";
@@ -19,6 +19,8 @@ public:
     static const QString getWebLookupURL(const QString &callsign,
                                          const QString &URL = QString(),
                                          const bool replaceMacros = true);
+    static const QString getAPIURL(const QString &callbookID,
+                                   const QString &defaultURL);
 
     virtual QString getDisplayName() = 0;
 
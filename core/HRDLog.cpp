@@ -11,6 +11,7 @@
 #include "debug.h"
 #include "core/CredentialStore.h"
 #include "logformat/AdiFormat.h"
+#include "core/UploadOutbox.h"
 
 MODULE_IDENTIFICATION("qlog.core.hrdlog");
 
@@ -129,7 +130,7 @@ void HRDLog::uploadAdif(const QByteArray &data,
         params.addQueryItem("Cmd", "UPDATE");
     }
 
-    QUrl url(API_LOG_UPLOAD_URL);
+    QUrl url(UploadOutbox::uploadURL("hrdlog", API_LOG_UPLOAD_URL));
     QNetworkRequest request(url);
 
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
@@ -103,7 +103,7 @@ void HamQTH::queryCallsign(QString callsign)
     query.addQueryItem("callsign", callsign);
     query.addQueryItem("prg", "QLog");
 
-    QUrl url(API_URL);
+    QUrl url(getAPIURL(HamQTH::CALLBOOK_NAME, API_URL));
     url.setQuery(query);
 
     if ( currentReply )
@@ -149,7 +149,7 @@ void HamQTH::authenticate() {
         query.addQueryItem("u", username);
         query.addQueryItem("p", password);
 
-        QUrl url(API_URL);
+        QUrl url(getAPIURL(HamQTH::CALLBOOK_NAME, API_URL));
         url.setQuery(query);
 
         if ( currentReply )
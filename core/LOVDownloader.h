@@ -3,7 +3,8 @@
 
 #include <QObject>
 #include <QNetworkAccessManager>
-#include <QRegularExpression>
+
+class LOVIngestWorker;
 
 class LOVDownloader : public QObject
 {
@@ -108,28 +109,17 @@ private:
 
     QNetworkAccessManager* nam;
     QNetworkReply *currentReply;
+    LOVIngestWorker *ingestWorker;
     bool abortRequested;
-    QRegularExpression CSVRe;
-    QRegularExpression CTYPrefixSeperatorRe;
-    QRegularExpression CTYPrefixFormatRe;
 
 private:
     bool isTableFilled(const QString &);
-    bool deleteTable(const QString &);
     void download(const SourceDefinition &);
-    void parseData(const LOVDownloader::SourceDefinition &,
-                   QTextStream &);
-    void parseCTY(const SourceDefinition &sourceDef, QTextStream& data);
-    void parseSATLIST(const SourceDefinition &sourceDef, QTextStream& data);
-    void parseSOTASummits(const SourceDefinition &sourceDef, QTextStream& data);
-    void parseWWFFDirectory(const SourceDefinition &sourceDef, QTextStream& data);
-    void parseIOTA(const SourceDefinition &sourceDef, QTextStream& data);
-    void parsePOTA(const SourceDefinition &sourceDef, QTextStream& data);
-    void parseMembershipContent(const SourceDefinition &sourceDef, QTextStream& data);
 
 private slots:
     void processReply(QNetworkReply*);
     void loadData(const LOVDownloader::SourceDefinition &);
+    void ingestFinished();
 
 };
 
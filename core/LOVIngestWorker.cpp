@@ -0,0 +1,706 @@
+#include <QFile>
+#include <QSqlError>
+#include <QSet>
+
+#include "LOVIngestWorker.h"
+#include "data/Data.h"
+#include "data/ReferenceSnapshot.h"
+#include "core/debug.h"
+
+#define LOV_INSERT_BATCH_SIZE 1000
+#define LOV_PROGRESS_INTERVAL 100
+
+MODULE_IDENTIFICATION("qlog.core.lovingestworker");
+
+QDebug operator<<(QDebug debug, const LOVIngestStats &stats)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << "Records: " << stats.records
+                    << "; Duplicates: " << stats.duplicates
+                    << "; Read: " << stats.readTime << "us"
+                    << "; Parse: " << stats.parseTime << "us"
+                    << "; Insert: " << stats.insertTime << "us"
+                    << "; Total: " << stats.totalTime << "ms";
+    return debug;
+}
+
+LOVIngestWorker::LOVIngestWorker(LOVDownloader::SourceType sourceType,
+                                 const QString &filePath,
+                                 const QString &tableName,
+                                 QObject *parent) :
+    QThread(parent),
+    source(sourceType),
+    filePath(filePath),
+    tableName(tableName),
+    ingestResult(false),
+    CTYPrefixSeperatorRe("[\\s;]")
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << sourceType << filePath << tableName;
+
+    connect(this, &QThread::finished, this, &LOVIngestWorker::workFinished);
+}
+
+LOVIngestWorker::~LOVIngestWorker()
+{
+    FCT_IDENTIFICATION;
+
+    if ( isRunning() )
+    {
+        cancel();
+        wait();
+    }
+}
+
+void LOVIngestWorker::cancel()
+{
+    FCT_IDENTIFICATION;
+
+    cancelRequested.storeRelease(1);
+}
+
+bool LOVIngestWorker::result() const
+{
+    return ingestResult;
+}
+
+LOVDownloader::SourceType LOVIngestWorker::sourceType() const
+{
+    return source;
+}
+
+LOVIngestStats LOVIngestWorker::stats() const
+{
+    return ingestStats;
+}
+
+void LOVIngestWorker::run()
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    ingestResult = false;
+    ingestStats = LOVIngestStats();
+
+    QFile file(filePath);
+
+    if ( ! file.open(QIODevice::ReadOnly) )
+    {
+        qWarning() << "Cannot open" << filePath << file.errorString();
+        return;
+    }
+
+    const QString connectionName = QString("lovingest_%1").arg(reinterpret_cast<quintptr>(this), 0, 16);
+
+    if ( openDatabase(connectionName) )
+    {
+        QTextStream stream(&file);
+
+        progressTimer.start();
+
+        if ( db.transaction() )
+        {
+            ingestResult = ingest(stream)
+                           && !cancelRequested.loadAcquire();
+
+            if ( ingestResult )
+            {
+                ingestResult = db.commit();
+            }
+
+            if ( ingestResult )
+            {
+                buildReferenceSnapshot();
+            }
+            else
+            {
+                //can be a result of abort
+                qCWarning(runtime) << tableName << "update failed - rollback" << db.lastError();
+                db.rollback();
+            }
+        }
+        else
+        {
+            qWarning() << "Cannot start transaction" << db.lastError();
+        }
+
+        reportProgress(stream, true);
+    }
+
+    db = QSqlDatabase();
+    {
+        QSqlDatabase connection = QSqlDatabase::database(connectionName, false);
+        connection.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    ingestStats.totalTime = totalTimer.elapsed();
+
+    qCDebug(runtime) << tableName << "update finished:" << ingestResult << ingestStats;
+}
+
+bool LOVIngestWorker::openDatabase(const QString &connectionName)
+{
+    FCT_IDENTIFICATION;
+
+    db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(Data::dbFilename());
+
+    if ( ! db.open() )
+    {
+        qWarning() << "Cannot open DB Connection for the LOV ingest" << db.lastError();
+        return false;
+    }
+
+    QSqlQuery query(db);
+
+    if ( ! query.exec("PRAGMA foreign_keys = ON") )
+    {
+        qWarning() << "Cannot set PRAGMA foreign_keys" << query.lastError();
+        return false;
+    }
+
+    /* the main connection can hold the lock for a short time */
+    if ( ! query.exec("PRAGMA busy_timeout = 5000") )
+    {
+        qWarning() << "Cannot set PRAGMA busy_timeout" << query.lastError();
+    }
+
+    return true;
+}
+
+bool LOVIngestWorker::deleteTable(const QString &name)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << name;
+
+    QSqlQuery query(db);
+
+    if ( ! query.exec(QString("DELETE FROM %1").arg(name)) )
+    {
+        qWarning() << "Cannot delete " << name << query.lastError();
+        return false;
+    }
+
+    return true;
+}
+
+void LOVIngestWorker::buildReferenceSnapshot()
+{
+    FCT_IDENTIFICATION;
+
+    ReferenceSnapshot::Source snapshotSource;
+
+    switch ( source )
+    {
+    case LOVDownloader::IOTALIST: snapshotSource = ReferenceSnapshot::IOTA; break;
+    case LOVDownloader::SOTASUMMITS: snapshotSource = ReferenceSnapshot::SOTA; break;
+    case LOVDownloader::WWFFDIRECTORY: snapshotSource = ReferenceSnapshot::WWFF; break;
+    case LOVDownloader::POTADIRECTORY: snapshotSource = ReferenceSnapshot::POTA; break;
+    default:
+        // the source has no snapshot
+        return;
+    }
+
+    /* completers use the snapshot - it is regenerated only when the source is refreshed */
+    if ( !ReferenceSnapshot::build(snapshotSource, db) )
+    {
+        qWarning() << "Cannot build Reference Snapshot for" << tableName;
+    }
+}
+
+bool LOVIngestWorker::ingest(QTextStream &data)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(runtime) << "Parsing file " << filePath;
+
+    switch ( source )
+    {
+    case LOVDownloader::CTY:
+        return ingestCTY(data);
+
+    case LOVDownloader::SATLIST:
+        return ingestTable(data, {"INSERT INTO sat_info(name, number, uplink, downlink, "
+                                  "                     beacon, mode, callsign, status) "
+                                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+                                  8, QStringList(), ';', false, true});
+
+    case LOVDownloader::SOTASUMMITS:
+        return ingestTable(data, {"INSERT INTO sota_summits(summit_code, association_name, region_name, "
+                                  "                         summit_name, altm, altft, gridref1, gridref2, "
+                                  "                         longitude, latitude, points, bonus_points, "
+                                  "                         valid_from, valid_to) "
+                                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                                  14,
+                                  {"SOTA Summits List",
+                                   "SummitCode,AssociationName,RegionName,"
+                                   "SummitName,AltM,AltFt,GridRef1,GridRef2,"
+                                   "Longitude,Latitude,Points,BonusPoints,"
+                                   "ValidFrom,ValidTo,ActivationCount,"
+                                   "ActivationDate,ActivationCall"},
+                                  ',', true, false});
+
+    case LOVDownloader::WWFFDIRECTORY:
+        return ingestTable(data, {"INSERT INTO wwff_directory(reference, status, name, program, dxcc, "
+                                  "                           state, county, continent, iota, iaruLocator, "
+                                  "                           latitude, longitude, iucncat, valid_from, valid_to) "
+                                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                                  15,
+                                  {"reference,status,"
+                                   "name,program,dxcc,state,"
+                                   "county,continent,iota,"
+                                   "iaruLocator,latitude,"
+                                   "longitude,IUCNcat,validFrom,"
+                                   "validTo,notes,lastMod,changeLog,"
+                                   "reviewFlag,specialFlags,website,"
+                                   "country,region"},
+                                  ',', true, false});
+
+    case LOVDownloader::IOTALIST:
+        return ingestTable(data, {"INSERT INTO iota(iotaid, islandname) "
+                                  "VALUES (?, ?)",
+                                  2, {"iotaid, islandname"}, ',', true, false});
+
+    case LOVDownloader::POTADIRECTORY:
+        return ingestTable(data, {"INSERT INTO pota_directory(reference, name, active, entityID, "
+                                  "                           locationDesc, latitude, longitude, grid) "
+                                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+                                  8,
+                                  {"\"reference\",\"name\",\"active\",\"entityId\",\"locationDesc\",\"latitude\",\"longitude\",\"grid\""},
+                                  ',', true, false});
+
+    case LOVDownloader::MEMBERSHIPCONTENTLIST:
+        return ingestTable(data, {"INSERT INTO membership_directory(short_desc, long_desc, filename, "
+                                  "                                 last_update, num_records) "
+                                  "VALUES (?, ?, ?, ?, ?)",
+                                  5, QStringList(), ',', false, true});
+
+    default:
+        qWarning() << "Unsupported type to ingest" << source << filePath;
+    }
+
+    return false;
+}
+
+bool LOVIngestWorker::ingestCTY(QTextStream &data)
+{
+    FCT_IDENTIFICATION;
+
+    if ( ! deleteTable("dxcc_prefixes")
+         || ! deleteTable(tableName) )
+    {
+        return false;
+    }
+
+    BatchInsert entityInsert(db,
+                             "INSERT INTO dxcc_entities(id, prefix, name, cont, cqz, ituz, lat, lon, tz) "
+                             "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                             9);
+    BatchInsert prefixInsert(db,
+                             "INSERT INTO dxcc_prefixes(dxcc, exact, prefix, cqz, ituz) "
+                             "VALUES (?, ?, ?, ?, ?)",
+                             5);
+
+    if ( !entityInsert.isPrepared() || !prefixInsert.isPrepared() )
+    {
+        return false;
+    }
+
+    QString line;
+    QSet<QString> entityPrefixes;
+    QElapsedTimer parseTimer;
+    bool ret = true;
+
+    while ( ret && readLine(data, line) )
+    {
+        parseTimer.start();
+
+        const QStringList fields = line.split(',');
+
+        if ( fields.count() != 10 )
+        {
+            qCDebug(runtime) << "Invalid line in the input file " << line;
+            continue;
+        }
+        else if ( fields.at(0).startsWith("*") )
+        {
+            continue;
+        }
+
+        const int dxcc_id = fields.at(2).toInt();
+
+        entityInsert.append({dxcc_id,
+                             fields.at(0),
+                             fields.at(1),
+                             fields.at(3),
+                             fields.at(4),
+                             fields.at(5),
+                             fields.at(6).toFloat(),
+                             -fields.at(7).toFloat(),
+                             fields.at(8).toFloat()});
+        ingestStats.records++;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+        const QStringList prefixList = fields.at(9).split(CTYPrefixSeperatorRe, Qt::SkipEmptyParts);
+#else /* Due to ubuntu 20.04 where qt5.12 is present */
+        const QStringList prefixList = fields.at(9).split(CTYPrefixSeperatorRe, QString::SkipEmptyParts);
+#endif
+        entityPrefixes.clear();
+
+        for ( const QString &token : prefixList )
+        {
+            bool exact;
+            QString prefix;
+            int cqz, ituz;
+
+            if ( !parseCTYPrefix(token, exact, prefix, cqz, ituz) )
+            {
+                qCDebug(runtime) << "Failed to match " << token;
+                continue;
+            }
+
+            // removing duplicities in CTY file.
+            if ( entityPrefixes.contains(prefix) )
+            {
+                qCDebug(runtime) << "Removing non-unique prefix" << prefix;
+                ingestStats.duplicates++;
+                continue;
+            }
+
+            entityPrefixes.insert(prefix);
+            prefixInsert.append({dxcc_id, exact, prefix, cqz, ituz});
+        }
+
+        ingestStats.parseTime += parseTimer.nsecsElapsed() / 1000;
+
+        /* prefixes refer to entities therefore entities are inserted first */
+        if ( entityInsert.isFull() || prefixInsert.isFull() )
+        {
+            ret = entityInsert.flush() && prefixInsert.flush();
+        }
+
+        reportProgress(data);
+    }
+
+    ret = ret
+          && entityInsert.flush()
+          && prefixInsert.flush();
+
+    ingestStats.insertTime = entityInsert.insertTime() + prefixInsert.insertTime();
+
+    if ( !ret )
+    {
+        qWarning() << "Cannot insert DXCC records" << entityInsert.lastError() << prefixInsert.lastError();
+    }
+
+    return ret;
+}
+
+bool LOVIngestWorker::ingestTable(QTextStream &data, const TableFormat &format)
+{
+    FCT_IDENTIFICATION;
+
+    if ( ! deleteTable(tableName) )
+    {
+        return false;
+    }
+
+    BatchInsert insert(db, format.insertStatement, format.columnCount);
+
+    if ( !insert.isPrepared() )
+    {
+        return false;
+    }
+
+    QString line;
+    QElapsedTimer parseTimer;
+    int headerLine = 0;
+    bool ret = true;
+
+    while ( ret && readLine(data, line) )
+    {
+        if ( headerLine < format.headers.size() )
+        {
+            //check the header lines
+            if ( !line.contains(format.headers.at(headerLine)) )
+            {
+                qCDebug(runtime) << line;
+                qWarning() << "Unexpected header for" << tableName << "file - aborting";
+                ret = false;
+            }
+            headerLine++;
+            continue;
+        }
+
+        parseTimer.start();
+
+        const QStringList fields = ( format.quoted ) ? splitCSVLine(line)
+                                                     : line.split(format.separator);
+
+        if ( ( format.exactFieldCount && fields.size() != format.columnCount )
+             || fields.size() < format.columnCount )
+        {
+            qCDebug(runtime) << "Invalid line in the input file " << line;
+            continue;
+        }
+
+        QVariantList row;
+        row.reserve(format.columnCount);
+
+        for ( int i = 0; i < format.columnCount; i++ )
+        {
+            row << fields.at(i);
+        }
+
+        insert.append(row);
+        ingestStats.records++;
+        ingestStats.parseTime += parseTimer.nsecsElapsed() / 1000;
+
+        if ( insert.isFull() )
+        {
+            ret = insert.flush();
+        }
+
+        reportProgress(data);
+    }
+
+    ret = ret && insert.flush();
+
+    ingestStats.insertTime = insert.insertTime();
+
+    if ( !ret && !insert.lastError().isEmpty() )
+    {
+        qWarning() << tableName << "insert error" << insert.lastError();
+    }
+
+    return ret;
+}
+
+bool LOVIngestWorker::readLine(QTextStream &data, QString &line)
+{
+    if ( data.atEnd() || cancelRequested.loadAcquire() )
+    {
+        return false;
+    }
+
+    QElapsedTimer readTimer;
+    readTimer.start();
+
+    line = data.readLine();
+
+    ingestStats.readTime += readTimer.nsecsElapsed() / 1000;
+
+    return true;
+}
+
+void LOVIngestWorker::reportProgress(QTextStream &data, bool force)
+{
+    if ( !force && progressTimer.elapsed() < LOV_PROGRESS_INTERVAL )
+    {
+        return;
+    }
+
+    progressTimer.restart();
+
+    /* the file position is ahead of the stream by the stream's buffer
+     * but it is good enough for a progress bar and it is much cheaper than QTextStream::pos() */
+    emit progress(data.device()->pos());
+}
+
+QStringList LOVIngestWorker::splitCSVLine(const QString &line)
+{
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+
+    for ( int i = 0; i < line.size(); i++ )
+    {
+        const QChar c = line.at(i);
+
+        if ( quoted )
+        {
+            if ( c != '"' )
+            {
+                field.append(c);
+            }
+            else if ( i + 1 < line.size() && line.at(i + 1) == '"' )
+            {
+                // escaped quote
+                field.append(c);
+                i++;
+            }
+            else
+            {
+                quoted = false;
+            }
+        }
+        else if ( c == '"' )
+        {
+            quoted = true;
+        }
+        else if ( c == ',' )
+        {
+            fields << field;
+            field.clear();
+        }
+        else
+        {
+            field.append(c);
+        }
+    }
+
+    fields << field;
+
+    return fields;
+}
+
+/* CTY prefix format: [=]PREFIX[(CQZ)][[ITUZ]]
+ * Prefixes with other overrides (lat/lon, continent, timezone) are not supported */
+bool LOVIngestWorker::parseCTYPrefix(const QString &token,
+                                     bool &exact,
+                                     QString &prefix,
+                                     int &cqz,
+                                     int &ituz)
+{
+    const int size = token.size();
+    int pos = 0;
+
+    exact = ( size > 0 && token.at(0) == '=' );
+
+    if ( exact )
+    {
+        pos++;
+    }
+
+    const int prefixStart = pos;
+
+    while ( pos < size
+            && ( ( token.at(pos) >= 'A' && token.at(pos) <= 'Z' )
+                 || token.at(pos).isDigit()
+                 || token.at(pos) == '/' ) )
+    {
+        pos++;
+    }
+
+    if ( pos == prefixStart )
+    {
+        return false;
+    }
+
+    prefix = token.mid(prefixStart, pos - prefixStart);
+
+    auto parseZone = [&token, &pos, size](QChar open, QChar close, int &zone) -> bool
+    {
+        zone = 0;
+
+        if ( pos >= size || token.at(pos) != open )
+        {
+            // the zone is optional
+            return true;
+        }
+
+        const int zoneStart = ++pos;
+
+        while ( pos < size && token.at(pos).isDigit() )
+        {
+            pos++;
+        }
+
+        if ( pos == zoneStart || pos >= size || token.at(pos) != close )
+        {
+            return false;
+        }
+
+        zone = token.mid(zoneStart, pos - zoneStart).toInt();
+        pos++;
+        return true;
+    };
+
+    return parseZone('(', ')', cqz)
+           && parseZone('[', ']', ituz)
+           && pos == size;
+}
+
+LOVIngestWorker::BatchInsert::BatchInsert(const QSqlDatabase &db,
+                                          const QString &statement,
+                                          int columnCount) :
+    query(db),
+    columns(columnCount),
+    pendingRows(0),
+    prepared(false),
+    totalInsertTime(0)
+{
+    FCT_IDENTIFICATION;
+
+    prepared = query.prepare(statement);
+
+    if ( !prepared )
+    {
+        qWarning() << "Cannot prepare Insert statement" << statement << query.lastError();
+    }
+}
+
+bool LOVIngestWorker::BatchInsert::isPrepared() const
+{
+    return prepared;
+}
+
+bool LOVIngestWorker::BatchInsert::isFull() const
+{
+    return pendingRows >= LOV_INSERT_BATCH_SIZE;
+}
+
+void LOVIngestWorker::BatchInsert::append(const QVariantList &row)
+{
+    for ( int i = 0; i < columns.size(); i++ )
+    {
+        columns[i] << row.value(i);
+    }
+
+    pendingRows++;
+}
+
+bool LOVIngestWorker::BatchInsert::flush()
+{
+    FCT_IDENTIFICATION;
+
+    if ( pendingRows == 0 )
+    {
+        return true;
+    }
+
+    QElapsedTimer insertTimer;
+    insertTimer.start();
+
+    for ( const QVariantList &column : qAsConst(columns) )
+    {
+        query.addBindValue(column);
+    }
+
+    const bool ret = query.execBatch();
+
+    for ( QVariantList &column : columns )
+    {
+        column.clear();
+    }
+
+    pendingRows = 0;
+    totalInsertTime += insertTimer.nsecsElapsed() / 1000;
+
+    return ret;
+}
+
+QString LOVIngestWorker::BatchInsert::lastError() const
+{
+    return ( query.lastError().isValid() ) ? query.lastError().text() : QString();
+}
+
+qint64 LOVIngestWorker::BatchInsert::insertTime() const
+{
+    return totalInsertTime;
+}
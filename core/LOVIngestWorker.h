@@ -0,0 +1,114 @@
+#ifndef LOVINGESTWORKER_H
+#define LOVINGESTWORKER_H
+
+#include <QThread>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include "core/LOVDownloader.h"
+
+struct LOVIngestStats
+{
+    qint64 records = 0;
+    qint64 duplicates = 0;
+    qint64 readTime = 0;    // in us
+    qint64 parseTime = 0;   // in us
+    qint64 insertTime = 0;  // in us
+    qint64 totalTime = 0;   // in ms
+};
+
+QDebug operator<<(QDebug debug, const LOVIngestStats &stats);
+
+/* Loads a downloaded List of Values file to its DB table in a worker thread
+ * with its own DB connection. The table is replaced in one transaction,
+ * rows are inserted in batches via prepared statements. The progress
+ * (file position) is reported by the throttled progress signal.
+ * The ingest can be cancelled by cancel() */
+class LOVIngestWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit LOVIngestWorker(LOVDownloader::SourceType sourceType,
+                             const QString &filePath,
+                             const QString &tableName,
+                             QObject *parent = nullptr);
+    ~LOVIngestWorker();
+
+    void cancel();
+    bool result() const;
+    LOVDownloader::SourceType sourceType() const;
+    LOVIngestStats stats() const;
+
+signals:
+    void progress(qint64 position);
+    void workFinished();
+
+protected:
+    virtual void run() override;
+
+private:
+    /* Collects rows and inserts them by one prepared statement */
+    class BatchInsert
+    {
+    public:
+        BatchInsert(const QSqlDatabase &db,
+                    const QString &statement,
+                    int columnCount);
+
+        bool isPrepared() const;
+        bool isFull() const;
+        void append(const QVariantList &row);
+        bool flush();
+        QString lastError() const;
+        qint64 insertTime() const;
+
+    private:
+        QSqlQuery query;
+        QVector<QVariantList> columns;
+        int pendingRows;
+        bool prepared;
+        qint64 totalInsertTime;
+    };
+
+    /* Description of a simple one-table source */
+    struct TableFormat
+    {
+        QString insertStatement;
+        int columnCount;
+        QStringList headers;   // expected header lines
+        QChar separator;
+        bool quoted;           // CSV with quoted fields
+        bool exactFieldCount;
+    };
+
+    bool openDatabase(const QString &connectionName);
+    bool deleteTable(const QString &tableName);
+    void buildReferenceSnapshot();
+    bool ingest(QTextStream &data);
+    bool ingestCTY(QTextStream &data);
+    bool ingestTable(QTextStream &data, const TableFormat &format);
+    bool readLine(QTextStream &data, QString &line);
+    void reportProgress(QTextStream &data, bool force = false);
+
+    static QStringList splitCSVLine(const QString &line);
+    static bool parseCTYPrefix(const QString &token,
+                               bool &exact,
+                               QString &prefix,
+                               int &cqz,
+                               int &ituz);
+
+    LOVDownloader::SourceType source;
+    QString filePath;
+    QString tableName;
+    QSqlDatabase db;
+    QAtomicInt cancelRequested;
+    bool ingestResult;
+    LOVIngestStats ingestStats;
+    QElapsedTimer progressTimer;
+    QRegularExpression CTYPrefixSeperatorRe;
+};
+
+#endif // LOVINGESTWORKER_H
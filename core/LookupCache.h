@@ -0,0 +1,150 @@
+#ifndef LOOKUPCACHE_H
+#define LOOKUPCACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QDebug>
+#include <memory>
+#include <vector>
+
+struct LookupCacheStats
+{
+    quint64 hits = 0;
+    quint64 misses = 0;
+    quint64 evictions = 0;
+    int size = 0;
+    int capacity = 0;
+
+    double hitRate() const
+    {
+        const quint64 total = hits + misses;
+        return ( total > 0 ) ? 100.0 * hits / total : 0.0;
+    }
+};
+
+inline QDebug operator<<(QDebug debug, const LookupCacheStats &stats)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << "LookupCacheStats(hits: " << stats.hits
+                    << ", misses: " << stats.misses
+                    << ", evictions: " << stats.evictions
+                    << ", hit rate: " << stats.hitRate() << "%"
+                    << ", size: " << stats.size << "/" << stats.capacity << ")";
+    return debug;
+}
+
+/* Thread-safe lookup cache. Keys are spread to lock-striped shards, every shard
+ * is an LRU QCache. Values are stored as immutable shared objects therefore
+ * a hit does not copy the value. */
+template <typename Key, typename T>
+class LookupCache
+{
+public:
+    explicit LookupCache(int capacity, int shardCount = DEFAULT_SHARDS)
+    {
+        for ( int i = 0; i < qMax(1, shardCount); i++ )
+        {
+            shards.push_back(std::unique_ptr<Shard>(new Shard));
+        }
+        setCapacity(capacity);
+    }
+
+    void setCapacity(int capacity)
+    {
+        const int shardCount = static_cast<int>(shards.size());
+        const int shardCapacity = qMax(1, (capacity + shardCount - 1) / shardCount);
+
+        for ( const std::unique_ptr<Shard> &shard : shards )
+        {
+            QMutexLocker locker(&shard->lock);
+            shard->cache.setMaxCost(shardCapacity);
+        }
+    }
+
+    QSharedPointer<const T> object(const Key &key)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.lock);
+
+        QSharedPointer<const T> *entry = shard.cache.object(key);
+
+        if ( entry )
+        {
+            shard.hits++;
+            return *entry;
+        }
+
+        shard.misses++;
+        return QSharedPointer<const T>();
+    }
+
+    QSharedPointer<const T> insert(const Key &key, const T &value)
+    {
+        QSharedPointer<const T> sharedValue(new T(value));
+        insert(key, sharedValue);
+        return sharedValue;
+    }
+
+    void insert(const Key &key, const QSharedPointer<const T> &value)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.lock);
+
+        const int expectedSize = shard.cache.count() + (( shard.cache.contains(key) ) ? 0 : 1);
+
+        shard.cache.insert(key, new QSharedPointer<const T>(value));
+
+        if ( shard.cache.count() < expectedSize )
+        {
+            shard.evictions += expectedSize - shard.cache.count();
+        }
+    }
+
+    void clear()
+    {
+        for ( const std::unique_ptr<Shard> &shard : shards )
+        {
+            QMutexLocker locker(&shard->lock);
+            shard->cache.clear();
+        }
+    }
+
+    LookupCacheStats stats() const
+    {
+        LookupCacheStats ret;
+
+        for ( const std::unique_ptr<Shard> &shard : shards )
+        {
+            QMutexLocker locker(&shard->lock);
+            ret.hits += shard->hits;
+            ret.misses += shard->misses;
+            ret.evictions += shard->evictions;
+            ret.size += shard->cache.count();
+            ret.capacity += shard->cache.maxCost();
+        }
+
+        return ret;
+    }
+
+    static const int DEFAULT_SHARDS = 16;
+
+private:
+    struct Shard
+    {
+        mutable QMutex lock;
+        QCache<Key, QSharedPointer<const T>> cache;
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    Shard &shardFor(const Key &key)
+    {
+        return *shards[qHash(key) % shards.size()];
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+#endif // LOOKUPCACHE_H
@@ -64,28 +64,22 @@ void Lotw::update(const QDate &start_date, bool qso_since, const QString &statio
     get(params);
 }
 
-int Lotw::uploadAdif(const QByteArray &data, QString &ErrorString)
+QString Lotw::tqslErrorString(int ErrorCode)
 {
     FCT_IDENTIFICATION;
 
-    QTemporaryFile file;
-    file.open();
-    file.write(data);
-    file.flush();
+    qCDebug(function_parameters) << ErrorCode;
 
-    ErrorString = "";
-    QStringList args;
-    args << "-d" << "-q" << "-u" << file.fileName();
-    int ErrorCode = QProcess::execute(getTQSLPath("tqsl"),args);
+    QString ErrorString;
 
     /* list of Error Codes: http://www.arrl.org/command-1 */
     switch ( ErrorCode )
     {
-    case -2: // Error code of QProcess::execute - Process cannot start
+    case -2: // Process cannot start
         ErrorString = tr("TQSL not found");
         break;
 
-    case -1: // Error code of QProcess::execute - Process crashed
+    case -1: // Process crashed
         ErrorString = tr("TQSL crashed");
         break;
 
@@ -140,7 +134,7 @@ int Lotw::uploadAdif(const QByteArray &data, QString &ErrorString)
         ErrorString = tr("Unexpected Error from TQSL");
     }
 
-    return ErrorCode;
+    return ErrorString;
 }
 
 const QString Lotw::getUsername()
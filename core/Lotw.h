@@ -16,11 +16,11 @@ public:
     ~Lotw();
 
     void update(const QDate &, bool, const QString &);
-    int uploadAdif(const QByteArray &, QString &);
 
     static const QString getUsername();
     static const QString getPassword();
     static const QString getTQSLPath(const QString &defaultPath = QDir::rootPath());
+    static QString tqslErrorString(int);
 
     static void saveUsernamePassword(const QString&, const QString&);
     static void saveTQSLPath(const QString&);
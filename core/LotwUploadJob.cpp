@@ -0,0 +1,339 @@
+#include <QSettings>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include "LotwUploadJob.h"
+#include "core/Lotw.h"
+#include "logformat/AdiFormat.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.core.lotwuploadjob");
+
+LotwUploadJob::LotwUploadJob(const QList<int> &contactIDs,
+                             QObject *parent) :
+    QObject(parent),
+    totalQSOs(contactIDs.size()),
+    uploadedQSOs(0),
+    chunkCount(0),
+    done(false)
+{
+    FCT_IDENTIFICATION;
+
+    const int chunkSize = getChunkSize();
+
+    for ( int i = 0; i < contactIDs.size(); i += chunkSize )
+    {
+        pendingChunks << contactIDs.mid(i, chunkSize);
+    }
+
+    chunkCount = pendingChunks.size();
+
+    qCDebug(runtime) << "QSOs" << totalQSOs << "chunks" << chunkCount;
+}
+
+LotwUploadJob::~LotwUploadJob()
+{
+    FCT_IDENTIFICATION;
+
+    for ( auto it = runningChunks.cbegin(); it != runningChunks.cend(); ++it )
+    {
+        it.key()->disconnect(this);
+        it.key()->kill();
+        it.key()->waitForFinished();
+    }
+}
+
+int LotwUploadJob::getChunkSize()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    return qMax(1, settings.value(LotwUploadJob::CONFIG_CHUNK_SIZE_KEY, 500).toInt());
+}
+
+int LotwUploadJob::getMaxProcesses()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    /* TQSL keeps its duplicate database locked therefore the chunks
+     * are signed sequentially unless the user says otherwise */
+    return qBound(1, settings.value(LotwUploadJob::CONFIG_MAX_PROCESSES_KEY, 1).toInt(), 8);
+}
+
+void LotwUploadJob::start()
+{
+    FCT_IDENTIFICATION;
+
+    emit progress(uploadedQSOs, totalQSOs);
+
+    startNextChunks();
+}
+
+void LotwUploadJob::cancel()
+{
+    FCT_IDENTIFICATION;
+
+    fail(tr("Upload cancelled"));
+
+    /* a killed chunk reports a crash and its QSOs stay unchanged.
+     * A chunk which finishes successfully meanwhile is marked as uploaded */
+    for ( auto it = runningChunks.cbegin(); it != runningChunks.cend(); ++it )
+    {
+        it.key()->kill();
+    }
+}
+
+void LotwUploadJob::startNextChunks()
+{
+    FCT_IDENTIFICATION;
+
+    const int maxProcesses = getMaxProcesses();
+
+    while ( runningChunks.size() < maxProcesses && !pendingChunks.isEmpty() )
+    {
+        if ( ! startChunk(pendingChunks.takeFirst()) )
+        {
+            fail(tr("Cannot export QSOs for TQSL"));
+            return;
+        }
+    }
+
+    checkFinished();
+}
+
+bool LotwUploadJob::startChunk(const QList<int> &contactIDs)
+{
+    FCT_IDENTIFICATION;
+
+    QTemporaryFile *file = new QTemporaryFile(this);
+
+    if ( ! exportChunk(contactIDs, file) )
+    {
+        delete file;
+        return false;
+    }
+
+    Chunk chunk;
+    chunk.index = chunkCount - pendingChunks.size();
+    chunk.contactIDs = contactIDs;
+    chunk.file = file;
+
+    QProcess *process = new QProcess(this);
+    process->setProcessChannelMode(QProcess::MergedChannels);
+
+    runningChunks.insert(process, chunk);
+
+    connect(process, &QProcess::readyReadStandardOutput, this, [this, process]()
+    {
+        readOutput(process);
+    });
+
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, [this, process](int exitCode, QProcess::ExitStatus exitStatus)
+    {
+        chunkFinished(process, ( exitStatus == QProcess::CrashExit ) ? -1 : exitCode);
+    });
+
+    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error)
+    {
+        /* finished signal is not emitted when the process does not start */
+        if ( error == QProcess::FailedToStart )
+        {
+            chunkFinished(process, -2);
+        }
+    });
+
+    qCDebug(runtime) << "Starting chunk" << chunk.index << "QSOs" << contactIDs.size();
+
+    process->start(Lotw::getTQSLPath("tqsl"),
+                   QStringList() << "-d" << "-q" << "-u" << file->fileName());
+
+    return true;
+}
+
+bool LotwUploadJob::exportChunk(const QList<int> &contactIDs,
+                                QTemporaryFile *file)
+{
+    FCT_IDENTIFICATION;
+
+    if ( ! file->open() )
+    {
+        qWarning() << "Cannot open temporary file" << file->errorString();
+        return false;
+    }
+
+    QSqlQuery query;
+
+    if ( ! query.exec("SELECT callsign, freq, band, freq_rx, "
+                      "       mode, submode, start_time, prop_mode, "
+                      "       sat_name, station_callsign, operator, "
+                      "       rst_sent, rst_rcvd, my_state, my_cnty, "
+                      "       my_vucc_grids "
+                      "FROM contacts "
+                      "WHERE id IN (" + idList(contactIDs) + ") "
+                      "ORDER BY start_time") )
+    {
+        qWarning() << "Cannot get QSOs for upload" << query.lastError();
+        return false;
+    }
+
+    QTextStream stream(file);
+    AdiFormat adi(stream);
+
+    while ( query.next() )
+    {
+        adi.exportContact(query.record());
+    }
+
+    stream.flush();
+
+    /* the file stays on the disk until the QTemporaryFile is destroyed */
+    file->close();
+
+    return true;
+}
+
+void LotwUploadJob::readOutput(QProcess *process, bool readAll)
+{
+    FCT_IDENTIFICATION;
+
+    auto it = runningChunks.constFind(process);
+
+    if ( it == runningChunks.cend() )
+    {
+        return;
+    }
+
+    const QString prefix = ( chunkCount > 1 ) ? QString("[%1/%2] ").arg(it->index).arg(chunkCount)
+                                              : QString();
+
+    while ( process->canReadLine() )
+    {
+        const QString line = QString::fromLocal8Bit(process->readLine()).trimmed();
+
+        if ( !line.isEmpty() )
+        {
+            emit output(prefix + line);
+        }
+    }
+
+    /* the last line does not have to be terminated */
+    const QString rest = ( readAll ) ? QString::fromLocal8Bit(process->readAll()).trimmed()
+                                     : QString();
+
+    if ( !rest.isEmpty() )
+    {
+        emit output(prefix + rest);
+    }
+}
+
+void LotwUploadJob::chunkFinished(QProcess *process, int exitCode)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << exitCode;
+
+    if ( ! runningChunks.contains(process) )
+    {
+        return;
+    }
+
+    readOutput(process, true);
+
+    const Chunk chunk = runningChunks.take(process);
+
+    chunk.file->deleteLater();
+    process->deleteLater();
+
+    qCDebug(runtime) << "Chunk" << chunk.index << "finished" << exitCode;
+
+    if ( exitCode == 0 )
+    {
+        /* QSOs are in LoTW now even if the upload has been cancelled meanwhile */
+        if ( markUploaded(chunk.contactIDs) )
+        {
+            uploadedQSOs += chunk.contactIDs.size();
+            emit progress(uploadedQSOs, totalQSOs);
+        }
+        else
+        {
+            fail(tr("Cannot update LoTW QSL status"));
+        }
+    }
+    else
+    {
+        fail(Lotw::tqslErrorString(exitCode));
+    }
+
+    startNextChunks();
+}
+
+bool LotwUploadJob::markUploaded(const QList<int> &contactIDs)
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query;
+
+    if ( ! query.exec("UPDATE contacts "
+                      "SET lotw_qsl_sent='Y', lotw_qslsdate = strftime('%Y-%m-%d',DATETIME('now', 'utc')) "
+                      "WHERE id IN (" + idList(contactIDs) + ")") )
+    {
+        qWarning() << "Cannot execute update query" << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+void LotwUploadJob::fail(const QString &error)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << error;
+
+    /* the first error is reported; remaining chunks are not started */
+    if ( lastError.isEmpty() )
+    {
+        lastError = error;
+    }
+
+    pendingChunks.clear();
+
+    checkFinished();
+}
+
+void LotwUploadJob::checkFinished()
+{
+    FCT_IDENTIFICATION;
+
+    if ( done || !pendingChunks.isEmpty() || !runningChunks.isEmpty() )
+    {
+        return;
+    }
+
+    done = true;
+
+    qCDebug(runtime) << "Uploaded" << uploadedQSOs << "of" << totalQSOs << lastError;
+
+    emit finished(uploadedQSOs, lastError);
+}
+
+QString LotwUploadJob::idList(const QList<int> &contactIDs)
+{
+    QStringList ret;
+
+    for ( int contactID : contactIDs )
+    {
+        ret << QString::number(contactID);
+    }
+
+    return ret.join(",");
+}
+
+const QString LotwUploadJob::CONFIG_CHUNK_SIZE_KEY = "lotw/upload_chunk_size";
+const QString LotwUploadJob::CONFIG_MAX_PROCESSES_KEY = "lotw/tqsl_processes";
@@ -0,0 +1,67 @@
+#ifndef LOTWUPLOADJOB_H
+#define LOTWUPLOADJOB_H
+
+#include <QObject>
+#include <QProcess>
+#include <QHash>
+
+class QTemporaryFile;
+
+/* Signs and uploads QSOs to LoTW with TQSL without blocking the GUI.
+ * QSOs are split into chunks, every chunk is signed by its own TQSL
+ * process (the chunks run sequentially by default). TQSL output is passed
+ * line by line. LoTW status of the QSOs is updated per chunk and only when
+ * TQSL has accepted the chunk */
+class LotwUploadJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LotwUploadJob(const QList<int> &contactIDs,
+                           QObject *parent = nullptr);
+    ~LotwUploadJob();
+
+    static int getChunkSize();
+    static int getMaxProcesses();
+
+    const static QString CONFIG_CHUNK_SIZE_KEY;
+    const static QString CONFIG_MAX_PROCESSES_KEY;
+
+signals:
+    void output(QString line);
+    void progress(int uploadedQSOs, int totalQSOs);
+    void finished(int uploadedQSOs, QString error);
+
+public slots:
+    void start();
+    void cancel();
+
+private:
+    struct Chunk
+    {
+        int index;
+        QList<int> contactIDs;
+        QTemporaryFile *file;
+    };
+
+    void startNextChunks();
+    bool startChunk(const QList<int> &contactIDs);
+    bool exportChunk(const QList<int> &contactIDs, QTemporaryFile *file);
+    void readOutput(QProcess *process, bool readAll = false);
+    void chunkFinished(QProcess *process, int exitCode);
+    bool markUploaded(const QList<int> &contactIDs);
+    void fail(const QString &error);
+    void checkFinished();
+
+    static QString idList(const QList<int> &contactIDs);
+
+    QList<QList<int>> pendingChunks;
+    QHash<QProcess*, Chunk> runningChunks;
+    int totalQSOs;
+    int uploadedQSOs;
+    int chunkCount;
+    QString lastError;
+    bool done;
+};
+
+#endif // LOTWUPLOADJOB_H
@@ -73,7 +73,7 @@ MembershipQE::MembershipQE(QObject *parent)
     connect(nam.data(), &QNetworkAccessManager::finished, this, &MembershipQE::onFinishedListDownload);
 
     // prepare SQL query to increase Club query function performance
-    idClubQueryValid = clubQuery.prepare("SELECT DISTINCT callsign, member_id, valid_from, valid_to, clubid FROM membership WHERE callsign = :callsign ORDER BY clubid");
+    idClubQueryValid = prepareClubQuery(clubQuery);
 }
 
 MembershipQE::~MembershipQE()
@@ -140,31 +140,47 @@ QList<ClubInfo> MembershipQE::query(const QString &in_callsign)
 
     qCDebug(function_parameters) << in_callsign;
 
-    QList<ClubInfo> ret;
-
     if ( !idClubQueryValid )
     {
         qCDebug(runtime) << "Query is not prepared";
-        return ret;
+        return QList<ClubInfo>();
     }
 
+    return query(clubQuery, in_callsign);
+}
+
+bool MembershipQE::prepareClubQuery(QSqlQuery &in_clubQuery)
+{
+    FCT_IDENTIFICATION;
+
+    return in_clubQuery.prepare("SELECT DISTINCT callsign, member_id, valid_from, valid_to, clubid FROM membership WHERE callsign = :callsign ORDER BY clubid");
+}
+
+QList<ClubInfo> MembershipQE::query(QSqlQuery &in_clubQuery, const QString &in_callsign)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << in_callsign;
+
+    QList<ClubInfo> ret;
+
     Callsign qCall(in_callsign);
 
-    clubQuery.bindValue(":callsign",( qCall.isValid() ) ? qCall.getBase() : in_callsign.toUpper());
+    in_clubQuery.bindValue(":callsign",( qCall.isValid() ) ? qCall.getBase() : in_callsign.toUpper());
 
-    if ( ! clubQuery.exec() )
+    if ( ! in_clubQuery.exec() )
     {
-        qCDebug(runtime) << "Cannot query callsign clubs "<< clubQuery.lastError().text();
+        qCDebug(runtime) << "Cannot query callsign clubs "<< in_clubQuery.lastError().text();
         return ret;
     }
 
-    while ( clubQuery.next() )
+    while ( in_clubQuery.next() )
     {
-        QString callsign = clubQuery.value(0).toString();
-        QString memberid = clubQuery.value(1).toString();
-        QDate validFrom = QDate::fromString(clubQuery.value(2).toString(), "yyyyMMdd");
-        QDate validTo = QDate::fromString(clubQuery.value(3).toString(), "yyyyMMdd");
-        QString clubid = clubQuery.value(4).toString();
+        QString callsign = in_clubQuery.value(0).toString();
+        QString memberid = in_clubQuery.value(1).toString();
+        QDate validFrom = QDate::fromString(in_clubQuery.value(2).toString(), "yyyyMMdd");
+        QDate validTo = QDate::fromString(in_clubQuery.value(3).toString(), "yyyyMMdd");
+        QString clubid = in_clubQuery.value(4).toString();
 
         qCDebug(runtime) << "Found membership record" << callsign << memberid << validFrom << validTo << clubid;
 
@@ -82,6 +82,11 @@ public:
     // return only list of clubs where callsign is a member.
     QList<ClubInfo> query(const QString &callsign);
 
+    // the same as query but it uses a caller's prepared query.
+    // It is used by threads which have their own DB connection.
+    static bool prepareClubQuery(QSqlQuery &in_clubQuery);
+    static QList<ClubInfo> query(QSqlQuery &in_clubQuery, const QString &callsign);
+
     // return Status for each club
     // Membership status details can take a long time (depend on the number of records in the log and membership lists)
     // therefore qlog runs this query in an isolated thread (do not block the main thread). The result is returned via clubStatusResult signal - if exists
@@ -186,6 +186,9 @@ bool Migration::functionMigration(int version)
     case 17:
         ret = createTriggers();
         break;
+    case 25:
+        ret = createCallsignSearchTriggers();
+        break;
     default:
         ret = true;
     }
@@ -492,6 +495,59 @@ bool Migration::createTriggers()
     return true;
 }
 
+bool Migration::createCallsignSearchTriggers()
+{
+    FCT_IDENTIFICATION;
+
+    // Triggers keep the Callsign Search Index (contacts_callsign_trigrams) up to date.
+    // They are created here for the same reason as in createTriggers()
+
+    const QString trigramSelect("SELECT DISTINCT substr(upper(NEW.callsign), p.n, 3), NEW.id "
+                                "FROM contacts_callsign_positions p "
+                                "WHERE p.n <= length(NEW.callsign) - 2");
+
+    const QStringList statements =
+    {
+        "DROP TRIGGER IF EXISTS contacts_callsign_trigrams_ins",
+        "DROP TRIGGER IF EXISTS contacts_callsign_trigrams_upd",
+        "DROP TRIGGER IF EXISTS contacts_callsign_trigrams_del",
+        "CREATE TRIGGER contacts_callsign_trigrams_ins "
+        "AFTER INSERT ON contacts "
+        "FOR EACH ROW "
+        "BEGIN "
+        "  INSERT OR IGNORE INTO contacts_callsign_trigrams (trigram, contactid) "
+        + trigramSelect + "; "
+        "END;",
+        "CREATE TRIGGER contacts_callsign_trigrams_upd "
+        "AFTER UPDATE OF callsign ON contacts "
+        "FOR EACH ROW "
+        "BEGIN "
+        "  DELETE FROM contacts_callsign_trigrams WHERE contactid = OLD.id; "
+        "  INSERT OR IGNORE INTO contacts_callsign_trigrams (trigram, contactid) "
+        + trigramSelect + "; "
+        "END;",
+        "CREATE TRIGGER contacts_callsign_trigrams_del "
+        "AFTER DELETE ON contacts "
+        "FOR EACH ROW "
+        "BEGIN "
+        "  DELETE FROM contacts_callsign_trigrams WHERE contactid = OLD.id; "
+        "END;"
+    };
+
+    QSqlQuery query;
+
+    for ( const QString &statement : statements )
+    {
+        if ( ! query.exec(statement) )
+        {
+            qWarning() << "Cannot create Callsign Search Index trigger" << query.lastError().text();
+            return false;
+        }
+    }
+
+    return true;
+}
+
 QString Migration::fixIntlField(QSqlQuery &query, const QString &columName, const QString &columnNameIntl)
 {
     FCT_IDENTIFICATION;
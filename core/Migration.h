@@ -36,9 +36,10 @@ private:
     bool insertUUID();
     bool fillMyDXCC();
     bool createTriggers();
+    bool createCallsignSearchTriggers();
     QString fixIntlField(QSqlQuery &query, const QString &columName, const QString &columnNameIntl);
 
-    static const int latestVersion = 22;
+    static const int latestVersion = 25;
 };
 
 #endif // MIGRATION_H
@@ -1,16 +1,44 @@
 #include <QUuid>
-#include <QUdpSocket>
 
 #include "NetworkNotification.h"
 #include "debug.h"
 #include "LogParam.h"
 
+// Maximal number of messages waiting for a batch per destination list;
+// the oldest ones are dropped
+#define MAX_BATCH_QUEUE_SIZE 1000
+
+// Maximal number of messages in one batch datagram
+#define MAX_BATCH_MESSAGES 32
+
 MODULE_IDENTIFICATION("qlog.ui.networknotification");
 
 NetworkNotification::NetworkNotification(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      channels(CHANNEL_COUNT),
+      batchTimer(new QTimer(this)),
+      batchWindow(0),
+      payloadFormat(JSON_PAYLOAD)
 {
     FCT_IDENTIFICATION;
+
+    for ( ChannelState &channel : channels )
+    {
+        channel.forwarder = new UdpForwarder(this);
+    }
+
+    batchTimer->setSingleShot(true);
+    connect(batchTimer, &QTimer::timeout, this, &NetworkNotification::flushBatches);
+
+    reloadSettings();
+}
+
+NetworkNotification::~NetworkNotification()
+{
+    FCT_IDENTIFICATION;
+
+    flushBatches();
+    logStats();
 }
 
 QString NetworkNotification::getNotifQSOAdiAddrs()
@@ -84,18 +112,54 @@ void NetworkNotification::saveNotifSpotAlertAddrs(const QString &addresses)
 
 }
 
+int NetworkNotification::getNotifBatchWindow()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    return settings.value(NetworkNotification::CONFIG_NOTIF_BATCH_WINDOW_KEY, 0).toInt();
+}
+
+NetworkNotification::PayloadFormat NetworkNotification::getNotifPayloadFormat()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    return ( settings.value(NetworkNotification::CONFIG_NOTIF_PAYLOAD_FORMAT_KEY).toString() == "cbor" ) ? CBOR_PAYLOAD
+                                                                                                         : JSON_PAYLOAD;
+}
+
+void NetworkNotification::reloadSettings()
+{
+    FCT_IDENTIFICATION;
+
+    /* waiting messages are sent with the old settings */
+    flushBatches();
+    logStats();
+
+    channels[QSO_CHANNEL].forwarder->setDestinations(getNotifQSOAdiAddrs());
+    channels[DXSPOT_CHANNEL].forwarder->setDestinations(getNotifDXSpotAddrs());
+    channels[WSJTXCQSPOT_CHANNEL].forwarder->setDestinations(getNotifWSJTXCQSpotAddrs());
+    channels[SPOTALERT_CHANNEL].forwarder->setDestinations(getNotifSpotAlertAddrs());
+
+    batchWindow = getNotifBatchWindow();
+    payloadFormat = getNotifPayloadFormat();
+
+    qCDebug(runtime) << "Batch window" << batchWindow << "Payload format" << payloadFormat;
+}
+
 void NetworkNotification::QSOInserted(const QSqlRecord &record)
 {
     FCT_IDENTIFICATION;
 
     qCDebug(function_parameters) << "Inserted: " << record;
 
-    HostsPortString destList(getNotifQSOAdiAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(QSO_CHANNEL) )
     {
         QSONotificationMsg qsoMsg(record, QSONotificationMsg::QSO_INSERT);
-        send(qsoMsg.getJson(), destList);
+        send(qsoMsg, QSO_CHANNEL);
     }
 }
 
@@ -104,12 +168,10 @@ void NetworkNotification::QSOUpdated(const QSqlRecord &record)
     FCT_IDENTIFICATION;
     qCDebug(function_parameters) << "Updated: " << record;
 
-    HostsPortString destList(getNotifQSOAdiAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(QSO_CHANNEL) )
     {
         QSONotificationMsg qsoMsg(record, QSONotificationMsg::QSO_UPDATE);
-        send(qsoMsg.getJson(), destList);
+        send(qsoMsg, QSO_CHANNEL);
     }
 }
 
@@ -118,12 +180,10 @@ void NetworkNotification::QSODeleted(const QSqlRecord &record)
     FCT_IDENTIFICATION;
     qCDebug(function_parameters) << "Deleted: " << record;
 
-    HostsPortString destList(getNotifQSOAdiAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(QSO_CHANNEL) )
     {
         QSONotificationMsg qsoMsg(record, QSONotificationMsg::QSO_DELETE);
-        send(qsoMsg.getJson(), destList);
+        send(qsoMsg, QSO_CHANNEL);
     }
 }
 
@@ -133,12 +193,10 @@ void NetworkNotification::dxSpot(const DxSpot &spot)
 
     qCDebug(function_parameters) << "DX Spot";
 
-    HostsPortString destList(getNotifDXSpotAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(DXSPOT_CHANNEL) )
     {
         DXSpotNotificationMsg dxSpotMsg(spot);
-        send(dxSpotMsg.getJson(), destList);
+        send(dxSpotMsg, DXSPOT_CHANNEL, true);
     }
 }
 
@@ -147,12 +205,10 @@ void NetworkNotification::wcySpot(const WCYSpot &spot)
     FCT_IDENTIFICATION;
     qCDebug(function_parameters) << "WCY Spot";
 
-    HostsPortString destList(getNotifDXSpotAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(DXSPOT_CHANNEL) )
     {
         WCYSpotNotificationMsg WCYSpotMsg(spot);
-        send(WCYSpotMsg.getJson(), destList);
+        send(WCYSpotMsg, DXSPOT_CHANNEL, true);
     }
 }
 
@@ -161,12 +217,10 @@ void NetworkNotification::wwvSpot(const WWVSpot &spot)
     FCT_IDENTIFICATION;
     qCDebug(function_parameters) << "WWV Spot";
 
-    HostsPortString destList(getNotifDXSpotAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(DXSPOT_CHANNEL) )
     {
         WWVSpotNotificationMsg WWVSpotMsg(spot);
-        send(WWVSpotMsg.getJson(), destList);
+        send(WWVSpotMsg, DXSPOT_CHANNEL, true);
     }
 }
 
@@ -175,12 +229,10 @@ void NetworkNotification::toAllSpot(const ToAllSpot &spot)
     FCT_IDENTIFICATION;
     qCDebug(function_parameters) << "ToALL Spot";
 
-    HostsPortString destList(getNotifDXSpotAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(DXSPOT_CHANNEL) )
     {
         ToAllSpotNotificationMsg ToAllSpotMsg(spot);
-        send(ToAllSpotMsg.getJson(), destList);
+        send(ToAllSpotMsg, DXSPOT_CHANNEL, true);
     }
 }
 
@@ -190,12 +242,10 @@ void NetworkNotification::WSJTXCQSpot(const WsjtxEntry &spot)
 
     qCDebug(function_parameters) << "WSJTX CQ Spot";
 
-    HostsPortString destList(getNotifWSJTXCQSpotAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(WSJTXCQSPOT_CHANNEL) )
     {
         WSJTXCQSpotNotificationMsg dxSpotMsg(spot);
-        send(dxSpotMsg.getJson(), destList);
+        send(dxSpotMsg, WSJTXCQSPOT_CHANNEL, true);
     }
 }
 
@@ -205,34 +255,105 @@ void NetworkNotification::spotAlert(const SpotAlert &spot)
 
     qCDebug(function_parameters) << "Usert Alert";
 
-    HostsPortString destList(getNotifSpotAlertAddrs());
-
-    if ( destList.getAddrList().size() > 0 )
+    if ( hasDestinations(SPOTALERT_CHANNEL) )
     {
         SpotAlertNotificationMsg spotAlertMsg(spot);
-        send(spotAlertMsg.getJson(), destList);
+        send(spotAlertMsg, SPOTALERT_CHANNEL);
     }
 }
 
-void NetworkNotification::send(const QByteArray &data, const HostsPortString &dests)
+bool NetworkNotification::hasDestinations(Channel channelID) const
+{
+    return channels.at(channelID).forwarder->destinationCount() > 0;
+}
+
+void NetworkNotification::send(const GenericNotificationMsg &msg,
+                               Channel channelID,
+                               bool batchable)
 {
     FCT_IDENTIFICATION;
 
-    qCDebug(function_parameters) << QString(data);
+    qCDebug(function_parameters) << channelID << batchable;
 
-    if ( data.size() <= 0 )
+    ChannelState &channel = channels[channelID];
+
+    if ( !batchable || batchWindow <= 0 )
     {
+        channel.forwarder->forward(serialize(msg));
         return;
     }
 
-    QList<HostPortAddress> addrList = dests.getAddrList();
+    if ( channel.batch.size() >= MAX_BATCH_QUEUE_SIZE )
+    {
+        channel.batch.removeFirst();
+        channel.dropped++;
+    }
+
+    channel.batch << msg.getMsg();
+    channel.queued++;
+
+    if ( !batchTimer->isActive() )
+    {
+        batchTimer->start(batchWindow);
+    }
+}
+
+void NetworkNotification::flushBatches()
+{
+    FCT_IDENTIFICATION;
+
+    batchTimer->stop();
+
+    for ( ChannelState &channel : channels )
+    {
+        if ( channel.batch.isEmpty() )
+        {
+            continue;
+        }
+
+        QList<QByteArray> datagrams;
+
+        for ( int i = 0; i < channel.batch.size(); i += MAX_BATCH_MESSAGES )
+        {
+            QJsonArray data;
+            const int end = qMin(i + MAX_BATCH_MESSAGES, channel.batch.size());
+
+            for ( int j = i; j < end; j++ )
+            {
+                data.append(channel.batch.at(j));
+            }
+
+            datagrams << serialize(BatchNotificationMsg(data));
+        }
+
+        qCDebug(runtime) << "Flushing" << channel.batch.size() << "messages in" << datagrams.size() << "datagrams";
+
+        channel.batch.clear();
+        channel.forwarder->forward(datagrams);
+    }
+}
+
+QByteArray NetworkNotification::serialize(const GenericNotificationMsg &msg) const
+{
+    return ( payloadFormat == CBOR_PAYLOAD ) ? msg.getCbor() : msg.getJson();
+}
+
+void NetworkNotification::logStats() const
+{
+    FCT_IDENTIFICATION;
 
-    for ( const HostPortAddress &addr : qAsConst(addrList) )
+    for ( int i = 0; i < channels.size(); i++ )
     {
-        QUdpSocket udpSocket;
+        qCDebug(runtime) << "Channel" << i
+                         << "Queued:" << channels.at(i).queued
+                         << "Dropped:" << channels.at(i).dropped;
 
-        qCDebug(runtime) << "Sending to " << addr;
-        udpSocket.writeDatagram(data, addr, addr.getPort());
+        const QList<UdpForwarder::DestinationStats> destStats = channels.at(i).forwarder->stats();
+
+        for ( const UdpForwarder::DestinationStats &stats : destStats )
+        {
+            qCDebug(runtime) << stats;
+        }
     }
 }
 
@@ -240,6 +361,8 @@ QString NetworkNotification::CONFIG_NOTIF_QSO_ADI_ADDRS_KEY = "network/notificat
 QString NetworkNotification::CONFIG_NOTIF_DXSPOT_ADDRS_KEY = "network/notification/dxspot/addrs";
 QString NetworkNotification::CONFIG_NOTIF_WSJTXCQSPOT_ADDRS_KEY = "network/notification/wsjtx/cqspot/addrs";
 QString NetworkNotification::CONFIG_NOTIF_SPOTALERT_ADDRS_KEY = "network/notification/alerts/spot/addrs";
+QString NetworkNotification::CONFIG_NOTIF_BATCH_WINDOW_KEY = "network/notification/batch_window_ms";
+QString NetworkNotification::CONFIG_NOTIF_PAYLOAD_FORMAT_KEY = "network/notification/payload_format";
 
 GenericNotificationMsg::GenericNotificationMsg(QObject *parent) :
     QObject(parent)
@@ -445,6 +568,15 @@ WWVSpotNotificationMsg::WWVSpotNotificationMsg(const WWVSpot &spot, QObject *par
     msg["data"] = spotData;
 }
 
+BatchNotificationMsg::BatchNotificationMsg(const QJsonArray &messages, QObject *parent) :
+    GenericNotificationMsg(parent)
+{
+    FCT_IDENTIFICATION;
+
+    msg["msgtype"] = "batch";
+    msg["data"] = messages;
+}
+
 ToAllSpotNotificationMsg::ToAllSpotNotificationMsg(const ToAllSpot &spot, QObject *parent) :
     GenericNotificationMsg(parent)
 {
@@ -5,7 +5,10 @@
 #include <QSqlRecord>
 #include <QJsonObject>
 #include <QJsonDocument>
-#include "core/HostsPortString.h"
+#include <QJsonArray>
+#include <QCborValue>
+#include <QTimer>
+#include "core/UdpForwarder.h"
 #include "logformat/LogFormat.h"
 #include "data/DxSpot.h"
 #include "Wsjtx.h"
@@ -22,6 +25,8 @@ class GenericNotificationMsg : public QObject
 public:
     explicit GenericNotificationMsg(QObject *parent = nullptr);
     QByteArray getJson() const  { return QJsonDocument(msg).toJson(QJsonDocument::Compact); };
+    QByteArray getCbor() const  { return QCborValue::fromJsonValue(msg).toCbor(); };
+    const QJsonObject &getMsg() const { return msg; };
 
 protected:
     QJsonObject msg;
@@ -116,11 +121,29 @@ public:
 
 };
 
+class BatchNotificationMsg : public GenericNotificationMsg
+{
+
+public:
+    explicit BatchNotificationMsg(const QJsonArray&, QObject *parent = nullptr);
+
+};
+
+/* Sends the notifications to the configured destinations. Every destination
+ * list has its own long-lived sockets. Spots can be coalesced within
+ * a batch window and sent as one "batch" message */
 class NetworkNotification : public QObject
 {
     Q_OBJECT
 public:
+    enum PayloadFormat
+    {
+        JSON_PAYLOAD = 0,
+        CBOR_PAYLOAD = 1
+    };
+
     explicit NetworkNotification(QObject *parent = nullptr);
+    ~NetworkNotification();
 
     static QString getNotifQSOAdiAddrs();
     static void saveNotifQSOAdiAddrs(const QString &);
@@ -130,8 +153,11 @@ public:
     static void saveNotifWSJTXCQSpotAddrs(const QString &);
     static QString getNotifSpotAlertAddrs();
     static void saveNotifSpotAlertAddrs(const QString &);
+    static int getNotifBatchWindow();
+    static PayloadFormat getNotifPayloadFormat();
 
 public slots:
+    void reloadSettings();
     void QSOInserted(const QSqlRecord &);
     void QSOUpdated(const QSqlRecord &);
     void QSODeleted(const QSqlRecord &);
@@ -142,14 +168,43 @@ public slots:
     void WSJTXCQSpot(const WsjtxEntry&);
     void spotAlert(const SpotAlert&);
 
+private slots:
+    void flushBatches();
+
 private:
+    enum Channel
+    {
+        QSO_CHANNEL,
+        DXSPOT_CHANNEL,
+        WSJTXCQSPOT_CHANNEL,
+        SPOTALERT_CHANNEL,
+        CHANNEL_COUNT
+    };
+
+    struct ChannelState
+    {
+        UdpForwarder *forwarder = nullptr;
+        QList<QJsonObject> batch;
+        quint64 queued = 0;
+        quint64 dropped = 0;
+    };
+
+    bool hasDestinations(Channel) const;
+    void send(const GenericNotificationMsg &, Channel, bool batchable = false);
+    QByteArray serialize(const GenericNotificationMsg &) const;
+    void logStats() const;
 
-    void send(const QByteArray &, const HostsPortString &);
+    QVector<ChannelState> channels;
+    QTimer *batchTimer;
+    int batchWindow;
+    PayloadFormat payloadFormat;
 
     static QString CONFIG_NOTIF_QSO_ADI_ADDRS_KEY;
     static QString CONFIG_NOTIF_DXSPOT_ADDRS_KEY;
     static QString CONFIG_NOTIF_WSJTXCQSPOT_ADDRS_KEY;
     static QString CONFIG_NOTIF_SPOTALERT_ADDRS_KEY;
+    static QString CONFIG_NOTIF_BATCH_WINDOW_KEY;
+    static QString CONFIG_NOTIF_PAYLOAD_FORMAT_KEY;
 
 };
 
@@ -12,6 +12,7 @@
 #include "core/CredentialStore.h"
 #include "logformat/AdiFormat.h"
 #include "core/Callsign.h"
+#include "core/UploadOutbox.h"
 
 #define API_URL "https://xmldata.qrz.com/xml/current/"
 #define API_LOGBOOK_URL "https://logbook.qrz.com/api"
@@ -73,7 +74,7 @@ void QRZ::queryCallsign(QString callsign)
         query.addQueryItem("callsign", callsign);
     }
 
-    QUrl url(API_URL);
+    QUrl url(getAPIURL(QRZ::CALLBOOK_NAME, API_URL));
     url.setQuery(query);
 
     if ( currentReply )
@@ -130,7 +131,7 @@ void QRZ::actionInsert(QByteArray& data, const QString &insertPolicy)
     params.addQueryItem("OPTION", insertPolicy);
     params.addQueryItem("ADIF", data.trimmed().toPercentEncoding());
 
-    QUrl url(API_LOGBOOK_URL);
+    QUrl url(UploadOutbox::uploadURL("qrzcom", API_LOGBOOK_URL));
 
     QNetworkRequest request(url);
 
@@ -266,7 +267,7 @@ void QRZ::authenticate()
         query.addQueryItem("password", password);
         query.addQueryItem("agent", "QLog");
 
-        QUrl url(API_URL);
+        QUrl url(getAPIURL(QRZ::CALLBOOK_NAME, API_URL));
         url.setQuery(query);
 
         if ( currentReply )
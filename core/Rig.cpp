@@ -21,6 +21,10 @@ MODULE_IDENTIFICATION("qlog.core.rig");
 #define STARTING_UPDATE_INTERVAL 500
 #define SLOW_UPDATE_INTERVAL 2000
 
+/* an idle attribute backs off up to <factor> * pollInterval */
+#define IDLE_POLL_FAST_FACTOR 2
+#define IDLE_POLL_MAX_FACTOR 8
+
 Rig* Rig::instance() {
     FCT_IDENTIFICATION;
 
@@ -168,403 +172,613 @@ void Rig::update()
         return;
     }
 
-    /***********/
-    /* Get PTT */
-    /***********/
-    if ( connectedRigProfile.getPTTInfo
-         && rig->caps->get_ptt
-         && ( rig->caps->ptt_type == RIG_PTT_RIG
-              || rig->caps->ptt_type == RIG_PTT_RIG_MICDATA)
-        )
+    /* attributes reported by the rig's transceive notifications are polled immediately */
+    const int notifications = pendingNotifications.fetchAndStoreOrdered(0);
+    const qint64 now = pollClock.elapsed();
+    bool yielded = false;
+
+    for ( int i = 0; i < ATTR_COUNT; i++ )
     {
-        ptt_t pttHamlib;
+        /* Set commands have a higher priority than polling.
+         * The remaining attributes are polled in the next round */
+        if ( pendingSetCommands.loadAcquire() > 0
+             && !forceSendState )
+        {
+            qCDebug(runtime) << "Set Command is pending - postponing the poll";
+            yielded = true;
+            break;
+        }
 
-        int status = rig_get_ptt(rig, RIG_VFO_CURR, &pttHamlib);
+        AttributePoll &attributePoll = attributePolls[i];
+        const bool notified = ( notifications & (1 << i) );
 
-        if ( status == RIG_OK )
+        if ( !forceSendState
+             && !notified
+             && attributePoll.nextPoll > now )
         {
-            bool ptt = ( pttHamlib == RIG_PTT_OFF ) ? false : true;
+            continue;
+        }
 
-            qCDebug(runtime) << "Current PTT state: "<< ptt;
-            qCDebug(runtime) << "Current LO PTT state: "<< LoA.getPTT();
+        QElapsedTimer pollTimer;
+        pollTimer.start();
 
-            if ( ptt != LoA.getPTT()
-                 || forceSendState )
-            {
-                LoA.setPTT(ptt);
+        PollResult result = __pollAttribute(static_cast<RigAttribute>(i));
 
-                qCDebug(runtime) << "PTT changed - emitting: " << LoA.getPTT();
+        if ( result == POLL_ERROR )
+        {
+            timer->start(STARTING_UPDATE_INTERVAL);
+            rigLock.unlock();
+            forceSendState = false;
+            return;
+        }
 
-                emit pttChanged(LoA.getID(), LoA.getPTT());
+        if ( result == POLL_DISABLED )
+        {
+            continue;
+        }
+
+        const qint64 pollTime = pollTimer.nsecsElapsed() / 1000;
+
+        attributePoll.stats.polls++;
+        attributePoll.stats.totalTime += pollTime;
+        attributePoll.stats.maxTime = qMax(attributePoll.stats.maxTime, pollTime);
+
+        /* a changed attribute is polled with the profile's interval,
+         * an idle attribute backs off up to its maximal interval */
+        if ( result == POLL_CHANGED || notified )
+        {
+            if ( result == POLL_CHANGED )
+            {
+                attributePoll.stats.changes++;
             }
+            attributePoll.interval = connectedRigProfile.pollInterval;
         }
         else
         {
-            /* Ignore error */
-            /*
-        __closeRig();
-        emit rigErrorPresent(QString(tr("Get Level Error - ")) + QString(rigerror(status)));
-        */
+            attributePoll.interval = qMin(attributePoll.interval * 2,
+                                          __maxPollInterval(static_cast<RigAttribute>(i)));
         }
+
+        attributePoll.nextPoll = now + attributePoll.interval;
     }
-    else
+
+    timer->start(( yielded ) ? 0 : connectedRigProfile.pollInterval);
+    rigLock.unlock();
+    forceSendState = false;
+}
+
+Rig::PollResult Rig::__pollAttribute(RigAttribute attribute)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << attribute;
+
+    switch ( attribute )
     {
-        qCDebug(runtime) << "Get PTT is disabled";
+    case ATTR_PTT: return __pollPTT();
+    case ATTR_FREQ: return __pollFreq();
+    case ATTR_MODE: return __pollMode();
+    case ATTR_VFO: return __pollVFO();
+    case ATTR_POWER: return __pollPower();
+    case ATTR_RIT: return __pollRIT();
+    case ATTR_XIT: return __pollXIT();
+    case ATTR_KEYSPEED: return __pollKeySpeed();
+    case ATTR_COUNT: break;
     }
 
+    return POLL_DISABLED;
+}
+
+int Rig::__maxPollInterval(RigAttribute attribute) const
+{
+    FCT_IDENTIFICATION;
+
+    int factor = IDLE_POLL_MAX_FACTOR;
 
-    /************/
-    /* Get Freq */
-    /************/
-    if ( connectedRigProfile.getFreqInfo
-         && rig->caps->get_freq )
+    switch ( attribute )
     {
-        freq_t vfo_freq;
-        int status = rig_get_freq(rig, RIG_VFO_CURR, &vfo_freq);
+    case ATTR_FREQ:
+        /* QSY must be visible immediately - the frequency is not backed off */
+        factor = 1;
+        break;
+    case ATTR_PTT:
+    case ATTR_MODE:
+        /* the rig notifies PTT and mode changes itself; polling is only a safety net */
+        factor = ( transceiveEnabled ) ? IDLE_POLL_MAX_FACTOR : IDLE_POLL_FAST_FACTOR;
+        break;
+    default:
+        break;
+    }
 
-        if ( status == RIG_OK )
-        {
-            qCDebug(runtime) << "Current RIG raw FREQ: "<< QSTRING_FREQ(Hz2MHz(vfo_freq));
-            qCDebug(runtime) << "Current LO raw FREQ: "<< QSTRING_FREQ(Hz2MHz(LoA.getFreq()));
+    return connectedRigProfile.pollInterval * factor;
+}
 
-            if ( vfo_freq != LoA.getFreq()
-                 || forceSendState )
-            {
-                LoA.setFreq(vfo_freq);
-
-                qCDebug(runtime) << "FREQ changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getFreq()))
-                                                                << QSTRING_FREQ(Hz2MHz(LoA.getRITFreq()))
-                                                                << QSTRING_FREQ(Hz2MHz(LoA.getXITFreq()));
-                emit frequencyChanged(LoA.getID(),
-                                      Hz2MHz(LoA.getFreq()),
-                                      Hz2MHz(LoA.getRITFreq()),
-                                      Hz2MHz(LoA.getXITFreq()));
-            }
-        }
-        else
+void Rig::__pollSoon(RigAttribute attribute)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << attribute;
+
+    attributePolls[attribute].interval = connectedRigProfile.pollInterval;
+    attributePolls[attribute].nextPoll = 0;
+}
+
+void Rig::__resetPollState()
+{
+    FCT_IDENTIFICATION;
+
+    for ( AttributePoll &attributePoll : attributePolls )
+    {
+        attributePoll = AttributePoll();
+        attributePoll.interval = connectedRigProfile.pollInterval;
+    }
+
+    pendingNotifications.storeRelease(0);
+    pollClock.start();
+}
+
+QMap<QString, RigPollStats> Rig::pollStats()
+{
+    FCT_IDENTIFICATION;
+
+    QMutexLocker locker(&rigLock);
+    return __pollStats();
+}
+
+QMap<QString, RigPollStats> Rig::__pollStats() const
+{
+    FCT_IDENTIFICATION;
+
+    static const char *attributeNames[ATTR_COUNT] = {"PTT", "FREQ", "MODE", "VFO",
+                                                     "PWR", "RIT", "XIT", "KEYSPEED"};
+
+    QMap<QString, RigPollStats> ret;
+
+    for ( int i = 0; i < ATTR_COUNT; i++ )
+    {
+        if ( attributePolls[i].stats.polls > 0 )
         {
-            __closeRig();
-            emit rigErrorPresent(tr("Get Frequency Error"),
-                                 hamlibErrorString(status));
-            timer->start(STARTING_UPDATE_INTERVAL);
-            rigLock.unlock();
-            forceSendState = false;
-            return;
+            ret.insert(attributeNames[i], attributePolls[i].stats);
         }
     }
-    else
+
+    return ret;
+}
+
+void Rig::__logPollStats()
+{
+    FCT_IDENTIFICATION;
+
+    const QMap<QString, RigPollStats> stats = __pollStats();
+
+    for ( auto it = stats.cbegin(); it != stats.cend(); ++it )
     {
-        qCDebug(runtime) << "Get Freq is disabled";
+        qCDebug(runtime) << it.key() << it.value();
     }
+}
 
-    /************/
-    /* Get Mode */
-    /************/
-    if ( connectedRigProfile.getModeInfo
-         && rig->caps->get_mode )
+void Rig::__finishSetCommand()
+{
+    FCT_IDENTIFICATION;
+
+    /* the counter is reset when the rig is closed - a command queued before
+     * must not make it negative */
+    int pending = pendingSetCommands.loadAcquire();
+
+    while ( pending > 0
+            && !pendingSetCommands.testAndSetOrdered(pending, pending - 1, pending) )
     {
-        pbwidth_t pbwidth;
-        rmode_t curr_modeId;
+    }
+}
 
-        int status = rig_get_mode(rig, RIG_VFO_CURR, &curr_modeId, &pbwidth);
+int Rig::freqEventCallback(RIG *, vfo_t, freq_t, rig_ptr_t arg)
+{
+    static_cast<Rig*>(arg)->pendingNotifications.fetchAndOrOrdered(1 << ATTR_FREQ);
+    return RIG_OK;
+}
 
-        if ( status == RIG_OK )
-        {
-            qCDebug(runtime) << "Current RIG raw MODE: "<< curr_modeId;
-            qCDebug(runtime) << "Current LO raw MODE: "<< LoA.getMode();
+int Rig::modeEventCallback(RIG *, vfo_t, rmode_t, pbwidth_t, rig_ptr_t arg)
+{
+    static_cast<Rig*>(arg)->pendingNotifications.fetchAndOrOrdered(1 << ATTR_MODE);
+    return RIG_OK;
+}
 
-            if ( curr_modeId != LoA.getMode()
-                 || ( pbwidth != RIG_PASSBAND_NOCHANGE
-                      && pbwidth != LoA.getPassbandWidth() )
-                 || forceSendState )
-            {
-                // mode change
-                LoA.setMode(curr_modeId);
-                LoA.setPassbandWidth(pbwidth);
-
-                QString submode;
-                QString mode = LoA.getModeNormalizedText(submode);
-
-                qCDebug(runtime) << "MODE changed - emitting: " << LoA.getModeText() << mode << submode;
-                emit modeChanged(LoA.getID(),
-                                 LoA.getModeText(),
-                                 mode, submode,
-                                 LoA.getPassbandWidth());
-            }
-        }
-        else
-        {
-            __closeRig();
-            emit rigErrorPresent(tr("Get Mode Error"),
-                                 hamlibErrorString(status));
-            timer->start(STARTING_UPDATE_INTERVAL);
-            rigLock.unlock();
-            forceSendState = false;
-            return;
-        }
+int Rig::vfoEventCallback(RIG *, vfo_t, rig_ptr_t arg)
+{
+    static_cast<Rig*>(arg)->pendingNotifications.fetchAndOrOrdered(1 << ATTR_VFO);
+    return RIG_OK;
+}
+
+int Rig::pttEventCallback(RIG *, vfo_t, ptt_t, rig_ptr_t arg)
+{
+    static_cast<Rig*>(arg)->pendingNotifications.fetchAndOrOrdered(1 << ATTR_PTT);
+    return RIG_OK;
+}
+
+Rig::PollResult Rig::__pollPTT()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !connectedRigProfile.getPTTInfo
+         || !rig->caps->get_ptt
+         || ( rig->caps->ptt_type != RIG_PTT_RIG
+              && rig->caps->ptt_type != RIG_PTT_RIG_MICDATA) )
+    {
+        qCDebug(runtime) << "Get PTT is disabled";
+        return POLL_DISABLED;
     }
-    else
+
+    ptt_t pttHamlib;
+
+    int status = rig_get_ptt(rig, RIG_VFO_CURR, &pttHamlib);
+
+    if ( status != RIG_OK )
     {
-        qCDebug(runtime) << "Get Mode is disabled";
+        /* Ignore error */
+        return POLL_UNCHANGED;
     }
 
-    /************/
-    /* Get VFO  */
-    /************/
-    if ( connectedRigProfile.getVFOInfo
-         && rig->caps->get_vfo )
+    bool ptt = ( pttHamlib == RIG_PTT_OFF ) ? false : true;
+
+    qCDebug(runtime) << "Current PTT state: "<< ptt;
+    qCDebug(runtime) << "Current LO PTT state: "<< LoA.getPTT();
+
+    if ( ptt == LoA.getPTT()
+         && !forceSendState )
     {
-        vfo_t curr_vfo;
+        return POLL_UNCHANGED;
+    }
 
-        int status = rig_get_vfo(rig, &curr_vfo);
+    LoA.setPTT(ptt);
 
-        if ( status == RIG_OK )
-        {
-            qCDebug(runtime) << "Current RIG raw VFO: "<< curr_vfo;
-            qCDebug(runtime) << "Current LO raw VFO: "<< LoA.getVFO();
+    qCDebug(runtime) << "PTT changed - emitting: " << LoA.getPTT();
 
-            if ( curr_vfo != LoA.getVFO()
-                 || forceSendState )
-            {
-                LoA.setVFO(curr_vfo);
+    emit pttChanged(LoA.getID(), LoA.getPTT());
 
-                qCDebug(runtime) << "VFO changed - emitting: " << LoA.getVFOText();
+    return POLL_CHANGED;
+}
 
-                emit vfoChanged(LoA.getID(), LoA.getVFOText());
-            }
-        }
-        else
-        {
-            /* Ignore error */
-            /*
+Rig::PollResult Rig::__pollFreq()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !connectedRigProfile.getFreqInfo
+         || !rig->caps->get_freq )
+    {
+        qCDebug(runtime) << "Get Freq is disabled";
+        return POLL_DISABLED;
+    }
+
+    freq_t vfo_freq;
+    int status = rig_get_freq(rig, RIG_VFO_CURR, &vfo_freq);
+
+    if ( status != RIG_OK )
+    {
         __closeRig();
-        emit rigErrorPresent(QString(tr("Get Level Error - ")) + QString(rigerror(status)));
-        */
-        }
+        emit rigErrorPresent(tr("Get Frequency Error"),
+                             hamlibErrorString(status));
+        return POLL_ERROR;
     }
-    else
+
+    qCDebug(runtime) << "Current RIG raw FREQ: "<< QSTRING_FREQ(Hz2MHz(vfo_freq));
+    qCDebug(runtime) << "Current LO raw FREQ: "<< QSTRING_FREQ(Hz2MHz(LoA.getFreq()));
+
+    if ( vfo_freq == LoA.getFreq()
+         && !forceSendState )
     {
-        qCDebug(runtime) << "Get VFO is disabled";
+        return POLL_UNCHANGED;
     }
-    /************/
-    /* Get PWR  */
-    /************/
 
-    if ( connectedRigProfile.getPWRInfo
-         && rig_has_get_level(rig, RIG_LEVEL_RFPOWER)
-         && rig->caps->power2mW )
+    LoA.setFreq(vfo_freq);
+
+    qCDebug(runtime) << "FREQ changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getFreq()))
+                                                    << QSTRING_FREQ(Hz2MHz(LoA.getRITFreq()))
+                                                    << QSTRING_FREQ(Hz2MHz(LoA.getXITFreq()));
+    emit frequencyChanged(LoA.getID(),
+                          Hz2MHz(LoA.getFreq()),
+                          Hz2MHz(LoA.getRITFreq()),
+                          Hz2MHz(LoA.getXITFreq()));
+
+    return POLL_CHANGED;
+}
+
+Rig::PollResult Rig::__pollMode()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !connectedRigProfile.getModeInfo
+         || !rig->caps->get_mode )
     {
-        value_t rigPowerLevel;
-        unsigned int rigPower;
+        qCDebug(runtime) << "Get Mode is disabled";
+        return POLL_DISABLED;
+    }
 
-        int status = rig_get_level(rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER, &rigPowerLevel);
+    pbwidth_t pbwidth;
+    rmode_t curr_modeId;
 
-        if ( status == RIG_OK )
-        {
-            status = rig_power2mW(rig, &rigPower, rigPowerLevel.f, LoA.getFreq(), LoA.getMode());
+    int status = rig_get_mode(rig, RIG_VFO_CURR, &curr_modeId, &pbwidth);
 
-            if (  status == RIG_OK )
-            {
-                qCDebug(runtime) << "Current RIG raw PWR: "<< rigPower;
-                qCDebug(runtime) << "Current LO raw PWR: "<< LoA.getPower();
-
-                if ( rigPower != LoA.getPower()
-                     || forceSendState )
-                {
-                    LoA.setPower(rigPower);
-
-                    qCDebug(runtime) << "PWR changed - emitting: " << mW2W(LoA.getPower());
-
-                    emit powerChanged(LoA.getID(), mW2W(LoA.getPower()));
-                }
-                else
-                {
-                    /* Ignore error */
-                    /*
-            __closeRig();
-            emit rigErrorPresent(QString(tr("Get Power Error - ")) + QString(rigerror(status)));
-            */
-                }
-            }
-        }
-        else
-        {
-            /* Ignore error */
-            /*
+    if ( status != RIG_OK )
+    {
         __closeRig();
-        emit rigErrorPresent(QString(tr("Get Level Error - ")) + QString(rigerror(status)));
-        */
-        }
+        emit rigErrorPresent(tr("Get Mode Error"),
+                             hamlibErrorString(status));
+        return POLL_ERROR;
     }
-    else
+
+    qCDebug(runtime) << "Current RIG raw MODE: "<< curr_modeId;
+    qCDebug(runtime) << "Current LO raw MODE: "<< LoA.getMode();
+
+    if ( curr_modeId == LoA.getMode()
+         && ( pbwidth == RIG_PASSBAND_NOCHANGE
+              || pbwidth == LoA.getPassbandWidth() )
+         && !forceSendState )
     {
-        qCDebug(runtime) << "Get PWR is disabled";
+        return POLL_UNCHANGED;
     }
 
-    /************/
-    /* Get RIT  */
-    /************/
-    if ( connectedRigProfile.getRITInfo
-         && rig->caps->get_rit
-         && rig_has_get_func(rig, RIG_FUNC_RIT) )
+    // mode change
+    LoA.setMode(curr_modeId);
+    LoA.setPassbandWidth(pbwidth);
+
+    QString submode;
+    QString mode = LoA.getModeNormalizedText(submode);
+
+    qCDebug(runtime) << "MODE changed - emitting: " << LoA.getModeText() << mode << submode;
+    emit modeChanged(LoA.getID(),
+                     LoA.getModeText(),
+                     mode, submode,
+                     LoA.getPassbandWidth());
+
+    return POLL_CHANGED;
+}
+
+Rig::PollResult Rig::__pollVFO()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !connectedRigProfile.getVFOInfo
+         || !rig->caps->get_vfo )
     {
-        int ritStatus;
-        shortfreq_t rit = s_Hz(0);
+        qCDebug(runtime) << "Get VFO is disabled";
+        return POLL_DISABLED;
+    }
 
-        if ( rig_get_func(rig, RIG_VFO_CURR, RIG_FUNC_RIT, &ritStatus) == RIG_OK )
-        {
-            if ( ritStatus )
-            {
-                /* RIT is on */
-                if ( rig_get_rit(rig, RIG_VFO_CURR, &rit) != RIG_OK )
-                {
-                    qWarning() << "Cannot get RIT";
-                    rit = s_Hz(0);
-                }
-            }
-            else
-            {
-                /* RIT is off */
-                rit = s_Hz(0);
-            }
+    vfo_t curr_vfo;
 
-            qCDebug(runtime) << "Current RIG raw RIT: "<< rit;
-            qCDebug(runtime) << "Current LO raw RIT: "<< LoA.getRXOffset();
-            qCDebug(runtime) << "Current RIG RIT State: " << ritStatus;
+    int status = rig_get_vfo(rig, &curr_vfo);
 
-            if ( static_cast<double>(rit) != LoA.getRXOffset()
-                 || forceSendState )
-            {
-                LoA.setRXOffset(rit);
-
-                qCDebug(runtime) << "RIT changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getRXOffset()));
-                qCDebug(runtime) << "FREQ changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getFreq()))
-                                                                << QSTRING_FREQ(Hz2MHz(LoA.getRITFreq()))
-                                                                << QSTRING_FREQ(Hz2MHz(LoA.getXITFreq()));
-
-                emit ritChanged(LoA.getID(), Hz2MHz(LoA.getRXOffset()));
-                emit frequencyChanged(LoA.getID(),
-                                      Hz2MHz(LoA.getFreq()),
-                                      Hz2MHz(LoA.getRITFreq()),
-                                      Hz2MHz(LoA.getXITFreq()));
-            }
-        }
-        else
-        {
-            qWarning() << "Cannot get RIG function RIG_FUNC_RIT";
-        }
+    if ( status != RIG_OK )
+    {
+        /* Ignore error */
+        return POLL_UNCHANGED;
     }
-    else
+
+    qCDebug(runtime) << "Current RIG raw VFO: "<< curr_vfo;
+    qCDebug(runtime) << "Current LO raw VFO: "<< LoA.getVFO();
+
+    if ( curr_vfo == LoA.getVFO()
+         && !forceSendState )
     {
-        qCDebug(runtime) << "Get RIT is disabled";
+        return POLL_UNCHANGED;
     }
 
-    /************/
-    /* Get XIT  */
-    /************/
+    LoA.setVFO(curr_vfo);
+
+    qCDebug(runtime) << "VFO changed - emitting: " << LoA.getVFOText();
+
+    emit vfoChanged(LoA.getID(), LoA.getVFOText());
+
+    return POLL_CHANGED;
+}
+
+Rig::PollResult Rig::__pollPower()
+{
+    FCT_IDENTIFICATION;
 
-    if ( connectedRigProfile.getXITInfo
-         && rig->caps->get_xit
-         && rig_has_get_func(rig, RIG_FUNC_XIT) )
+    if ( !connectedRigProfile.getPWRInfo
+         || !rig_has_get_level(rig, RIG_LEVEL_RFPOWER)
+         || !rig->caps->power2mW )
     {
-        int xitStatus;
-        shortfreq_t xit = s_Hz(0);
+        qCDebug(runtime) << "Get PWR is disabled";
+        return POLL_DISABLED;
+    }
 
-        if ( rig_get_func(rig, RIG_VFO_CURR, RIG_FUNC_XIT, &xitStatus) == RIG_OK )
-        {
-            if ( xitStatus )
-            {
-                /* XIT is on */
-                if ( rig_get_xit(rig, RIG_VFO_CURR, &xit) != RIG_OK )
-                {
-                    qWarning() << "Cannot get XIT";
-                    xit = s_Hz(0);
-                }
-            }
-            else
-            {
-                /* XIT is off */
-                xit = s_Hz(0);
-            }
+    value_t rigPowerLevel;
+    unsigned int rigPower;
 
-            qCDebug(runtime) << "Current RIG raw XIT: "<< xit;
-            qCDebug(runtime) << "Current LO raw XIT: "<< LoA.getTXOffset();
-            qCDebug(runtime) << "Current RIG XIT State: " << xitStatus;
+    int status = rig_get_level(rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER, &rigPowerLevel);
 
-            if ( static_cast<double>(xit) != LoA.getTXOffset()
-                 || forceSendState )
-            {
-                LoA.setTXOffset(xit);
-
-                qCDebug(runtime) << "XIT changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getTXOffset()));
-                qCDebug(runtime) << "FREQ changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getFreq()))
-                                                                << QSTRING_FREQ(Hz2MHz(LoA.getRITFreq()))
-                                                                << QSTRING_FREQ(Hz2MHz(LoA.getXITFreq()));
-
-                emit xitChanged(LoA.getID(), Hz2MHz(LoA.getTXOffset()));
-                emit frequencyChanged(LoA.getID(),
-                                      Hz2MHz(LoA.getFreq()),
-                                      Hz2MHz(LoA.getRITFreq()),
-                                      Hz2MHz(LoA.getXITFreq()));
-            }
-        }
-        else
+    if ( status != RIG_OK )
+    {
+        /* Ignore error */
+        return POLL_UNCHANGED;
+    }
+
+    status = rig_power2mW(rig, &rigPower, rigPowerLevel.f, LoA.getFreq(), LoA.getMode());
+
+    if ( status != RIG_OK )
+    {
+        /* Ignore error */
+        return POLL_UNCHANGED;
+    }
+
+    qCDebug(runtime) << "Current RIG raw PWR: "<< rigPower;
+    qCDebug(runtime) << "Current LO raw PWR: "<< LoA.getPower();
+
+    if ( rigPower == LoA.getPower()
+         && !forceSendState )
+    {
+        return POLL_UNCHANGED;
+    }
+
+    LoA.setPower(rigPower);
+
+    qCDebug(runtime) << "PWR changed - emitting: " << mW2W(LoA.getPower());
+
+    emit powerChanged(LoA.getID(), mW2W(LoA.getPower()));
+
+    return POLL_CHANGED;
+}
+
+Rig::PollResult Rig::__pollRIT()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !connectedRigProfile.getRITInfo
+         || !rig->caps->get_rit
+         || !rig_has_get_func(rig, RIG_FUNC_RIT) )
+    {
+        qCDebug(runtime) << "Get RIT is disabled";
+        return POLL_DISABLED;
+    }
+
+    int ritStatus;
+    shortfreq_t rit = s_Hz(0);
+
+    if ( rig_get_func(rig, RIG_VFO_CURR, RIG_FUNC_RIT, &ritStatus) != RIG_OK )
+    {
+        qWarning() << "Cannot get RIG function RIG_FUNC_RIT";
+        return POLL_UNCHANGED;
+    }
+
+    if ( ritStatus )
+    {
+        /* RIT is on */
+        if ( rig_get_rit(rig, RIG_VFO_CURR, &rit) != RIG_OK )
         {
-            qWarning() << "Cannot get RIG function RIG_FUNC_XIT";
+            qWarning() << "Cannot get RIT";
+            rit = s_Hz(0);
         }
     }
     else
     {
-        qCDebug(runtime) << "Get XIT is disabled";
+        /* RIT is off */
+        rit = s_Hz(0);
     }
 
-    /*****************/
-    /* Get KeySpeed  */
-    /*****************/
-    if ( connectedRigProfile.getKeySpeed
-         && rig_has_get_level(rig, RIG_LEVEL_KEYSPD) )
+    qCDebug(runtime) << "Current RIG raw RIT: "<< rit;
+    qCDebug(runtime) << "Current LO raw RIT: "<< LoA.getRXOffset();
+    qCDebug(runtime) << "Current RIG RIT State: " << ritStatus;
+
+    if ( static_cast<double>(rit) == LoA.getRXOffset()
+         && !forceSendState )
     {
-        value_t rigKeySpeed;
+        return POLL_UNCHANGED;
+    }
 
-        int status = rig_get_level(rig, RIG_VFO_CURR, RIG_LEVEL_KEYSPD, &rigKeySpeed);
+    LoA.setRXOffset(rit);
 
-        if ( status == RIG_OK )
-        {
-            qCDebug(runtime) << "Current RIG Key Speed: "<< rigKeySpeed.i;
-            qCDebug(runtime) << "Current LO Key Speed: "<< LoA.getKeySpeed();
+    qCDebug(runtime) << "RIT changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getRXOffset()));
+    qCDebug(runtime) << "FREQ changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getFreq()))
+                                                    << QSTRING_FREQ(Hz2MHz(LoA.getRITFreq()))
+                                                    << QSTRING_FREQ(Hz2MHz(LoA.getXITFreq()));
 
-            if ( static_cast<unsigned int>(rigKeySpeed.i) != LoA.getKeySpeed()
-                 || forceSendState )
-            {
-                LoA.setKeySpeed(static_cast<unsigned int>(rigKeySpeed.i));
-                emit keySpeedChanged(LoA.getID(), LoA.getKeySpeed());
-            }
-            else
-            {
-                /* Ignore error */
-                /*
-            __closeRig();
-            emit rigErrorPresent(QString(tr("Get Power Error - ")) + QString(rigerror(status)));
-            */
-            }
-        }
-        else
+    emit ritChanged(LoA.getID(), Hz2MHz(LoA.getRXOffset()));
+    emit frequencyChanged(LoA.getID(),
+                          Hz2MHz(LoA.getFreq()),
+                          Hz2MHz(LoA.getRITFreq()),
+                          Hz2MHz(LoA.getXITFreq()));
+
+    return POLL_CHANGED;
+}
+
+Rig::PollResult Rig::__pollXIT()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !connectedRigProfile.getXITInfo
+         || !rig->caps->get_xit
+         || !rig_has_get_func(rig, RIG_FUNC_XIT) )
+    {
+        qCDebug(runtime) << "Get XIT is disabled";
+        return POLL_DISABLED;
+    }
+
+    int xitStatus;
+    shortfreq_t xit = s_Hz(0);
+
+    if ( rig_get_func(rig, RIG_VFO_CURR, RIG_FUNC_XIT, &xitStatus) != RIG_OK )
+    {
+        qWarning() << "Cannot get RIG function RIG_FUNC_XIT";
+        return POLL_UNCHANGED;
+    }
+
+    if ( xitStatus )
+    {
+        /* XIT is on */
+        if ( rig_get_xit(rig, RIG_VFO_CURR, &xit) != RIG_OK )
         {
-            /* Ignore error */
-            /*
-        __closeRig();
-        emit rigErrorPresent(QString(tr("Get Level Error - ")) + QString(rigerror(status)));
-        */
+            qWarning() << "Cannot get XIT";
+            xit = s_Hz(0);
         }
     }
     else
+    {
+        /* XIT is off */
+        xit = s_Hz(0);
+    }
+
+    qCDebug(runtime) << "Current RIG raw XIT: "<< xit;
+    qCDebug(runtime) << "Current LO raw XIT: "<< LoA.getTXOffset();
+    qCDebug(runtime) << "Current RIG XIT State: " << xitStatus;
+
+    if ( static_cast<double>(xit) == LoA.getTXOffset()
+         && !forceSendState )
+    {
+        return POLL_UNCHANGED;
+    }
+
+    LoA.setTXOffset(xit);
+
+    qCDebug(runtime) << "XIT changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getTXOffset()));
+    qCDebug(runtime) << "FREQ changed - emitting: " << QSTRING_FREQ(Hz2MHz(LoA.getFreq()))
+                                                    << QSTRING_FREQ(Hz2MHz(LoA.getRITFreq()))
+                                                    << QSTRING_FREQ(Hz2MHz(LoA.getXITFreq()));
+
+    emit xitChanged(LoA.getID(), Hz2MHz(LoA.getTXOffset()));
+    emit frequencyChanged(LoA.getID(),
+                          Hz2MHz(LoA.getFreq()),
+                          Hz2MHz(LoA.getRITFreq()),
+                          Hz2MHz(LoA.getXITFreq()));
+
+    return POLL_CHANGED;
+}
+
+Rig::PollResult Rig::__pollKeySpeed()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !connectedRigProfile.getKeySpeed
+         || !rig_has_get_level(rig, RIG_LEVEL_KEYSPD) )
     {
         qCDebug(runtime) << "Get KeySpeed is disabled";
+        return POLL_DISABLED;
     }
 
-    timer->start(connectedRigProfile.pollInterval);
-    rigLock.unlock();
-    forceSendState = false;
+    value_t rigKeySpeed;
+
+    int status = rig_get_level(rig, RIG_VFO_CURR, RIG_LEVEL_KEYSPD, &rigKeySpeed);
+
+    if ( status != RIG_OK )
+    {
+        /* Ignore error */
+        return POLL_UNCHANGED;
+    }
+
+    qCDebug(runtime) << "Current RIG Key Speed: "<< rigKeySpeed.i;
+    qCDebug(runtime) << "Current LO Key Speed: "<< LoA.getKeySpeed();
+
+    if ( static_cast<unsigned int>(rigKeySpeed.i) == LoA.getKeySpeed()
+         && !forceSendState )
+    {
+        return POLL_UNCHANGED;
+    }
+
+    LoA.setKeySpeed(static_cast<unsigned int>(rigKeySpeed.i));
+    emit keySpeedChanged(LoA.getID(), LoA.getKeySpeed());
+
+    return POLL_CHANGED;
 }
 
 void Rig::open()
@@ -597,6 +811,9 @@ void Rig::closeImpl()
     rigLock.lock();
     __closeRig();
     rigLock.unlock();
+
+    /* queued set commands are dropped by the closed rig, the poll must not wait for them */
+    pendingSetCommands.storeRelease(0);
 }
 
 void Rig::__closeRig()
@@ -610,6 +827,17 @@ void Rig::__closeRig()
         emit rigCWKeyCloseRequest(connectedRigProfile.assignedCWKey);
     }
 
+    if ( rig )
+    {
+        __logPollStats();
+
+        if ( transceiveEnabled )
+        {
+            rig_set_trn(rig, RIG_TRN_OFF);
+            transceiveEnabled = false;
+        }
+    }
+
     connectedRigProfile = RigProfile();
     LoA.clear();
 
@@ -685,6 +913,24 @@ void Rig::__openRig()
     LoA.setRXOffset(MHz(connectedRigProfile.ritOffset));
     LoA.setTXOffset(MHz(connectedRigProfile.xitOffset));
 
+    __resetPollState();
+
+    /* If the rig reports its changes itself (transceive mode), then the rig state
+     * is not needed to poll so often. Callbacks can be called from Hamlib's
+     * async context therefore they only mark the attribute and the next update()
+     * polls it */
+    if ( rig->caps->transceive == RIG_TRN_RIG )
+    {
+        rig_set_freq_callback(rig, &Rig::freqEventCallback, this);
+        rig_set_mode_callback(rig, &Rig::modeEventCallback, this);
+        rig_set_vfo_callback(rig, &Rig::vfoEventCallback, this);
+        rig_set_ptt_callback(rig, &Rig::pttEventCallback, this);
+
+        transceiveEnabled = ( rig_set_trn(rig, RIG_TRN_RIG) == RIG_OK );
+    }
+
+    qCDebug(runtime) << "Transceive mode:" << transceiveEnabled;
+
     emit rigConnected();
 
     // Change Assigned CW Key
@@ -752,8 +998,14 @@ void Rig::setFrequency(double newFreq)
 
     if ( newFreq > 0.0 )
     {
-        QMetaObject::invokeMethod(this, "setFrequencyImpl", Qt::QueuedConnection,
-                                  Q_ARG(double,newFreq));
+        pendingSetCommands.ref();
+
+        if ( !QMetaObject::invokeMethod(this, "setFrequencyImpl", Qt::QueuedConnection,
+                                        Q_ARG(double,newFreq)) )
+        {
+            qWarning() << "Cannot queue setFrequencyImpl";
+            __finishSetCommand();
+        }
     }
 }
 
@@ -761,6 +1013,8 @@ void Rig::setFrequencyImpl(double newFreq)
 {
     FCT_IDENTIFICATION;
 
+    __finishSetCommand();
+
     qCDebug(function_parameters) << newFreq;
 
     if (!rig || !connectedRigProfile.getFreqInfo) return;
@@ -779,6 +1033,7 @@ void Rig::setFrequencyImpl(double newFreq)
         }
 
         /* It is not needed to call VFO set freq function here because Rig's Update function do it */
+        __pollSoon(ATTR_FREQ);
 
         // wait a moment because Rigs are slow and they are not possible to set and get
         // mode so quickly (get mode is called in the main thread's update() function
@@ -814,15 +1069,27 @@ void Rig::setMode(rmode_t newModeIDe)
 {
     FCT_IDENTIFICATION;
 
-    QMetaObject::invokeMethod(this, "setModeImpl", Qt::QueuedConnection,
-                              Q_ARG(rmode_t,newModeIDe));
+    pendingSetCommands.ref();
+
+    if ( !QMetaObject::invokeMethod(this, "setModeImpl", Qt::QueuedConnection,
+                                    Q_ARG(rmode_t,newModeIDe)) )
+    {
+        qWarning() << "Cannot queue setModeImpl";
+        __finishSetCommand();
+    }
 }
 
 void Rig::setPTT(bool active)
 {
     FCT_IDENTIFICATION;
-    QMetaObject::invokeMethod(this, "setPTTImpl", Qt::QueuedConnection,
-                              Q_ARG(bool, active));
+    pendingSetCommands.ref();
+
+    if ( !QMetaObject::invokeMethod(this, "setPTTImpl", Qt::QueuedConnection,
+                                    Q_ARG(bool, active)) )
+    {
+        qWarning() << "Cannot queue setPTTImpl";
+        __finishSetCommand();
+    }
 
 }
 
@@ -830,37 +1097,63 @@ void Rig::setKeySpeed(qint16 wpm)
 {
     FCT_IDENTIFICATION;
 
-    QMetaObject::invokeMethod(this, "setKeySpeedImpl", Qt::QueuedConnection,
-                              Q_ARG(qint16, wpm));
+    pendingSetCommands.ref();
+
+    if ( !QMetaObject::invokeMethod(this, "setKeySpeedImpl", Qt::QueuedConnection,
+                                    Q_ARG(qint16, wpm)) )
+    {
+        qWarning() << "Cannot queue setKeySpeedImpl";
+        __finishSetCommand();
+    }
 }
 
 void Rig::syncKeySpeed(qint16 wpm)
 {
     FCT_IDENTIFICATION;
 
-    QMetaObject::invokeMethod(this, "syncKeySpeedImpl", Qt::QueuedConnection,
-                              Q_ARG(qint16, wpm));
+    pendingSetCommands.ref();
+
+    if ( !QMetaObject::invokeMethod(this, "syncKeySpeedImpl", Qt::QueuedConnection,
+                                    Q_ARG(qint16, wpm)) )
+    {
+        qWarning() << "Cannot queue syncKeySpeedImpl";
+        __finishSetCommand();
+    }
 }
 
 void Rig::sendMorse(const QString &text)
 {
     FCT_IDENTIFICATION;
 
-    QMetaObject::invokeMethod(this, "sendMorseImpl", Qt::QueuedConnection,
-                              Q_ARG(QString, text));
+    pendingSetCommands.ref();
+
+    if ( !QMetaObject::invokeMethod(this, "sendMorseImpl", Qt::QueuedConnection,
+                                    Q_ARG(QString, text)) )
+    {
+        qWarning() << "Cannot queue sendMorseImpl";
+        __finishSetCommand();
+    }
 }
 
 void Rig::stopMorse()
 {
     FCT_IDENTIFICATION;
 
-    QMetaObject::invokeMethod(this, "stopMorseImpl", Qt::QueuedConnection);
+    pendingSetCommands.ref();
+
+    if ( !QMetaObject::invokeMethod(this, "stopMorseImpl", Qt::QueuedConnection) )
+    {
+        qWarning() << "Cannot queue stopMorseImpl";
+        __finishSetCommand();
+    }
 }
 
 void Rig::setModeImpl(rmode_t newModeID)
 {
     FCT_IDENTIFICATION;
 
+    __finishSetCommand();
+
     qCDebug(function_parameters)<<newModeID;
 
     if (!rig || !connectedRigProfile.getModeInfo) return;
@@ -884,6 +1177,7 @@ void Rig::setModeImpl(rmode_t newModeID)
         }
 
         /* It is not needed to call setMode here because Update function do it */
+        __pollSoon(ATTR_MODE);
 
         // wait a moment because Rigs are slow and they are not possible to set and get
         // mode so quickly (get mode is called in the main thread's update() function
@@ -900,6 +1194,8 @@ void Rig::setPTTImpl(bool active)
 {
     FCT_IDENTIFICATION;
 
+    __finishSetCommand();
+
     qCDebug(function_parameters) << active;
 
     if (!rig || !connectedRigProfile.getPTTInfo) return;
@@ -916,6 +1212,7 @@ void Rig::setPTTImpl(bool active)
     }
 
     /* It is not needed to call VFO set freq function here because Rig's Update function do it */
+    __pollSoon(ATTR_PTT);
 
     // wait a moment because Rigs are slow and they are not possible to set and get
     // mode so quickly (get mode is called in the main thread's update() function
@@ -943,6 +1240,8 @@ void Rig::setKeySpeedImpl(qint16 wpm)
 {
     FCT_IDENTIFICATION;
 
+    __finishSetCommand();
+
     qCDebug(function_parameters) << wpm;
 
     if ( !rig || !connectedRigProfile.getKeySpeed ) return;
@@ -956,6 +1255,8 @@ void Rig::syncKeySpeedImpl(qint16 wpm)
 {
     FCT_IDENTIFICATION;
 
+    __finishSetCommand();
+
     qCDebug(function_parameters) << wpm;
 
     if ( !rig || !connectedRigProfile.keySpeedSync ) return;
@@ -983,6 +1284,8 @@ void Rig::__setKeySpeed(qint16 wpm)
         qWarning() << "Cannot set Keyer Speed";
     }
 
+    __pollSoon(ATTR_KEYSPEED);
+
     // wait a moment because Rigs are slow and they are not possible to set and get
     // mode so quickly (get mode is called in the main thread's update() function
 #ifdef Q_OS_WIN
@@ -996,6 +1299,8 @@ void Rig::sendMorseImpl(const QString &text)
 {
     FCT_IDENTIFICATION;
 
+    __finishSetCommand();
+
     qCDebug(function_parameters) << text;
 
     if (!rig) return;
@@ -1020,6 +1325,8 @@ void Rig::stopMorseImpl()
 {
     FCT_IDENTIFICATION;
 
+    __finishSetCommand();
+
     if (!rig) return;
 
     rigLock.lock();
@@ -1084,7 +1391,8 @@ Rig::Rig(QObject *parent) :
     SerialPort(parent),
     LoA(VFO1, this),
     timer(nullptr),
-    forceSendState(false)
+    forceSendState(false),
+    transceiveEnabled(false)
 {
     FCT_IDENTIFICATION;
 
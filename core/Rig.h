@@ -78,6 +78,30 @@ private:
     unsigned int keySpeed;
 };
 
+/* Poll and latency statistics of one rig attribute */
+struct RigPollStats
+{
+    quint64 polls = 0;
+    quint64 changes = 0;
+    qint64 totalTime = 0;  // in us
+    qint64 maxTime = 0;    // in us
+
+    qint64 avgTime() const
+    {
+        return ( polls > 0 ) ? totalTime / static_cast<qint64>(polls) : 0;
+    }
+};
+
+inline QDebug operator<<(QDebug debug, const RigPollStats &stats)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << "RigPollStats(polls: " << stats.polls
+                    << ", changes: " << stats.changes
+                    << ", avg latency: " << stats.avgTime() << "us"
+                    << ", max latency: " << stats.maxTime << "us)";
+    return debug;
+}
+
 class Rig : public SerialPort
 {
     Q_OBJECT
@@ -88,6 +112,7 @@ public:
 
     bool isRigConnected();
     bool isMorseOverCatSupported();
+    QMap<QString, RigPollStats> pollStats();
 
 public slots:
     void start();
@@ -136,6 +161,35 @@ private slots:
     void stopMorseImpl();
 
 private:
+    enum RigAttribute
+    {
+        ATTR_PTT = 0,
+        ATTR_FREQ,
+        ATTR_MODE,
+        ATTR_VFO,
+        ATTR_POWER,
+        ATTR_RIT,
+        ATTR_XIT,
+        ATTR_KEYSPEED,
+        ATTR_COUNT
+    };
+
+    enum PollResult
+    {
+        POLL_DISABLED,
+        POLL_UNCHANGED,
+        POLL_CHANGED,
+        POLL_ERROR
+    };
+
+    /* Poll schedule and latency statistics of one rig attribute */
+    struct AttributePoll
+    {
+        qint64 nextPoll = 0;   // in ms (pollClock)
+        int interval = 0;      // in ms
+        RigPollStats stats;
+    };
+
     Rig(QObject *parent = nullptr);
     //Rig(Rig const&);
     ~Rig();
@@ -146,6 +200,27 @@ private:
     void __openRig();
     void __setKeySpeed(qint16 wpm);
 
+    PollResult __pollAttribute(RigAttribute attribute);
+    PollResult __pollPTT();
+    PollResult __pollFreq();
+    PollResult __pollMode();
+    PollResult __pollVFO();
+    PollResult __pollPower();
+    PollResult __pollRIT();
+    PollResult __pollXIT();
+    PollResult __pollKeySpeed();
+    int __maxPollInterval(RigAttribute attribute) const;
+    void __pollSoon(RigAttribute attribute);
+    void __resetPollState();
+    QMap<QString, RigPollStats> __pollStats() const;
+    void __logPollStats();
+    void __finishSetCommand();
+
+    static int freqEventCallback(RIG *, vfo_t, freq_t, rig_ptr_t arg);
+    static int modeEventCallback(RIG *, vfo_t, rmode_t, pbwidth_t, rig_ptr_t arg);
+    static int vfoEventCallback(RIG *, vfo_t, rig_ptr_t arg);
+    static int pttEventCallback(RIG *, vfo_t, ptt_t, rig_ptr_t arg);
+
     static rmode_t modeSubmodeToModeT(const QString &mode, const QString &submode);
     QString hamlibErrorString(int);
 
@@ -158,6 +233,12 @@ private:
     QTimer* timer;
 
     bool forceSendState;
+
+    AttributePoll attributePolls[ATTR_COUNT];
+    QElapsedTimer pollClock;
+    QAtomicInt pendingSetCommands;
+    QAtomicInt pendingNotifications;
+    bool transceiveEnabled;
 };
 
 Q_DECLARE_METATYPE(rmode_t);
@@ -0,0 +1,117 @@
+#include "UdpForwarder.h"
+#include "core/HostsPortString.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.core.udpforwarder");
+
+UdpForwarder::UdpForwarder(QObject *parent) :
+    QObject(parent)
+{
+    FCT_IDENTIFICATION;
+}
+
+void UdpForwarder::setDestinations(const QString &addresses)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << addresses;
+
+    if ( addresses == currentAddresses )
+    {
+        return;
+    }
+
+    clearDestinations();
+    currentAddresses = addresses;
+
+    const HostsPortString hostsPortString(addresses);
+    const QList<HostPortAddress> addrList = hostsPortString.getAddrList();
+
+    for ( const HostPortAddress &addr : addrList )
+    {
+        Destination destination;
+
+        destination.address = addr;
+        destination.port = addr.getPort();
+        destination.socket = new QUdpSocket(this);
+
+        destinations.append(destination);
+    }
+
+    qCDebug(runtime) << "Destinations" << destinations.size();
+}
+
+int UdpForwarder::destinationCount() const
+{
+    return destinations.size();
+}
+
+void UdpForwarder::forward(const QByteArray &datagram)
+{
+    FCT_IDENTIFICATION;
+
+    for ( Destination &destination : destinations )
+    {
+        if ( destination.socket->writeDatagram(datagram, destination.address, destination.port) < 0 )
+        {
+            qCDebug(runtime) << "Cannot forward to" << destination.address << destination.port
+                             << destination.socket->errorString();
+            destination.dropped++;
+        }
+        else
+        {
+            destination.forwarded++;
+        }
+    }
+}
+
+void UdpForwarder::forward(const QList<QByteArray> &datagrams)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << datagrams.size();
+
+    for ( const QByteArray &datagram : datagrams )
+    {
+        forward(datagram);
+    }
+}
+
+QList<UdpForwarder::DestinationStats> UdpForwarder::stats() const
+{
+    FCT_IDENTIFICATION;
+
+    QList<DestinationStats> ret;
+
+    for ( const Destination &destination : destinations )
+    {
+        ret << DestinationStats{destination.address, destination.port,
+                                destination.forwarded, destination.dropped};
+    }
+
+    return ret;
+}
+
+void UdpForwarder::clearDestinations()
+{
+    FCT_IDENTIFICATION;
+
+    for ( const Destination &destination : qAsConst(destinations) )
+    {
+        qCDebug(runtime) << "Removing destination"
+                         << DestinationStats{destination.address, destination.port,
+                                             destination.forwarded, destination.dropped};
+        destination.socket->deleteLater();
+    }
+
+    destinations.clear();
+}
+
+QDebug operator<<(QDebug debug, const UdpForwarder::DestinationStats &stats)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << stats.address.toString() << ":" << stats.port
+                    << " Forwarded: " << stats.forwarded
+                    << "; Dropped: " << stats.dropped;
+    return debug;
+}
@@ -0,0 +1,50 @@
+#ifndef UDPFORWARDER_H
+#define UDPFORWARDER_H
+
+#include <QObject>
+#include <QHostAddress>
+#include <QUdpSocket>
+
+/* Forwards UDP datagrams to a list of destinations ("host:port host:port").
+ * The destination list is parsed only when it is changed and every
+ * destination has its own long-lived socket. */
+class UdpForwarder : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct DestinationStats
+    {
+        QHostAddress address;
+        quint16 port;
+        quint64 forwarded;
+        quint64 dropped;
+    };
+
+    explicit UdpForwarder(QObject *parent = nullptr);
+
+    void setDestinations(const QString &addresses);
+    int destinationCount() const;
+    void forward(const QByteArray &datagram);
+    void forward(const QList<QByteArray> &datagrams);
+    QList<DestinationStats> stats() const;
+
+private:
+    struct Destination
+    {
+        QHostAddress address;
+        quint16 port = 0;
+        QUdpSocket *socket = nullptr;
+        quint64 forwarded = 0;
+        quint64 dropped = 0;
+    };
+
+    void clearDestinations();
+
+    QString currentAddresses;
+    QList<Destination> destinations;
+};
+
+QDebug operator<<(QDebug debug, const UdpForwarder::DestinationStats &stats);
+
+#endif // UDPFORWARDER_H
@@ -0,0 +1,979 @@
+#include <QSettings>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QTextStream>
+
+#include "UploadOutbox.h"
+#include "core/QRZ.h"
+#include "core/HRDLog.h"
+#include "core/ClubLog.h"
+#include "logformat/AdiFormat.h"
+#include "core/debug.h"
+
+// Interval to check the delayed (failed) QSOs (ms)
+#define UPLOAD_RETRY_CHECK_INTERVAL 30000
+
+// Upload statuses are written in bulk after this delay (ms)
+#define UPLOAD_STATUS_FLUSH_DELAY 500
+
+// A failed bulk write of upload statuses is repeated after this delay (ms)
+#define UPLOAD_STATUS_FLUSH_RETRY_DELAY 5000
+
+// Backoff for failed QSOs (s) - doubled after every failure
+#define UPLOAD_BACKOFF_BASE 30
+#define UPLOAD_BACKOFF_MAX 3600
+
+// Failed QSOs are not retried automatically after this number of attempts
+#define UPLOAD_MAX_ATTEMPTS 10
+
+MODULE_IDENTIFICATION("qlog.core.uploadoutbox");
+
+UploadOutbox *UploadOutbox::currentInstance = nullptr;
+
+UploadOutbox::UploadOutbox(QObject *parent) :
+    QObject(parent),
+    clientSlots(SERVICE_COUNT),
+    uploadedIDs(SERVICE_COUNT),
+    uploadedCount(SERVICE_COUNT, 0),
+    active(SERVICE_COUNT, false),
+    retryTimer(new QTimer(this)),
+    flushTimer(new QTimer(this))
+{
+    FCT_IDENTIFICATION;
+
+    for ( int service = 0; service < SERVICE_COUNT; service++ )
+    {
+        clientSlots[service].resize(serviceConfig(static_cast<Service>(service)).maxRequests);
+    }
+
+    connect(retryTimer, &QTimer::timeout, this, &UploadOutbox::processQueue);
+
+    flushTimer->setSingleShot(true);
+    connect(flushTimer, &QTimer::timeout, this, &UploadOutbox::flushUploaded);
+
+    if ( currentInstance )
+    {
+        qWarning() << "Upload Outbox already exists";
+    }
+
+    currentInstance = this;
+}
+
+UploadOutbox::~UploadOutbox()
+{
+    FCT_IDENTIFICATION;
+
+    /* statuses of the already uploaded QSOs are written before the Outbox disappears.
+     * Nobody listens anymore */
+    blockSignals(true);
+
+    if ( flushTimer->isActive() )
+    {
+        flushUploaded();
+    }
+
+    if ( currentInstance == this )
+    {
+        currentInstance = nullptr;
+    }
+}
+
+UploadOutbox *UploadOutbox::instance()
+{
+    FCT_IDENTIFICATION;
+
+    /* the Outbox is owned by the Main Window */
+    return currentInstance;
+}
+
+const UploadOutbox::ServiceConfig &UploadOutbox::serviceConfig(Service service)
+{
+    /* QRZ.com Logbook API and HRDLog accept one QSO per request,
+     * Clublog putlogs accepts an ADIF file */
+    static const ServiceConfig configs[SERVICE_COUNT] =
+    {
+        {"qrzcom", "qrzcom_qso_upload_status", "qrzcom_qso_upload_date", "*", 1, 4},
+        {"hrdlog", "hrdlog_qso_upload_status", "hrdlog_qso_upload_date", "*", 1, 2},
+        /* https://clublog.freshdesk.com/support/solutions/articles/53202-which-adif-fields-does-club-log-use- */
+        {"clublog", "clublog_qso_upload_status", "clublog_qso_upload_date",
+         "id, start_time, qsl_rdate, qsl_sdate, callsign, operator, "
+         "mode, band, band_rx, freq, qsl_rcvd, lotw_qsl_rcvd, qsl_sent, dxcc, "
+         "prop_mode, credit_granted, rst_sent, rst_rcvd, notes, "
+         "gridsquare, vucc_grids, sat_name", 500, 1}
+    };
+
+    return configs[service];
+}
+
+QString UploadOutbox::uploadURL(const QString &serviceKey,
+                                const QString &defaultURL)
+{
+    QSettings settings;
+
+    /* the URL can be redirected to a local stand-in of the service */
+    return settings.value(serviceKey + "/uploadurl", defaultURL).toString();
+}
+
+void UploadOutbox::start()
+{
+    FCT_IDENTIFICATION;
+
+    /* continue with QSOs left from the previous run */
+    for ( int service = 0; service < SERVICE_COUNT; service++ )
+    {
+        const int pending = pendingCount(static_cast<Service>(service));
+
+        if ( pending > 0 )
+        {
+            qCDebug(runtime) << "Pending QSOs" << serviceConfig(static_cast<Service>(service)).key << pending;
+            active[service] = true;
+        }
+    }
+
+    retryTimer->start(UPLOAD_RETRY_CHECK_INTERVAL);
+    processQueue();
+}
+
+void UploadOutbox::enqueue(Service service, const QList<int> &contactIDs)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << service << contactIDs.size();
+
+    if ( contactIDs.isEmpty() )
+    {
+        return;
+    }
+
+    QSqlDatabase db = QSqlDatabase::database();
+
+    if ( ! db.transaction() )
+    {
+        qWarning() << "Cannot start transaction" << db.lastError();
+        return;
+    }
+
+    QSqlQuery query;
+
+    /* an already queued QSO is retried immediately */
+    if ( ! query.prepare("INSERT INTO upload_outbox(service, contactid) VALUES (:service, :contactid) "
+                         "ON CONFLICT(service, contactid) DO UPDATE SET attempts = 0, next_attempt = 0") )
+    {
+        qWarning() << "Cannot prepare Insert statement" << query.lastError();
+        db.rollback();
+        return;
+    }
+
+    QVariantList services;
+    QVariantList ids;
+
+    for ( int contactID : contactIDs )
+    {
+        services << serviceConfig(service).key;
+        ids << contactID;
+    }
+
+    query.bindValue(":service", services);
+    query.bindValue(":contactid", ids);
+
+    if ( ! query.execBatch() )
+    {
+        qWarning() << "Cannot insert QSOs to Upload Outbox" << query.lastError();
+        db.rollback();
+        return;
+    }
+
+    if ( ! db.commit() )
+    {
+        qWarning() << "Cannot commit Upload Outbox" << db.lastError();
+        db.rollback();
+        return;
+    }
+
+    if ( ! active[service] )
+    {
+        active[service] = true;
+        uploadedCount[service] = 0;
+    }
+
+    processQueue();
+}
+
+int UploadOutbox::pendingCount(Service service)
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query;
+
+    /* QSOs which have reached the maximal number of attempts are not waiting */
+    if ( ! query.prepare("SELECT COUNT(*) FROM upload_outbox "
+                         "WHERE service = :service AND attempts < :maxAttempts") )
+    {
+        qWarning() << "Cannot prepare Select statement" << query.lastError();
+        return 0;
+    }
+
+    query.bindValue(":service", serviceConfig(service).key);
+    query.bindValue(":maxAttempts", UPLOAD_MAX_ATTEMPTS);
+
+    if ( ! query.exec() || ! query.next() )
+    {
+        qWarning() << "Cannot get Upload Outbox size" << query.lastError();
+        return 0;
+    }
+
+    return query.value(0).toInt();
+}
+
+int UploadOutbox::failedCount(Service service, QString *lastError)
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query;
+
+    if ( ! query.prepare("SELECT COUNT(*), "
+                         "       (SELECT last_error FROM upload_outbox "
+                         "        WHERE service = :service1 AND attempts >= :maxAttempts1 "
+                         "        ORDER BY next_attempt DESC LIMIT 1) "
+                         "FROM upload_outbox "
+                         "WHERE service = :service2 AND attempts >= :maxAttempts2") )
+    {
+        qWarning() << "Cannot prepare Select statement" << query.lastError();
+        return 0;
+    }
+
+    query.bindValue(":service1", serviceConfig(service).key);
+    query.bindValue(":maxAttempts1", UPLOAD_MAX_ATTEMPTS);
+    query.bindValue(":service2", serviceConfig(service).key);
+    query.bindValue(":maxAttempts2", UPLOAD_MAX_ATTEMPTS);
+
+    if ( ! query.exec() || ! query.next() )
+    {
+        qWarning() << "Cannot get failed Upload Outbox QSOs" << query.lastError();
+        return 0;
+    }
+
+    if ( lastError )
+    {
+        *lastError = query.value(1).toString();
+    }
+
+    return query.value(0).toInt();
+}
+
+QString UploadOutbox::failedSummary(Service service)
+{
+    FCT_IDENTIFICATION;
+
+    QString lastError;
+    const int failed = failedCount(service, &lastError);
+
+    if ( failed == 0 )
+    {
+        return QString();
+    }
+
+    return tr("%n QSO(s) could not be uploaded after repeated attempts. "
+              "Upload them again to retry. Last error: ", "", failed) + lastError;
+}
+
+void UploadOutbox::cancel(Service service, const QList<int> &contactIDs)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << service << contactIDs.size();
+
+    QSet<int> canceledIDs;
+
+    for ( int contactID : contactIDs )
+    {
+        canceledIDs.insert(contactID);
+    }
+
+    QList<int> abortedIDs;
+
+    for ( Slot &slot : clientSlots[service] )
+    {
+        bool canceledSlot = false;
+
+        for ( int contactID : qAsConst(slot.contactIDs) )
+        {
+            if ( canceledIDs.contains(contactID) )
+            {
+                canceledSlot = true;
+                break;
+            }
+        }
+
+        if ( !canceledSlot )
+        {
+            continue;
+        }
+
+        /* the slot is released before the abort therefore the abort is not
+         * handled as a failure. Other QSOs of the request stay in the queue */
+        abortedIDs << slot.contactIDs;
+        slot.contactIDs.clear();
+        abortClient(service, slot.client);
+    }
+
+    removeEntries(service, contactIDs);
+
+    qCDebug(runtime) << "Canceled" << serviceConfig(service).key << "aborted" << abortedIDs.size();
+
+    /* QSOs which have been already uploaded are still marked */
+    flushUploaded();
+
+    QMetaObject::invokeMethod(this, &UploadOutbox::processQueue, Qt::QueuedConnection);
+}
+
+void UploadOutbox::contactAdded(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings;
+
+    const int contactID = record.value("id").toInt();
+
+    for ( int service = 0; service < SERVICE_COUNT; service++ )
+    {
+        const ServiceConfig &config = serviceConfig(static_cast<Service>(service));
+
+        if ( settings.value(config.key + "/realtime_upload", false).toBool() )
+        {
+            enqueue(static_cast<Service>(service), {contactID});
+        }
+    }
+}
+
+void UploadOutbox::processQueue()
+{
+    FCT_IDENTIFICATION;
+
+    for ( int serviceIndex = 0; serviceIndex < SERVICE_COUNT; serviceIndex++ )
+    {
+        const Service service = static_cast<Service>(serviceIndex);
+        const ServiceConfig &config = serviceConfig(service);
+
+        QList<int> freeSlots;
+        QSet<int> inFlightIDs;
+
+        for ( int i = 0; i < clientSlots[service].size(); i++ )
+        {
+            const Slot &slot = clientSlots[service].at(i);
+
+            if ( slot.contactIDs.isEmpty() )
+            {
+                freeSlots << i;
+            }
+            else
+            {
+                for ( int id : slot.contactIDs )
+                {
+                    inFlightIDs.insert(id);
+                }
+            }
+        }
+
+        if ( freeSlots.isEmpty() )
+        {
+            continue;
+        }
+
+        /* uploaded QSOs stay in the table until their status is flushed */
+        for ( int id : qAsConst(uploadedIDs[service]) )
+        {
+            inFlightIDs.insert(id);
+        }
+
+        QSqlQuery query;
+
+        if ( ! query.prepare("SELECT contactid FROM upload_outbox "
+                             "WHERE service = :service AND next_attempt <= :now AND attempts < :maxAttempts "
+                             "ORDER BY id LIMIT :limit") )
+        {
+            qWarning() << "Cannot prepare Select statement" << query.lastError();
+            continue;
+        }
+
+        query.bindValue(":service", config.key);
+        query.bindValue(":now", QDateTime::currentSecsSinceEpoch());
+        query.bindValue(":maxAttempts", UPLOAD_MAX_ATTEMPTS);
+        query.bindValue(":limit", freeSlots.size() * config.batchSize + inFlightIDs.size());
+
+        if ( ! query.exec() )
+        {
+            qWarning() << "Cannot get Upload Outbox QSOs" << query.lastError();
+            continue;
+        }
+
+        QList<int> batch;
+
+        while ( query.next() && !freeSlots.isEmpty() )
+        {
+            const int contactID = query.value(0).toInt();
+
+            if ( inFlightIDs.contains(contactID) )
+            {
+                continue;
+            }
+
+            batch << contactID;
+
+            if ( batch.size() == config.batchSize )
+            {
+                sendBatch(service, freeSlots.takeFirst(), batch);
+                batch.clear();
+            }
+        }
+
+        if ( !batch.isEmpty() && !freeSlots.isEmpty() )
+        {
+            sendBatch(service, freeSlots.takeFirst(), batch);
+        }
+
+        checkFinished(service);
+    }
+}
+
+void UploadOutbox::sendBatch(Service service, int slotIndex, const QList<int> &contactIDs)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << service << slotIndex << contactIDs.size();
+
+    const ServiceConfig &config = serviceConfig(service);
+
+    QSqlQuery query;
+
+    if ( ! query.exec(QString("SELECT %1 FROM contacts WHERE id IN (%2) ORDER BY start_time")
+                      .arg(config.selectColumns, idList(contactIDs))) )
+    {
+        qWarning() << "Cannot get QSOs for upload" << query.lastError();
+        return;
+    }
+
+    QList<QSqlRecord> records;
+    QList<int> foundIDs;
+
+    while ( query.next() )
+    {
+        records << query.record();
+        foundIDs << query.value("id").toInt();
+    }
+
+    /* deleted QSOs are not uploaded */
+    QList<int> missingIDs;
+
+    for ( int contactID : contactIDs )
+    {
+        if ( !foundIDs.contains(contactID) )
+        {
+            missingIDs << contactID;
+        }
+    }
+
+    removeEntries(service, missingIDs);
+
+    if ( records.isEmpty() )
+    {
+        return;
+    }
+
+    QObject *client = slotClient(service, slotIndex);
+
+    if ( !client )
+    {
+        return;
+    }
+
+    clientSlots[service][slotIndex].contactIDs = foundIDs;
+
+    switch ( service )
+    {
+    case QRZCOM:
+        static_cast<QRZ *>(client)->uploadContact(records.first());
+        break;
+
+    case HRDLOG:
+        static_cast<HRDLog *>(client)->uploadContact(records.first());
+        break;
+
+    case CLUBLOG:
+    {
+        QByteArray data;
+        QTextStream stream(&data, QIODevice::ReadWrite);
+        AdiFormat adi(stream);
+
+        adi.exportStart();
+
+        for ( const QSqlRecord &record : qAsConst(records) )
+        {
+            adi.exportContact(record);
+        }
+
+        stream.flush();
+        static_cast<ClubLog *>(client)->uploadAdif(data);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+QObject *UploadOutbox::slotClient(Service service, int slotIndex)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << service << slotIndex;
+
+    Slot &slot = clientSlots[service][slotIndex];
+
+    /* every slot keeps its client and its connection to the service */
+    if ( !slot.client.isNull() )
+    {
+        return slot.client;
+    }
+
+    switch ( service )
+    {
+    case QRZCOM:
+    {
+        QRZ *qrz = new QRZ(this);
+
+        connect(qrz, &QRZ::uploadedQSO, this, [this, slotIndex](int contactID)
+        {
+            contactUploaded(QRZCOM, slotIndex, contactID);
+        });
+        connect(qrz, &QRZ::uploadError, this, [this, slotIndex](const QString &error)
+        {
+            requestFailed(QRZCOM, slotIndex, error);
+        });
+        slot.client = qrz;
+        break;
+    }
+
+    case HRDLOG:
+    {
+        HRDLog *hrdlog = new HRDLog(this);
+
+        connect(hrdlog, &HRDLog::uploadedQSO, this, [this, slotIndex](int contactID)
+        {
+            contactUploaded(HRDLOG, slotIndex, contactID);
+        });
+        connect(hrdlog, &HRDLog::uploadError, this, [this, slotIndex](const QString &error)
+        {
+            requestFailed(HRDLOG, slotIndex, error);
+        });
+        slot.client = hrdlog;
+        break;
+    }
+
+    case CLUBLOG:
+    {
+        ClubLog *clublog = new ClubLog(this);
+
+        connect(clublog, &ClubLog::uploadOK, this, [this, slotIndex](const QString &)
+        {
+            const QList<int> contactIDs = clientSlots[CLUBLOG][slotIndex].contactIDs;
+
+            for ( int contactID : contactIDs )
+            {
+                contactUploaded(CLUBLOG, slotIndex, contactID);
+            }
+        });
+        connect(clublog, &ClubLog::uploadError, this, [this, slotIndex](const QString &error)
+        {
+            requestFailed(CLUBLOG, slotIndex, error);
+        });
+        slot.client = clublog;
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return slot.client;
+}
+
+void UploadOutbox::contactUploaded(Service service, int slotIndex, int contactID)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << service << slotIndex << contactID;
+
+    Slot &slot = clientSlots[service][slotIndex];
+
+    if ( !slot.contactIDs.removeOne(contactID) )
+    {
+        /* the request was canceled */
+        return;
+    }
+
+    uploadedIDs[service] << contactID;
+
+    if ( !flushTimer->isActive() )
+    {
+        flushTimer->start(UPLOAD_STATUS_FLUSH_DELAY);
+    }
+
+    if ( slot.contactIDs.isEmpty() )
+    {
+        requestFinished(service, slotIndex);
+    }
+}
+
+void UploadOutbox::requestFinished(Service service, int slotIndex)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << service << slotIndex;
+
+    /* the slot is free - the next batch can be sent */
+    QMetaObject::invokeMethod(this, &UploadOutbox::processQueue, Qt::QueuedConnection);
+}
+
+void UploadOutbox::requestFailed(Service service, int slotIndex, const QString &error)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << service << slotIndex << error;
+
+    Slot &slot = clientSlots[service][slotIndex];
+
+    if ( slot.contactIDs.isEmpty() )
+    {
+        return;
+    }
+
+    QSqlQuery query;
+
+    if ( ! query.prepare(QString("UPDATE upload_outbox "
+                                 "SET attempts = attempts + 1, "
+                                 "    next_attempt = :now + MIN(:base << attempts, :max), "
+                                 "    last_error = :error "
+                                 "WHERE service = :service AND contactid IN (%1)").arg(idList(slot.contactIDs))) )
+    {
+        qWarning() << "Cannot prepare Update statement" << query.lastError();
+    }
+    else
+    {
+        query.bindValue(":now", QDateTime::currentSecsSinceEpoch());
+        query.bindValue(":base", UPLOAD_BACKOFF_BASE);
+        query.bindValue(":max", UPLOAD_BACKOFF_MAX);
+        query.bindValue(":error", error);
+        query.bindValue(":service", serviceConfig(service).key);
+
+        if ( ! query.exec() )
+        {
+            qWarning() << "Cannot update Upload Outbox" << query.lastError();
+        }
+    }
+
+    qCDebug(runtime) << "Upload failed" << serviceConfig(service).key << slot.contactIDs.size() << error;
+
+    const QList<int> failedIDs = slot.contactIDs;
+
+    slot.contactIDs.clear();
+
+    emit uploadError(service, failedIDs, error);
+
+    /* the slot is free - other due QSOs do not have to wait for the retry timer */
+    QMetaObject::invokeMethod(this, &UploadOutbox::processQueue, Qt::QueuedConnection);
+}
+
+void UploadOutbox::abortClient(Service service, QObject *client)
+{
+    FCT_IDENTIFICATION;
+
+    if ( !client )
+    {
+        return;
+    }
+
+    switch ( service )
+    {
+    case QRZCOM: static_cast<QRZ *>(client)->abortQuery(); break;
+    case HRDLOG: static_cast<HRDLog *>(client)->abortRequest(); break;
+    case CLUBLOG: static_cast<ClubLog *>(client)->abortRequest(); break;
+    default: break;
+    }
+}
+
+void UploadOutbox::flushUploaded()
+{
+    FCT_IDENTIFICATION;
+
+    flushTimer->stop();
+
+    QSqlDatabase db = QSqlDatabase::database();
+    bool flushFailed = false;
+
+    for ( int serviceIndex = 0; serviceIndex < SERVICE_COUNT; serviceIndex++ )
+    {
+        const Service service = static_cast<Service>(serviceIndex);
+        const ServiceConfig &config = serviceConfig(service);
+
+        if ( uploadedIDs[service].isEmpty() )
+        {
+            continue;
+        }
+
+        const QString ids = idList(uploadedIDs[service]);
+
+        if ( ! db.transaction() )
+        {
+            qWarning() << "Cannot start transaction" << db.lastError();
+            flushFailed = true;
+            continue;
+        }
+
+        QSqlQuery query;
+
+        if ( ! query.exec(QString("UPDATE contacts "
+                                  "SET %1 = 'Y', %2 = strftime('%Y-%m-%d', DATETIME('now', 'utc')) "
+                                  "WHERE id IN (%3)").arg(config.statusColumn, config.dateColumn, ids)) )
+        {
+            qWarning() << "Cannot update upload status" << query.lastError();
+            db.rollback();
+            flushFailed = true;
+            continue;
+        }
+
+        const int updated = query.numRowsAffected();
+
+        if ( ! query.exec(QString("DELETE FROM upload_outbox WHERE service = '%1' AND contactid IN (%2)")
+                          .arg(config.key, ids)) )
+        {
+            qWarning() << "Cannot remove uploaded QSOs from Upload Outbox" << query.lastError();
+            db.rollback();
+            flushFailed = true;
+            continue;
+        }
+
+        if ( ! db.commit() )
+        {
+            qWarning() << "Cannot commit upload status" << db.lastError();
+            db.rollback();
+            flushFailed = true;
+            continue;
+        }
+
+        qCDebug(runtime) << "Upload status updated" << config.key << updated;
+
+        const QList<int> doneIDs = uploadedIDs[service];
+
+        uploadedCount[service] += doneIDs.size();
+        uploadedIDs[service].clear();
+
+        emit contactsUploaded(service, doneIDs);
+        emit uploadProgress(service, uploadedCount[service], pendingCount(service));
+
+        checkFinished(service);
+    }
+
+    /* the uploaded QSOs stay in the list and they are written by the next attempt */
+    if ( flushFailed )
+    {
+        flushTimer->start(UPLOAD_STATUS_FLUSH_RETRY_DELAY);
+    }
+}
+
+void UploadOutbox::removeEntries(Service service, const QList<int> &contactIDs)
+{
+    FCT_IDENTIFICATION;
+
+    if ( contactIDs.isEmpty() )
+    {
+        return;
+    }
+
+    QSqlQuery query;
+
+    if ( ! query.exec(QString("DELETE FROM upload_outbox WHERE service = '%1' AND contactid IN (%2)")
+                      .arg(serviceConfig(service).key, idList(contactIDs))) )
+    {
+        qWarning() << "Cannot remove QSOs from Upload Outbox" << query.lastError();
+        return;
+    }
+
+    emit contactsRemoved(service, contactIDs);
+}
+
+void UploadOutbox::checkFinished(Service service)
+{
+    FCT_IDENTIFICATION;
+
+    if ( !active[service]
+         || isInFlight(service)
+         || !uploadedIDs[service].isEmpty()
+         || pendingCount(service) > 0 )
+    {
+        return;
+    }
+
+    qCDebug(runtime) << "Upload finished" << serviceConfig(service).key << uploadedCount[service];
+
+    active[service] = false;
+    emit uploadFinished(service);
+}
+
+bool UploadOutbox::isInFlight(Service service) const
+{
+    for ( const Slot &slot : clientSlots[service] )
+    {
+        if ( !slot.contactIDs.isEmpty() )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QString UploadOutbox::idList(const QList<int> &contactIDs)
+{
+    QStringList ret;
+
+    for ( int contactID : contactIDs )
+    {
+        ret << QString::number(contactID);
+    }
+
+    return ret.join(",");
+}
+
+UploadOutboxWatcher::UploadOutboxWatcher(UploadOutbox::Service service,
+                                         const QList<int> &contactIDs,
+                                         QObject *parent) :
+    QObject(parent),
+    service(service),
+    contactIDs(contactIDs),
+    uploadedCount(0)
+{
+    FCT_IDENTIFICATION;
+
+    for ( int contactID : contactIDs )
+    {
+        waitingIDs.insert(contactID);
+    }
+}
+
+void UploadOutboxWatcher::start()
+{
+    FCT_IDENTIFICATION;
+
+    UploadOutbox *outbox = UploadOutbox::instance();
+
+    if ( !outbox )
+    {
+        qWarning() << "Upload Outbox does not exist";
+        emit failed(tr("Upload Outbox is not available"), contactIDs.size());
+        return;
+    }
+
+    connect(outbox, &UploadOutbox::contactsUploaded, this,
+            [this](UploadOutbox::Service eventService, const QList<int> &eventIDs)
+    {
+        contactsDone(eventService, eventIDs, true);
+    });
+
+    /* e.g. QSOs deleted from the log meanwhile */
+    connect(outbox, &UploadOutbox::contactsRemoved, this,
+            [this](UploadOutbox::Service eventService, const QList<int> &eventIDs)
+    {
+        contactsDone(eventService, eventIDs, false);
+    });
+
+    connect(outbox, &UploadOutbox::uploadError, this,
+            [this](UploadOutbox::Service eventService, const QList<int> &eventIDs, const QString &error)
+    {
+        if ( eventService != service )
+        {
+            return;
+        }
+
+        for ( int contactID : eventIDs )
+        {
+            if ( waitingIDs.contains(contactID) )
+            {
+                /* failed QSOs stay in the Outbox and they are retried later */
+                stop();
+                emit failed(error, waitingIDs.size());
+                return;
+            }
+        }
+    });
+
+    outbox->enqueue(service, contactIDs);
+}
+
+void UploadOutboxWatcher::cancel()
+{
+    FCT_IDENTIFICATION;
+
+    stop();
+
+    UploadOutbox *outbox = UploadOutbox::instance();
+
+    /* only the QSOs of this upload are removed from the Outbox */
+    if ( outbox )
+    {
+        outbox->cancel(service, waitingIDs.values());
+    }
+}
+
+void UploadOutboxWatcher::contactsDone(UploadOutbox::Service eventService,
+                                       const QList<int> &eventIDs,
+                                       bool uploaded)
+{
+    FCT_IDENTIFICATION;
+
+    if ( eventService != service )
+    {
+        return;
+    }
+
+    bool changed = false;
+
+    for ( int contactID : eventIDs )
+    {
+        if ( waitingIDs.remove(contactID) )
+        {
+            changed = true;
+
+            if ( uploaded )
+            {
+                uploadedCount++;
+            }
+        }
+    }
+
+    if ( !changed )
+    {
+        return;
+    }
+
+    emit progress(contactIDs.size() - waitingIDs.size());
+
+    if ( waitingIDs.isEmpty() )
+    {
+        stop();
+        emit finished(uploadedCount);
+    }
+}
+
+void UploadOutboxWatcher::stop()
+{
+    FCT_IDENTIFICATION;
+
+    UploadOutbox *outbox = UploadOutbox::instance();
+
+    if ( outbox )
+    {
+        outbox->disconnect(this);
+    }
+}
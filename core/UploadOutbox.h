@@ -0,0 +1,138 @@
+#ifndef UPLOADOUTBOX_H
+#define UPLOADOUTBOX_H
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QSet>
+#include <QSqlRecord>
+
+/* Persistent queue of QSOs waiting for an upload to QRZ.com, HRDLog and Clublog.
+ * The queue is stored in the upload_outbox table therefore it survives
+ * restarts. Every service has a pool of clients - more requests are in flight
+ * at once and services which accept multi-record ADIF get QSOs in batches.
+ * Failed QSOs are retried with an exponential backoff; after the maximal
+ * number of attempts they stay in the queue as failed until they are
+ * enqueued again. Upload statuses of the uploaded QSOs are updated in bulk */
+class UploadOutbox : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Service
+    {
+        QRZCOM,
+        HRDLOG,
+        CLUBLOG,
+        SERVICE_COUNT
+    };
+    Q_ENUM(Service)
+
+    explicit UploadOutbox(QObject *parent = nullptr);
+    ~UploadOutbox();
+
+    static UploadOutbox *instance();
+
+    void enqueue(UploadOutbox::Service service,
+                 const QList<int> &contactIDs);
+    static int pendingCount(UploadOutbox::Service service);
+    static int failedCount(UploadOutbox::Service service,
+                           QString *lastError = nullptr);
+    static QString failedSummary(UploadOutbox::Service service);
+
+    static QString uploadURL(const QString &serviceKey,
+                             const QString &defaultURL);
+
+signals:
+    void uploadProgress(UploadOutbox::Service service, int uploaded, int remaining);
+    void uploadFinished(UploadOutbox::Service service);
+    void uploadError(UploadOutbox::Service service, QList<int> contactIDs, QString error);
+    void contactsUploaded(UploadOutbox::Service service, QList<int> contactIDs);
+    void contactsRemoved(UploadOutbox::Service service, QList<int> contactIDs);
+
+public slots:
+    void start();
+    void cancel(UploadOutbox::Service service, const QList<int> &contactIDs);
+    void contactAdded(const QSqlRecord &record);
+
+private slots:
+    void processQueue();
+    void flushUploaded();
+
+private:
+
+    struct ServiceConfig
+    {
+        QString key;            // service name in DB and settings prefix
+        QString statusColumn;
+        QString dateColumn;
+        QString selectColumns;  // contact's fields sent to the service
+        int batchSize;          // QSOs in one request
+        int maxRequests;        // requests in flight
+    };
+
+    /* One client with its own network connection */
+    struct Slot
+    {
+        QPointer<QObject> client;
+        QList<int> contactIDs;
+    };
+
+    static const ServiceConfig &serviceConfig(Service service);
+
+    void sendBatch(Service service, int slotIndex, const QList<int> &contactIDs);
+    QObject *slotClient(Service service, int slotIndex);
+    void contactUploaded(Service service, int slotIndex, int contactID);
+    void requestFinished(Service service, int slotIndex);
+    void requestFailed(Service service, int slotIndex, const QString &error);
+    void abortClient(Service service, QObject *client);
+    void removeEntries(Service service, const QList<int> &contactIDs);
+    void checkFinished(Service service);
+    bool isInFlight(Service service) const;
+
+    static QString idList(const QList<int> &contactIDs);
+
+    QVector<QVector<Slot>> clientSlots;
+    QVector<QList<int>> uploadedIDs;
+    QVector<int> uploadedCount;
+    QVector<bool> active;
+    QTimer *retryTimer;
+    QTimer *flushTimer;
+
+    static UploadOutbox *currentInstance;
+};
+
+/* Follows the QSOs which have been enqueued together, e.g. by an upload dialog.
+ * Events of other QSOs of the same service (real-time uploads, retries) are
+ * ignored */
+class UploadOutboxWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UploadOutboxWatcher(UploadOutbox::Service service,
+                                 const QList<int> &contactIDs,
+                                 QObject *parent = nullptr);
+
+signals:
+    void progress(int processed);
+    void finished(int uploaded);
+    void failed(QString error, int notUploaded);
+
+public slots:
+    void start();
+    void cancel();
+
+private:
+    void contactsDone(UploadOutbox::Service service,
+                      const QList<int> &contactIDs,
+                      bool uploaded);
+    void stop();
+
+    UploadOutbox::Service service;
+    QList<int> contactIDs;
+    QSet<int> waitingIDs;
+    int uploadedCount;
+};
+
+#endif // UPLOADOUTBOX_H
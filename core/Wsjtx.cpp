@@ -11,7 +11,6 @@
 #include "Wsjtx.h"
 #include "data/Data.h"
 #include "debug.h"
-#include "core/HostsPortString.h"
 #include "core/Rig.h"
 
 MODULE_IDENTIFICATION("qlog.core.wsjtx");
@@ -23,6 +22,7 @@ Wsjtx::Wsjtx(QObject *parent) :
     FCT_IDENTIFICATION;
     socket = new QUdpSocket(this);
     openPort();
+    forwarder.setDestinations(getConfigForwardAddresses());
     connect(socket, &QUdpSocket::readyRead, this, &Wsjtx::readPendingDatagrams);
 }
 
@@ -96,23 +96,6 @@ void Wsjtx::openPort()
     }
 }
 
-void Wsjtx::forwardDatagram(const QNetworkDatagram &datagram)
-{
-    FCT_IDENTIFICATION;
-
-    HostsPortString forwardAddresses(getConfigForwardAddresses());
-
-    QList<HostPortAddress> addrList = forwardAddresses.getAddrList();
-
-    for ( const HostPortAddress &addr : qAsConst(addrList) )
-    {
-        QUdpSocket udpSocket;
-
-        qCDebug(runtime) << "Sending to " << addr;
-        udpSocket.writeDatagram(datagram.data(), addr, addr.getPort());
-    }
-}
-
 float Wsjtx::modePeriodLenght(const QString &mode)
 {
     FCT_IDENTIFICATION;
@@ -244,6 +227,8 @@ void Wsjtx::readPendingDatagrams()
 {
     FCT_IDENTIFICATION;
 
+    QList<QByteArray> forwardBatch;
+
     while (socket->hasPendingDatagrams()) {
         QNetworkDatagram datagram = socket->receiveDatagram();
 
@@ -268,7 +253,11 @@ void Wsjtx::readPendingDatagrams()
 
         qCDebug(runtime) << "WSJT mtype << "<< mtype << " schema " << schema;
 
-        forwardDatagram(datagram);
+        // datagrams are forwarded after all pending datagrams are processed
+        if ( forwarder.destinationCount() > 0 )
+        {
+            forwardBatch << datagram.data();
+        }
 
         switch (mtype) {
         /* WSJTX Status message */
@@ -388,6 +377,11 @@ void Wsjtx::readPendingDatagrams()
         }
         }
     }
+
+    if ( !forwardBatch.isEmpty() )
+    {
+        forwarder.forward(forwardBatch);
+    }
 }
 
 void Wsjtx::insertContact(WsjtxLog log)
@@ -539,6 +533,7 @@ void Wsjtx::reloadSetting()
 {
     FCT_IDENTIFICATION;
     openPort();
+    forwarder.setDestinations(getConfigForwardAddresses());
 }
 
 QString Wsjtx::CONFIG_PORT = "network/wsjtx_port";
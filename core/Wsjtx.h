@@ -6,6 +6,7 @@
 #include <QHostAddress>
 #include <QSqlRecord>
 #include <QNetworkDatagram>
+#include "core/UdpForwarder.h"
 
 class Data;
 class QUdpSocket;
@@ -152,6 +153,7 @@ private slots:
 
 private:
     QUdpSocket* socket;
+    UdpForwarder forwarder;
     QHostAddress wsjtxAddress;
     quint16 wsjtxPort;
 
@@ -163,7 +165,6 @@ private:
     static QString CONFIG_MULTICAST_TTL;
 
     void openPort();
-    void forwardDatagram(const QNetworkDatagram &);
 };
 
 #endif // WSJTX_H
@@ -7,12 +7,26 @@
 Q_DECLARE_LOGGING_CATEGORY(logGraphics)
 Q_DECLARE_LOGGING_CATEGORY(logPlugin)
 
-#define MODULE_IDENTIFICATION(m) static const char *mod_name = m; \
-                                 static const QLoggingCategory function_parameters(m".function.parameters"); \
+/* Function entry tracing uses a per-module static category. The category is created
+ * only once; when it is disabled, FCT_IDENTIFICATION costs only one check of
+ * the category's enabled flag. Define QLOG_NO_FUNCTION_TRACING to remove the tracing
+ * from the build completely */
+#ifdef QLOG_NO_FUNCTION_TRACING
+
+#define MODULE_IDENTIFICATION(m) static const QLoggingCategory function_parameters(m".function.parameters"); \
+                                 static const QLoggingCategory runtime(m".runtime");
+
+#define FCT_IDENTIFICATION do { } while ( 0 )
+
+#else
+
+#define MODULE_IDENTIFICATION(m) static const QLoggingCategory function_parameters(m".function.parameters"); \
                                  static const QLoggingCategory runtime(m".runtime"); \
+                                 static const QLoggingCategory function_entered(m".function.entered");
+
+#define FCT_IDENTIFICATION qCDebug(function_entered) << "***"
 
-#define FCT_IDENTIFICATION QString logging_cat(mod_name); logging_cat.append(".function.entered"); \
-                           qCDebug(QLoggingCategory(logging_cat.toLatin1().constData()))<<"***"
+#endif
 
 typedef enum debug_level
 {
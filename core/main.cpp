@@ -26,6 +26,7 @@
 #include "ui/SplashScreen.h"
 #include "core/MembershipQE.h"
 #include "core/KSTChat.h"
+#include "core/DxClusterIngest.h"
 
 MODULE_IDENTIFICATION("qlog.core.main");
 
@@ -314,10 +315,13 @@ int main(int argc, char* argv[])
 
     qInstallMessageHandler(debugMessageOutput);
     qRegisterMetaType<VFOID>();
+    qRegisterMetaType<rmode_t>("rmode_t");
     qRegisterMetaType<ClubStatusQuery::ClubStatus>();
     qRegisterMetaType<QMap<QString, ClubStatusQuery::ClubStatus>>();
     qRegisterMetaType<KSTChatMsg>();
     qRegisterMetaType<KSTUsersInfo>();
+    qRegisterMetaType<QList<DxSpot>>();
+    qRegisterMetaType<DxClusterIngestStats>();
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
     qRegisterMetaTypeStreamOperators<QSet<int>>("QSet<int>");
 #endif
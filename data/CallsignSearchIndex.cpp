@@ -0,0 +1,61 @@
+#include "CallsignSearchIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.callsignsearchindex");
+
+QString CallsignSearchIndex::containsFilter(const QString &callsign)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign;
+
+    const QString upperCallsign = callsign.toUpper();
+    QString escapedCallsign(upperCallsign);
+    escapedCallsign.replace("'", "''");
+
+    const QString likeCondition = QString("callsign LIKE '%%1%'").arg(escapedCallsign);
+    const QStringList callsignTrigrams = trigrams(upperCallsign);
+
+    /* a callsign without any literal trigram cannot use the index */
+    if ( callsignTrigrams.isEmpty() )
+    {
+        return likeCondition;
+    }
+
+    QStringList subSelects;
+
+    for ( QString trigram : callsignTrigrams )
+    {
+        trigram.replace("'", "''");
+        subSelects << QString("SELECT contactid FROM contacts_callsign_trigrams WHERE trigram = '%1'").arg(trigram);
+    }
+
+    /* trigrams select candidates; LIKE removes the candidates
+     * which contain all trigrams but not the whole string */
+    return QString("(id IN (%1) AND %2)").arg(subSelects.join(" INTERSECT "), likeCondition);
+}
+
+QStringList CallsignSearchIndex::trigrams(const QString &callsign)
+{
+    FCT_IDENTIFICATION;
+
+    QStringList ret;
+
+    for ( int i = 0; i + 3 <= callsign.size(); i++ )
+    {
+        const QString trigram = callsign.mid(i, 3);
+
+        /* LIKE wildcards typed by the user do not match stored trigrams literally */
+        if ( trigram.contains('_') || trigram.contains('%') )
+        {
+            continue;
+        }
+
+        if ( !ret.contains(trigram) )
+        {
+            ret << trigram;
+        }
+    }
+
+    return ret;
+}
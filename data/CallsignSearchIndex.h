@@ -0,0 +1,18 @@
+#ifndef CALLSIGNSEARCHINDEX_H
+#define CALLSIGNSEARCHINDEX_H
+
+#include <QtCore>
+
+/* Trigram index of the contacts' callsigns used by substring callsign searches.
+ * The index table is created by a DB migration and it is maintained
+ * incrementally by triggers on the contacts table. */
+class CallsignSearchIndex
+{
+public:
+    static QString containsFilter(const QString &callsign);
+
+private:
+    static QStringList trigrams(const QString &callsign);
+};
+
+#endif // CALLSIGNSEARCHINDEX_H
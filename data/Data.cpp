@@ -1,17 +1,33 @@
 #include <QJsonDocument>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlRecord>
 #include <QColor>
+#include <algorithm>
 #include "Data.h"
 #include "core/Callsign.h"
 #include "core/debug.h"
 
 MODULE_IDENTIFICATION("qlog.data.data");
 
+// Default capacities of the lookup caches (entries), see CONFIG_*_CACHE_CAPACITY_KEY
+#define DXCC_CACHE_CAPACITY 20000
+#define REFERENCE_CACHE_CAPACITY 2000
+
+// Interval of the lookup cache statistics in the debug log (ms)
+#define LOOKUP_CACHE_STATS_INTERVAL (10 * 60 * 1000)
+
 Data::Data(QObject *parent) :
    QObject(parent),
    zd(nullptr),
-   isDXCCQueryValid(false)
+   zdLoadTried(false),
+   dxccPrefixIndexGeneration(-1),
+   dxccStatusIndexGeneration(-1),
+   bandPlanGeneration(-1),
+   dxccLookupCache(DXCC_CACHE_CAPACITY),
+   sotaLookupCache(REFERENCE_CACHE_CAPACITY),
+   potaLookupCache(REFERENCE_CACHE_CAPACITY),
+   wwffLookupCache(REFERENCE_CACHE_CAPACITY)
 {
     FCT_IDENTIFICATION;
 
@@ -20,39 +36,70 @@ Data::Data(QObject *parent) :
     loadLegacyModes();
     loadDxccFlags();
     loadSatModes();
-    loadIOTA();
-    loadSOTA();
-    loadWWFF();
-    loadPOTA();
-    loadTZ();
-
-    isDXCCQueryValid = queryDXCC.prepare(
-                "SELECT "
-                "    dxcc_entities.id, "
-                "    dxcc_entities.name, "
-                "    dxcc_entities.prefix, "
-                "    dxcc_entities.cont, "
-                "    CASE "
-                "        WHEN (dxcc_prefixes.cqz != 0) "
-                "        THEN dxcc_prefixes.cqz "
-                "        ELSE dxcc_entities.cqz "
-                "    END AS cqz, "
-                "    CASE "
-                "        WHEN (dxcc_prefixes.ituz != 0) "
-                "        THEN dxcc_prefixes.ituz "
-                "        ELSE dxcc_entities.ituz "
-                "    END AS ituz , "
-                "    dxcc_entities.lat, "
-                "    dxcc_entities.lon, "
-                "    dxcc_entities.tz "
-                "FROM dxcc_prefixes "
-                "INNER JOIN dxcc_entities ON (dxcc_prefixes.dxcc = dxcc_entities.id) "
-                "WHERE (dxcc_prefixes.prefix = :callsign and dxcc_prefixes.exact = true) "
-                "    OR (dxcc_prefixes.exact = false and :callsign LIKE dxcc_prefixes.prefix || '%') "
-                "ORDER BY dxcc_prefixes.prefix "
-                "DESC LIMIT 1 "
-                );
 
+    loadDxccPrefixes();
+
+    QSettings settings;
+    const int dxccCacheCapacity = qMax(1, settings.value(CONFIG_DXCC_CACHE_CAPACITY_KEY,
+                                                         DXCC_CACHE_CAPACITY).toInt());
+    const int referenceCacheCapacity = qMax(1, settings.value(CONFIG_REFERENCE_CACHE_CAPACITY_KEY,
+                                                              REFERENCE_CACHE_CAPACITY).toInt());
+
+    qCDebug(runtime) << "Lookup Cache capacity" << dxccCacheCapacity << referenceCacheCapacity;
+
+    dxccLookupCache.setCapacity(dxccCacheCapacity);
+    sotaLookupCache.setCapacity(referenceCacheCapacity);
+    potaLookupCache.setCapacity(referenceCacheCapacity);
+    wwffLookupCache.setCapacity(referenceCacheCapacity);
+
+    connect(&lookupCacheStatsTimer, &QTimer::timeout, this, [this]()
+    {
+        qCDebug(runtime) << "Lookup Cache Statistics" << lookupCacheStats();
+    });
+    lookupCacheStatsTimer.start(LOOKUP_CACHE_STATS_INTERVAL);
+}
+
+Data::ReadConnection::ReadConnection(const QString &connectionName) :
+    isSOTAQueryValid(false),
+    isWWFFQueryValid(false),
+    isPOTAQueryValid(false),
+    connectionName(connectionName)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << connectionName;
+
+    if ( connectionName.isEmpty() )
+    {
+        db = QSqlDatabase::database();
+    }
+    else
+    {
+        db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(Data::dbFilename());
+        db.setConnectOptions("QSQLITE_ENABLE_REGEXP");
+
+        if ( ! db.open() )
+        {
+            qWarning() << "Cannot open DB Connection for reading" << db.lastError();
+            return;
+        }
+
+        QSqlQuery query(db);
+
+        if ( ! query.exec("PRAGMA query_only = ON") )
+        {
+            qWarning() << "Cannot set PRAGMA query_only" << query.lastError();
+        }
+
+        /* the main connection can hold the lock for a short time */
+        if ( ! query.exec("PRAGMA busy_timeout = 5000") )
+        {
+            qWarning() << "Cannot set PRAGMA busy_timeout" << query.lastError();
+        }
+    }
+
+    querySOTA = QSqlQuery(db);
     isSOTAQueryValid = querySOTA.prepare(
                 "SELECT summit_code,"
                 "       association_name,"
@@ -72,6 +119,7 @@ Data::Data(QObject *parent) :
                 "WHERE summit_code = UPPER(:code)"
                 );
 
+    queryPOTA = QSqlQuery(db);
     isPOTAQueryValid = queryPOTA.prepare(
                 "SELECT reference,"
                 "       name,"
@@ -85,6 +133,7 @@ Data::Data(QObject *parent) :
                 "WHERE reference = UPPER(:code)"
                 );
 
+    queryWWFF = QSqlQuery(db);
     isWWFFQueryValid = queryWWFF.prepare(
                 "SELECT reference,"
                 "       status,"
@@ -106,10 +155,47 @@ Data::Data(QObject *parent) :
                 );
 }
 
+Data::ReadConnection::~ReadConnection()
+{
+    FCT_IDENTIFICATION;
+
+    if ( connectionName.isEmpty() )
+    {
+        return;
+    }
+
+    // the queries and the DB handle must be released before the connection is removed
+    querySOTA = QSqlQuery();
+    queryWWFF = QSqlQuery();
+    queryPOTA = QSqlQuery();
+    db.close();
+    db = QSqlDatabase();
+
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+Data::ReadConnection *Data::readConnection()
+{
+    FCT_IDENTIFICATION;
+
+    if ( ! readConnections.hasLocalData() )
+    {
+        /* the GUI thread uses the main connection */
+        const QString connectionName = ( QThread::currentThread() == thread() )
+                                       ? QString()
+                                       : QString("data_%1").arg(reinterpret_cast<quintptr>(QThread::currentThread()), 0, 16);
+        readConnections.setLocalData(new ReadConnection(connectionName));
+    }
+
+    return readConnections.localData();
+}
+
 Data::~Data()
 {
     FCT_IDENTIFICATION;
 
+    qCDebug(runtime) << "Lookup Cache Statistics" << lookupCacheStats();
+
     if ( zd )
     {
         ZDCloseDatabase(zd);
@@ -128,72 +214,23 @@ DxccStatus Data::dxccStatus(int dxcc, const QString &band, const QString &mode)
 
     qCDebug(function_parameters) << dxcc << " " << band << " " << mode;
 
-    QString filter;
-
-    QSettings settings;
-    QVariant start = settings.value("dxcc/start");
-    if (!start.isNull()) {
-        filter = QString("AND start_time >= '%1'").arg(start.toDate().toString("yyyy-MM-dd"));
-    }
-
-    QString sql_mode = ":mode ";
-    if (mode != Data::MODE_CW && mode != Data::MODE_PHONE && mode != Data::MODE_DIGITAL) {
-        sql_mode = "(SELECT modes.dxcc FROM modes WHERE modes.name = :mode LIMIT 1) ";
-    }
+    Data *data = instance();
 
-    QSqlQuery query;
-
-    if ( ! query.prepare("WITH all_dxcc_qsos AS (SELECT DISTINCT contacts.mode, contacts.band, contacts.qsl_rcvd, contacts.lotw_qsl_rcvd FROM contacts WHERE dxcc = :dxcc " + filter + ") "
-                         "  SELECT (SELECT 1 FROM all_dxcc_qsos LIMIT 1) as entity,"
-                         "         (SELECT 1 FROM all_dxcc_qsos WHERE band = :band LIMIT 1) as band, "
-                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) WHERE modes.dxcc = " + sql_mode + " LIMIT 1) as mode, "
-                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) WHERE modes.dxcc = " + sql_mode + " AND all_dxcc_qsos.band = :band LIMIT 1) as slot, "
-                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) WHERE modes.dxcc = " + sql_mode + " AND all_dxcc_qsos.band = :band AND (all_dxcc_qsos.qsl_rcvd = 'Y' OR all_dxcc_qsos.lotw_qsl_rcvd = 'Y') LIMIT 1) as confirmed"
-                         )
-       )
+    /* contacts were changed by a bulk operation or DXCC settings were changed */
+    if ( data->dxccStatusIndexGeneration.loadAcquire() != dxccStatusGeneration.loadAcquire() )
     {
-        qWarning() << "Cannot prepare Select statement";
-        return DxccStatus::UnknownStatus;
+        data->loadDxccStatus();
     }
 
-    query.bindValue(":dxcc", dxcc);
-    query.bindValue(":band", band);
-    query.bindValue(":mode", mode);
+    QReadLocker locker(&data->dxccStatusIndexLock);
 
-    if ( ! query.exec() )
+    if ( ! data->dxccStatusIndex.isLoaded() )
     {
-        qWarning() << "Cannot execute Select statement" << query.lastError();
+        qWarning() << "DXCC Status Index is not loaded";
         return DxccStatus::UnknownStatus;
     }
 
-    if (query.next()) {
-        if (query.value(0).isNull()) {
-            return DxccStatus::NewEntity;
-        }
-        if (query.value(1).isNull()) {
-            if (query.value(2).isNull()) {
-                return DxccStatus::NewBandMode;
-            }
-            else {
-                return DxccStatus::NewBand;
-            }
-        }
-        if (query.value(2).isNull()) {
-            return DxccStatus::NewMode;
-        }
-        if (query.value(3).isNull()) {
-            return DxccStatus::NewSlot;
-        }
-        if ( query.value(4).isNull()) {
-            return DxccStatus::Worked;
-        }
-        else {
-            return DxccStatus::Confirmed;
-        }
-    }
-    else {
-        return DxccStatus::UnknownStatus;
-    }
+    return data->dxccStatusIndex.status(dxcc, band, mode);
 }
 
 #define RETURNCODE(a) \
@@ -360,30 +397,35 @@ Band Data::band(double freq) {
 
     qCDebug(function_parameters) << freq;
 
-    QSqlQuery query;
-    if ( ! query.prepare("SELECT name, start_freq, end_freq FROM bands WHERE :freq BETWEEN start_freq AND end_freq") )
+    Data *data = instance();
+
+    /* Band settings were changed */
+    if ( data->bandPlanGeneration.loadAcquire() != bandsGeneration.loadAcquire() )
     {
-        qWarning() << "Cannot prepare Select statement";
-        return Band();
+        data->loadBandPlan();
     }
-    query.bindValue(0, freq);
 
-    if ( ! query.exec() )
+    QReadLocker locker(&data->bandPlanLock);
+
+    const QVector<Band> &plan = data->bandPlan;
+
+    /* the last band which starts below or at the freq */
+    int index = static_cast<int>(std::upper_bound(plan.cbegin(), plan.cend(), freq,
+                                                  [](double value, const Band &band)
+                                                  {
+                                                      return value < band.start;
+                                                  }) - plan.cbegin()) - 1;
+
+    /* bands can overlap - go back while a previous band can still contain the freq */
+    for ( ; index >= 0 && data->bandPlanMaxEnd.at(index) >= freq; index-- )
     {
-        qWarning() << "Cannot execute select statement" << query.lastError();
-        return Band();
+        if ( freq <= plan.at(index).end )
+        {
+            return plan.at(index);
+        }
     }
 
-    if (query.next()) {
-        Band band;
-        band.name = query.value(0).toString();
-        band.start = query.value(1).toDouble();
-        band.end = query.value(2).toDouble();
-        return band;
-    }
-    else {
-        return Band();
-    }
+    return Band();
 }
 
 QList<Band> Data::bandsList(const bool onlyDXCCBands, const bool onlyEnabled)
@@ -681,6 +723,27 @@ QString Data::removeAccents(const QString &input)
     /* https://www.medo64.com/2020/10/stripping-diacritics-in-qt/ */
     /* More about normalization https://unicode.org/reports/tr15/ */
 
+    bool isASCII = true;
+
+    for ( const QChar &c : input )
+    {
+        if ( c.unicode() > 0x7F )
+        {
+            isASCII = false;
+            break;
+        }
+    }
+
+    /* ASCII string does not contain any accents - normalization is not needed */
+    if ( isASCII )
+    {
+        QString ret(input);
+        ret.remove(QLatin1Char('?'));
+
+        /* If stripped string is empty then QString to store NULL value do DB */
+        return ( ret.isEmpty() ) ? QString() : ret;
+    }
+
     QString formD = input.normalized(QString::NormalizationForm_D);
 
     QString filtered;
@@ -766,6 +829,13 @@ QString Data::getIANATimeZone(double lat, double lon)
 
     QString ret;
 
+    /* TZ Database is loaded on the first use */
+    if ( !zdLoadTried )
+    {
+        zdLoadTried = true;
+        loadTZ();
+    }
+
     if ( zd )
     {
         ret = ZDHelperSimpleLookupString(zd,
@@ -882,55 +952,39 @@ void Data::loadSatModes()
     }
 }
 
-void Data::loadIOTA()
+void Data::loadDxccPrefixes()
 {
     FCT_IDENTIFICATION;
 
-    QSqlQuery query("SELECT iotaid, islandname FROM iota");
-
-    while ( query.next() )
-    {
-        QString iotaID = query.value(0).toString();
-        QString islandName = query.value(1).toString();
-        iotaRef.insert(iotaID, islandName);
-    }
-}
-
-void Data::loadSOTA()
-{
-    FCT_IDENTIFICATION;
+    QWriteLocker locker(&dxccPrefixIndexLock);
 
-    QSqlQuery query("SELECT summit_code FROM sota_summits");
+    const int generation = dxccPrefixGeneration.loadAcquire();
 
-    while ( query.next() )
+    if ( dxccPrefixIndexGeneration.loadAcquire() == generation )
     {
-        QString summitCode = query.value(0).toString();
-        sotaRefID.insert(summitCode, QString());
+        // reloaded by another thread
+        return;
     }
-}
 
-void Data::loadWWFF()
-{
-    QSqlQuery query("SELECT reference FROM wwff_directory");
+    dxccLookupCache.clear();
 
-    while ( query.next() )
+    if ( ! dxccPrefixIndex.load(readConnection()->db) )
     {
-        QString reference = query.value(0).toString();
-        wwffRefID.insert(reference, QString());
+        // the generation is not published - the next lookup tries it again
+        qWarning() << "Cannot load DXCC Prefixes";
+        return;
     }
+
+    /* the generation is read before loading - a refresh during the loading
+     * causes the next reload */
+    dxccPrefixIndexGeneration.storeRelease(generation);
 }
 
-void Data::loadPOTA()
+void Data::invalidateDxccPrefixes()
 {
     FCT_IDENTIFICATION;
 
-    QSqlQuery query("SELECT reference FROM pota_directory");
-
-    while ( query.next() )
-    {
-        QString reference = query.value(0).toString();
-        potaRefID.insert(reference, QString());
-    }
+    dxccPrefixGeneration.fetchAndAddRelease(1);
 }
 
 void Data::loadTZ()
@@ -959,37 +1013,28 @@ void Data::loadTZ()
 DxccEntity Data::lookupDxcc(const QString &callsign)
 {
     FCT_IDENTIFICATION;
-    static QCache<QString, DxccEntity> localCache(1000);
 
     qCDebug(function_parameters) << callsign;
 
     if ( callsign.isEmpty())
         return  DxccEntity();
 
-    DxccEntity dxccRet;
-    DxccEntity * dxccCached = localCache.object(callsign);
+    /* CTY file was refreshed */
+    if ( dxccPrefixIndexGeneration.loadAcquire() != dxccPrefixGeneration.loadAcquire() )
+    {
+        loadDxccPrefixes();
+    }
+
+    QSharedPointer<const DxccEntity> dxccCached = dxccLookupCache.object(callsign);
 
     if ( dxccCached )
     {
-        dxccRet.dxcc = dxccCached->dxcc;
-        dxccRet.country = dxccCached->country;
-        dxccRet.prefix = dxccCached->prefix;
-        dxccRet.cont = dxccCached->cont;
-        dxccRet.cqz = dxccCached->cqz;
-        dxccRet.ituz = dxccCached->ituz;
-        dxccRet.latlon[0] = dxccCached->latlon[0];
-        dxccRet.latlon[1] = dxccCached->latlon[1];
-        dxccRet.tz = dxccCached->tz;
-        dxccRet.flag = dxccCached->flag;
+        return *dxccCached;
     }
-    else
-    {
-        if ( ! isDXCCQueryValid )
-        {
-            qWarning() << "Cannot prepare Select statement";
-            return DxccEntity();
-        }
 
+    DxccEntity dxccRet;
+
+    {
         QString lookupPrefix = callsign; // use the callsign with optional prefix as default to find the dxcc
         Callsign parsedCallsign(callsign); // use Callsign to split the callsign into its parts
 
@@ -1012,44 +1057,18 @@ DxccEntity Data::lookupDxcc(const QString &callsign)
             }
         }
 
-        queryDXCC.bindValue(":callsign", lookupPrefix);
+        QReadLocker locker(&dxccPrefixIndexLock);
 
-        if ( ! queryDXCC.exec() )
+        if ( ! dxccPrefixIndex.isLoaded() )
         {
-            qWarning() << "Cannot execute Select statement" << queryDXCC.lastError() << queryDXCC.lastQuery();
+            qWarning() << "DXCC Prefix Index is not loaded";
             return DxccEntity();
         }
-        if (queryDXCC.next())
+
+        if ( dxccPrefixIndex.lookup(lookupPrefix, dxccRet) )
         {
-            dxccRet.dxcc = queryDXCC.value(0).toInt();
-            dxccRet.country = queryDXCC.value(1).toString();
-            dxccRet.prefix = queryDXCC.value(2).toString();
-            dxccRet.cont = queryDXCC.value(3).toString();
-            dxccRet.cqz = queryDXCC.value(4).toInt();
-            dxccRet.ituz = queryDXCC.value(5).toInt();
-            dxccRet.latlon[0] = queryDXCC.value(6).toDouble();
-            dxccRet.latlon[1] = queryDXCC.value(7).toDouble();
-            dxccRet.tz = queryDXCC.value(8).toFloat();
             dxccRet.flag = flags.value(dxccRet.dxcc);
-
-            dxccCached = new DxccEntity;
-
-            if ( dxccCached )
-            {
-
-                dxccCached->dxcc = dxccRet.dxcc;
-                dxccCached->country = dxccRet.country;
-                dxccCached->prefix = dxccRet.prefix;
-                dxccCached->cont = dxccRet.cont;
-                dxccCached->cqz = dxccRet.cqz;
-                dxccCached->ituz = dxccRet.ituz;
-                dxccCached->latlon[0] = dxccRet.latlon[0];
-                dxccCached->latlon[1] = dxccRet.latlon[1];
-                dxccCached->tz = dxccRet.tz;
-                dxccCached->flag = dxccRet.flag;
-
-                localCache.insert(callsign, dxccCached);
-            }
+            dxccLookupCache.insert(callsign, dxccRet);
         }
         else
         {
@@ -1067,12 +1086,24 @@ SOTAEntity Data::lookupSOTA(const QString &SOTACode)
 {
     FCT_IDENTIFICATION;
 
-    if ( ! isSOTAQueryValid )
+    const QString cacheKey = SOTACode.toUpper();
+    QSharedPointer<const SOTAEntity> cached = sotaLookupCache.object(cacheKey);
+
+    if ( cached )
+    {
+        return *cached;
+    }
+
+    ReadConnection *connection = readConnection();
+
+    if ( ! connection->isSOTAQueryValid )
     {
         qWarning() << "Cannot prepare Select statement";
         return SOTAEntity();
     }
 
+    QSqlQuery &querySOTA = connection->querySOTA;
+
     querySOTA.bindValue(":code", SOTACode);
 
     if ( ! querySOTA.exec() )
@@ -1099,6 +1130,7 @@ SOTAEntity Data::lookupSOTA(const QString &SOTACode)
         SOTARet.bonusPoints = querySOTA.value(11).toInt();
         SOTARet.validFrom = querySOTA.value(12).toDate();
         SOTARet.validTo = querySOTA.value(13).toDate();
+        sotaLookupCache.insert(cacheKey, SOTARet);
     }
     else
     {
@@ -1119,12 +1151,24 @@ POTAEntity Data::lookupPOTA(const QString &POTACode)
 {
     FCT_IDENTIFICATION;
 
-    if ( ! isPOTAQueryValid )
+    const QString cacheKey = POTACode.toUpper();
+    QSharedPointer<const POTAEntity> cached = potaLookupCache.object(cacheKey);
+
+    if ( cached )
+    {
+        return *cached;
+    }
+
+    ReadConnection *connection = readConnection();
+
+    if ( ! connection->isPOTAQueryValid )
     {
         qWarning() << "Cannot prepare Select statement";
         return POTAEntity();
     }
 
+    QSqlQuery &queryPOTA = connection->queryPOTA;
+
     queryPOTA.bindValue(":code", POTACode);
 
     if ( ! queryPOTA.exec() )
@@ -1145,6 +1189,7 @@ POTAEntity Data::lookupPOTA(const QString &POTACode)
         POTARet.longitude = queryPOTA.value(5).toDouble();
         POTARet.latitude = queryPOTA.value(6).toDouble();
         POTARet.grid = queryPOTA.value(7).toString();
+        potaLookupCache.insert(cacheKey, POTARet);
     }
     else
     {
@@ -1161,12 +1206,24 @@ WWFFEntity Data::lookupWWFF(const QString &reference)
 {
     FCT_IDENTIFICATION;
 
-    if ( ! isWWFFQueryValid )
+    const QString cacheKey = reference.toUpper();
+    QSharedPointer<const WWFFEntity> cached = wwffLookupCache.object(cacheKey);
+
+    if ( cached )
+    {
+        return *cached;
+    }
+
+    ReadConnection *connection = readConnection();
+
+    if ( ! connection->isWWFFQueryValid )
     {
         qWarning() << "Cannot prepare Select statement";
         return WWFFEntity();
     }
 
+    QSqlQuery &queryWWFF = connection->queryWWFF;
+
     queryWWFF.bindValue(":reference", reference);
 
     if ( ! queryWWFF.exec() )
@@ -1194,6 +1251,7 @@ WWFFEntity Data::lookupWWFF(const QString &reference)
         WWFFRet.iucncat = queryWWFF.value(12).toString();
         WWFFRet.validFrom = queryWWFF.value(13).toDate();
         WWFFRet.validTo = queryWWFF.value(14).toDate();
+        wwffLookupCache.insert(cacheKey, WWFFRet);
     }
     else
     {
@@ -1211,9 +1269,183 @@ QString Data::dxccFlag(int dxcc) {
     return flags.value(dxcc);
 }
 
+QMap<QString, LookupCacheStats> Data::lookupCacheStats() const
+{
+    FCT_IDENTIFICATION;
+
+    QMap<QString, LookupCacheStats> ret;
+
+    ret.insert("dxcc", dxccLookupCache.stats());
+    ret.insert("sota", sotaLookupCache.stats());
+    ret.insert("pota", potaLookupCache.stats());
+    ret.insert("wwff", wwffLookupCache.stats());
+
+    return ret;
+}
+
+void Data::loadDxccStatus()
+{
+    FCT_IDENTIFICATION;
+
+    QWriteLocker locker(&dxccStatusIndexLock);
+
+    const int generation = dxccStatusGeneration.loadAcquire();
+
+    if ( dxccStatusIndexGeneration.loadAcquire() == generation )
+    {
+        // reloaded by another thread
+        return;
+    }
+
+    QSettings settings;
+    const QVariant start = settings.value("dxcc/start");
+
+    if ( ! dxccStatusIndex.load(( start.isNull() ) ? QDate() : start.toDate(),
+                                readConnection()->db) )
+    {
+        // the generation is not published - the next query tries it again
+        qWarning() << "Cannot load DXCC Status Index";
+        return;
+    }
+
+    /* the generation is read before loading - a change during the loading
+     * causes the next reload */
+    dxccStatusIndexGeneration.storeRelease(generation);
+}
+
+void Data::loadBandPlan()
+{
+    FCT_IDENTIFICATION;
+
+    QWriteLocker locker(&bandPlanLock);
+
+    const int generation = bandsGeneration.loadAcquire();
+
+    if ( bandPlanGeneration.loadAcquire() == generation )
+    {
+        // reloaded by another thread
+        return;
+    }
+
+    QSqlQuery query(readConnection()->db);
+
+    if ( ! query.exec("SELECT name, start_freq, end_freq FROM bands ORDER BY start_freq, id") )
+    {
+        // the previous plan is kept and the generation is not published - the next query tries it again
+        qWarning() << "Cannot load Bands" << query.lastError();
+        return;
+    }
+
+    QVector<Band> plan;
+    QVector<double> planMaxEnd;
+    double maxEnd = 0.0;
+
+    while ( query.next() )
+    {
+        Band band;
+        band.name = query.value(0).toString();
+        band.start = query.value(1).toDouble();
+        band.end = query.value(2).toDouble();
+        maxEnd = qMax(maxEnd, band.end);
+        plan.append(band);
+        planMaxEnd.append(maxEnd);
+    }
+
+    bandPlan.swap(plan);
+    bandPlanMaxEnd.swap(planMaxEnd);
+
+    /* the generation is read before loading - a change during the loading
+     * causes the next reload */
+    bandPlanGeneration.storeRelease(generation);
+
+    qCDebug(runtime) << "Loaded" << bandPlan.size() << "bands";
+}
+
+void Data::invalidateBands()
+{
+    FCT_IDENTIFICATION;
+
+    bandsGeneration.fetchAndAddRelease(1);
+}
+
+void Data::invalidateDxccStatus()
+{
+    FCT_IDENTIFICATION;
+
+    dxccStatusGeneration.fetchAndAddRelease(1);
+}
+
+void Data::updateDxccStatusContact(qlonglong contactID, const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contactID;
+
+    QWriteLocker locker(&dxccStatusIndexLock);
+
+    if ( ! dxccStatusIndex.isLoaded() )
+    {
+        return;
+    }
+
+    dxccStatusIndex.updateContact(contactID,
+                                  record.value("dxcc"),
+                                  record.value("band").toString(),
+                                  record.value("mode").toString(),
+                                  record.value("start_time").toDateTime(),
+                                  ( record.value("qsl_rcvd").toString() == "Y"
+                                    || record.value("lotw_qsl_rcvd").toString() == "Y" ));
+}
+
+void Data::removeDxccStatusContact(qlonglong contactID)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contactID;
+
+    QWriteLocker locker(&dxccStatusIndexLock);
+
+    dxccStatusIndex.removeContact(contactID);
+}
+
+void Data::confirmDxccStatusContacts(const QList<qlonglong> &contactIDs)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contactIDs.size();
+
+    QWriteLocker locker(&dxccStatusIndexLock);
+
+    for ( qlonglong contactID : contactIDs )
+    {
+        dxccStatusIndex.confirmContact(contactID);
+    }
+}
+
+void Data::dxccStatusContactSaved(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    updateDxccStatusContact(record.value("id").toLongLong(), record);
+}
+
+void Data::dxccStatusContactDeleted(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    removeDxccStatusContact(record.value("id").toLongLong());
+}
+
+QAtomicInt Data::dxccPrefixGeneration(0);
+QAtomicInt Data::dxccStatusGeneration(0);
+QAtomicInt Data::bandsGeneration(0);
+
 const QString Data::MODE_CW = "CW";
 const QString Data::MODE_DIGITAL = "DIGITAL";
 const QString Data::MODE_FT8 = "FT8";
 const QString Data::MODE_LSB = "PHONE"; // use just generic label
 const QString Data::MODE_USB = "PHONE"; // use just generic label
 const QString Data::MODE_PHONE = "PHONE";
+
+const QString Data::CONFIG_DXCC_CACHE_CAPACITY_KEY = "data/dxcc_cache_capacity";
+const QString Data::CONFIG_REFERENCE_CACHE_CAPACITY_KEY = "data/reference_cache_capacity";
@@ -3,13 +3,19 @@
 
 #include <QtCore>
 #include <QSqlQuery>
+#include <QSqlDatabase>
 #include "Dxcc.h"
 #include "SOTAEntity.h"
 #include "WWFFEntity.h"
 #include "POTAEntity.h"
 #include "Band.h"
+#include "DxccPrefixIndex.h"
+#include "DxccStatusIndex.h"
+#include "core/LookupCache.h"
 #include "core/zonedetect.h"
 
+class QSqlRecord;
+
 class Data : public QObject
 {
     Q_OBJECT
@@ -20,6 +26,8 @@ public:
     static const QString MODE_LSB; // use just generic label SSB
     static const QString MODE_USB; // use just generic label SSB
     static const QString MODE_PHONE;
+    static const QString CONFIG_DXCC_CACHE_CAPACITY_KEY;
+    static const QString CONFIG_REFERENCE_CACHE_CAPACITY_KEY;
 
     const QMap<QString, QString> qslSentEnum = {
         {"Y", tr("Yes")},
@@ -91,6 +99,9 @@ public:
     static int getCQZMin();
     static int getCQZMax();
     static QString dbFilename();
+    static void invalidateDxccPrefixes();
+    static void invalidateDxccStatus();
+    static void invalidateBands();
 
     QStringList contestList() { return contests.values(); }
     QStringList propagationModesList() { return propagationModes.values(); }
@@ -107,17 +118,17 @@ public:
     QStringList satModesIDList() { return satModes.keys(); }
     QString satModeTextToID(const QString &satModeText) { return satModes.key(satModeText);}
     QString satModeIDToText(const QString &satModeID) { return satModes.value(satModeID);}
-    QStringList iotaList() { return iotaRef.values();}
-    QStringList iotaIDList() { return iotaRef.keys();}
-    QString iotaTextToID(const QString &iotaText) { return iotaRef.key(iotaText);}
-    QStringList sotaIDList() { return sotaRefID.keys();}
-    QStringList wwffIDList() { return wwffRefID.keys();}
-    QStringList potaIDList() { return potaRefID.keys();}
     QString getIANATimeZone(double, double);
+    QMap<QString, LookupCacheStats> lookupCacheStats() const;
+    void updateDxccStatusContact(qlonglong contactID, const QSqlRecord &record);
+    void removeDxccStatusContact(qlonglong contactID);
+    void confirmDxccStatusContacts(const QList<qlonglong> &contactIDs);
 
 signals:
 
 public slots:
+    void dxccStatusContactSaved(const QSqlRecord &record);
+    void dxccStatusContactDeleted(const QSqlRecord &record);
 
 private:
     void loadContests();
@@ -125,30 +136,61 @@ private:
     void loadLegacyModes();
     void loadDxccFlags();
     void loadSatModes();
-    void loadIOTA();
-    void loadSOTA();
-    void loadWWFF();
-    void loadPOTA();
     void loadTZ();
+    void loadDxccPrefixes();
+    void loadDxccStatus();
+    void loadBandPlan();
+
+    /* Reference data are read via the main DB connection in the GUI thread.
+     * Other threads (import, DX Cluster ingest) get their own read connection
+     * with prepared lookup queries. It is created by the first lookup in the
+     * thread and removed when the thread finishes */
+    class ReadConnection
+    {
+    public:
+        explicit ReadConnection(const QString &connectionName);
+        ~ReadConnection();
+
+        QSqlDatabase db;
+        QSqlQuery querySOTA;
+        QSqlQuery queryWWFF;
+        QSqlQuery queryPOTA;
+        bool isSOTAQueryValid;
+        bool isWWFFQueryValid;
+        bool isPOTAQueryValid;
+
+    private:
+        QString connectionName;
+    };
+
+    ReadConnection *readConnection();
 
     QMap<int, QString> flags;
     QMap<QString, QString> contests;
     QMap<QString, QString> propagationModes;
     QMap<QString, QPair<QString, QString>> legacyModes;
     QMap<QString, QString> satModes;
-    QMap<QString, QString> iotaRef;
-    QMap<QString, QString> sotaRefID;
-    QMap<QString, QString> wwffRefID;
-    QMap<QString, QString> potaRefID;
     ZoneDetect * zd;
-    QSqlQuery queryDXCC;
-    QSqlQuery querySOTA;
-    QSqlQuery queryWWFF;
-    QSqlQuery queryPOTA;
-    bool isDXCCQueryValid;
-    bool isSOTAQueryValid;
-    bool isWWFFQueryValid;
-    bool isPOTAQueryValid;
+    bool zdLoadTried;
+    DxccPrefixIndex dxccPrefixIndex;
+    QReadWriteLock dxccPrefixIndexLock;
+    QAtomicInt dxccPrefixIndexGeneration;
+    static QAtomicInt dxccPrefixGeneration;
+    DxccStatusIndex dxccStatusIndex;
+    QReadWriteLock dxccStatusIndexLock;
+    QAtomicInt dxccStatusIndexGeneration;
+    static QAtomicInt dxccStatusGeneration;
+    QVector<Band> bandPlan;  // sorted by start frequency
+    QVector<double> bandPlanMaxEnd; // the highest end frequency up to the index
+    QReadWriteLock bandPlanLock;
+    QAtomicInt bandPlanGeneration;
+    static QAtomicInt bandsGeneration;
+    LookupCache<QString, DxccEntity> dxccLookupCache;
+    LookupCache<QString, SOTAEntity> sotaLookupCache;
+    LookupCache<QString, POTAEntity> potaLookupCache;
+    LookupCache<QString, WWFFEntity> wwffLookupCache;
+    QTimer lookupCacheStatsTimer;
+    QThreadStorage<ReadConnection *> readConnections;
 };
 
 #endif // DATA_H
@@ -44,4 +44,6 @@ public:
 
 };
 
+Q_DECLARE_METATYPE(DxSpot)
+
 #endif // DXSPOT_H
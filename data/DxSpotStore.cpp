@@ -0,0 +1,131 @@
+#include "DxSpotStore.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxspotstore");
+
+DxSpotStore::DxSpotStore(int capacity) :
+    storeCapacity(qMax(capacity, 1)),
+    firstSequence(0),
+    nextSequence(0)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << capacity;
+}
+
+int DxSpotStore::count() const
+{
+    return static_cast<int>(nextSequence - firstSequence);
+}
+
+int DxSpotStore::capacity() const
+{
+    return storeCapacity;
+}
+
+const DxSpot &DxSpotStore::at(int row) const
+{
+    return ring.at(position(nextSequence - 1 - row));
+}
+
+void DxSpotStore::prepend(const DxSpot &spot)
+{
+    FCT_IDENTIFICATION;
+
+    if ( count() == storeCapacity )
+    {
+        removeOldest(1);
+    }
+
+    const int index = position(nextSequence);
+
+    /* the ring grows up to its capacity, then the free slots are reused */
+    if ( index == ring.size() )
+    {
+        ring.append(spot);
+    }
+    else
+    {
+        ring[index] = spot;
+    }
+
+    callsignIndex.insert(spot.callsign, nextSequence);
+    nextSequence++;
+}
+
+void DxSpotStore::removeOldest(int number)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << number;
+
+    number = qMin(number, count());
+
+    for ( int i = 0; i < number; i++ )
+    {
+        DxSpot &spot = ring[position(firstSequence)];
+
+        callsignIndex.remove(spot.callsign, firstSequence);
+
+        // release the spot's data; the slot is reused later
+        spot = DxSpot();
+        firstSequence++;
+    }
+}
+
+int DxSpotStore::countOlderThan(const QDateTime &time) const
+{
+    FCT_IDENTIFICATION;
+
+    int ret = 0;
+
+    /* spots are stored in the time order; the search starts from the oldest spot */
+    for ( quint64 sequence = firstSequence; sequence < nextSequence; sequence++ )
+    {
+        if ( ring.at(position(sequence)).time >= time )
+        {
+            break;
+        }
+        ret++;
+    }
+
+    return ret;
+}
+
+bool DxSpotStore::isDuplicate(const DxSpot &spot,
+                              qint64 interval,
+                              double freqTolerance) const
+{
+    FCT_IDENTIFICATION;
+
+    const auto range = callsignIndex.equal_range(spot.callsign);
+
+    for ( auto it = range.first; it != range.second; ++it )
+    {
+        const DxSpot &record = ring.at(position(it.value()));
+
+        if ( record.time.secsTo(spot.time) <= interval
+             && qAbs(record.freq - spot.freq) < freqTolerance )
+        {
+            qCDebug(runtime) << "Duplicate spot" << record.callsign << record.freq <<  spot.callsign << spot.freq;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void DxSpotStore::clear()
+{
+    FCT_IDENTIFICATION;
+
+    ring.clear();
+    callsignIndex.clear();
+    firstSequence = 0;
+    nextSequence = 0;
+}
+
+int DxSpotStore::position(quint64 sequence) const
+{
+    return static_cast<int>(sequence % storeCapacity);
+}
@@ -0,0 +1,37 @@
+#ifndef DXSPOTSTORE_H
+#define DXSPOTSTORE_H
+
+#include <QtCore>
+#include "DxSpot.h"
+
+/* Bounded store of DX Spots. Spots are kept in a fixed-capacity ring buffer
+ * ordered from the newest (row 0) to the oldest. When the store is full,
+ * the oldest spot is overwritten. A callsign index allows
+ * to find duplicate spots without walking the whole store. */
+class DxSpotStore
+{
+public:
+    explicit DxSpotStore(int capacity);
+
+    int count() const;
+    int capacity() const;
+    const DxSpot &at(int row) const;
+    void prepend(const DxSpot &spot);
+    void removeOldest(int number);
+    int countOlderThan(const QDateTime &time) const;
+    bool isDuplicate(const DxSpot &spot,
+                     qint64 interval,
+                     double freqTolerance) const;
+    void clear();
+
+private:
+    int position(quint64 sequence) const;
+
+    QVector<DxSpot> ring;
+    QMultiHash<QString, quint64> callsignIndex;
+    const int storeCapacity;
+    quint64 firstSequence;
+    quint64 nextSequence;
+};
+
+#endif // DXSPOTSTORE_H
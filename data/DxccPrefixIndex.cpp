@@ -0,0 +1,168 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <algorithm>
+#include "DxccPrefixIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxccprefixindex");
+
+DxccPrefixIndex::DxccPrefixIndex() :
+    loaded(false)
+{
+    FCT_IDENTIFICATION;
+}
+
+bool DxccPrefixIndex::load(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    entities.clear();
+    prefixes.clear();
+    exactPrefixes.clear();
+    loaded = false;
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if ( ! query.exec("SELECT id, name, prefix, cont, cqz, ituz, lat, lon, tz "
+                      "FROM dxcc_entities") )
+    {
+        qWarning() << "Cannot load DXCC Entities" << query.lastError();
+        return false;
+    }
+
+    QHash<qint32, int> entityIndexes;
+
+    while ( query.next() )
+    {
+        DxccEntity entity;
+        entity.dxcc = query.value(0).toInt();
+        entity.country = query.value(1).toString();
+        entity.prefix = query.value(2).toString();
+        entity.cont = query.value(3).toString();
+        entity.cqz = query.value(4).toInt();
+        entity.ituz = query.value(5).toInt();
+        entity.latlon[0] = query.value(6).toDouble();
+        entity.latlon[1] = query.value(7).toDouble();
+        entity.tz = query.value(8).toFloat();
+
+        entityIndexes.insert(entity.dxcc, entities.size());
+        entities.append(entity);
+    }
+
+    if ( ! query.exec("SELECT prefix, exact, dxcc, cqz, ituz "
+                      "FROM dxcc_prefixes") )
+    {
+        qWarning() << "Cannot load DXCC Prefixes" << query.lastError();
+        entities.clear();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        const qint32 dxcc = query.value(2).toInt();
+
+        if ( !entityIndexes.contains(dxcc) )
+        {
+            // the same as INNER JOIN
+            continue;
+        }
+
+        PrefixEntry entry;
+        entry.prefix = query.value(0).toString();
+        entry.entityIndex = entityIndexes.value(dxcc);
+        entry.cqz = query.value(3).toInt();
+        entry.ituz = query.value(4).toInt();
+
+        if ( query.value(1).toBool() )
+        {
+            exactPrefixes.insert(entry.prefix, entry);
+        }
+        else
+        {
+            // LIKE operator is case-insensitive
+            entry.prefix = entry.prefix.toUpper();
+            prefixes.append(entry);
+        }
+    }
+
+    std::sort(prefixes.begin(), prefixes.end());
+
+    loaded = true;
+
+    qCDebug(runtime) << "DXCC Prefix Index loaded:"
+                     << entities.size() << "entities,"
+                     << prefixes.size() << "prefixes,"
+                     << exactPrefixes.size() << "exact prefixes";
+    return true;
+}
+
+bool DxccPrefixIndex::isLoaded() const
+{
+    return loaded;
+}
+
+bool DxccPrefixIndex::lookup(const QString &callsign, DxccEntity &entity) const
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign;
+
+    QHash<QString, PrefixEntry>::const_iterator exact = exactPrefixes.constFind(callsign);
+
+    if ( exact != exactPrefixes.constEnd() )
+    {
+        fillEntity(exact.value(), entity);
+        return true;
+    }
+
+    /* Longest prefix match */
+    const QString upperCallsign = callsign.toUpper();
+    const QStringView callsignView(upperCallsign);
+
+    for ( int len = callsignView.size(); len > 0; len-- )
+    {
+        const QStringView key = callsignView.left(len);
+
+        QVector<PrefixEntry>::const_iterator it = std::lower_bound(prefixes.constBegin(),
+                                                                   prefixes.constEnd(),
+                                                                   key,
+                                                                   [](const PrefixEntry &entry,
+                                                                      const QStringView &value)
+        {
+            return QStringView(entry.prefix).compare(value) < 0;
+        });
+
+        if ( it != prefixes.constEnd()
+             && QStringView(it->prefix).compare(key) == 0 )
+        {
+            fillEntity(*it, entity);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int DxccPrefixIndex::count() const
+{
+    return prefixes.size() + exactPrefixes.size();
+}
+
+void DxccPrefixIndex::fillEntity(const PrefixEntry &prefixEntry, DxccEntity &entity) const
+{
+    const DxccEntity &dxccEntity = entities.at(prefixEntry.entityIndex);
+
+    entity = dxccEntity;
+
+    /* prefix-specific zones override entity zones */
+    if ( prefixEntry.cqz != 0 )
+    {
+        entity.cqz = prefixEntry.cqz;
+    }
+
+    if ( prefixEntry.ituz != 0 )
+    {
+        entity.ituz = prefixEntry.ituz;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef DXCCPREFIXINDEX_H
+#define DXCCPREFIXINDEX_H
+
+#include <QtCore>
+#include <QSqlDatabase>
+#include "Dxcc.h"
+
+/* In-memory copy of dxcc_prefixes/dxcc_entities tables used to resolve
+ * a callsign (prefix) to DXCC Entity without SQL.
+ * Exact prefixes are stored in a hash, other prefixes in a sorted array
+ * where the longest matching prefix is searched by binary search */
+class DxccPrefixIndex
+{
+public:
+    DxccPrefixIndex();
+
+    bool load(const QSqlDatabase &db = QSqlDatabase::database());
+    bool isLoaded() const;
+    bool lookup(const QString &callsign, DxccEntity &entity) const;
+    int count() const;
+
+private:
+    struct PrefixEntry
+    {
+        QString prefix;
+        int entityIndex;
+        qint32 cqz;
+        qint32 ituz;
+
+        bool operator<(const PrefixEntry &other) const
+        {
+            return prefix < other.prefix;
+        }
+    };
+
+    void fillEntity(const PrefixEntry &prefixEntry, DxccEntity &entity) const;
+
+    QVector<DxccEntity> entities;
+    QVector<PrefixEntry> prefixes;
+    QHash<QString, PrefixEntry> exactPrefixes;
+    bool loaded;
+};
+
+#endif // DXCCPREFIXINDEX_H
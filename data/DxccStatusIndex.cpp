@@ -0,0 +1,308 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include "DxccStatusIndex.h"
+#include "Data.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxccstatusindex");
+
+DxccStatusIndex::DxccStatusIndex() :
+    loaded(false)
+{
+    FCT_IDENTIFICATION;
+}
+
+bool DxccStatusIndex::load(const QDate &inStartDate, const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << inStartDate;
+
+    modeGroups.clear();
+    contacts.clear();
+    entityCounters.clear();
+    bandCounters.clear();
+    modeCounters.clear();
+    slotCounters.clear();
+    startDate = inStartDate;
+    loaded = false;
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if ( ! query.exec("SELECT name, dxcc FROM modes") )
+    {
+        qWarning() << "Cannot load Modes" << query.lastError();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        modeGroups.insert(query.value(0).toString(), query.value(1).toString());
+    }
+
+    QString filter;
+
+    if ( startDate.isValid() )
+    {
+        filter = " AND start_time >= :start_date";
+    }
+
+    if ( ! query.prepare("SELECT id, dxcc, band, mode, qsl_rcvd, lotw_qsl_rcvd "
+                         "FROM contacts "
+                         "WHERE dxcc IS NOT NULL" + filter) )
+    {
+        qWarning() << "Cannot prepare Select statement" << query.lastError();
+        return false;
+    }
+
+    if ( startDate.isValid() )
+    {
+        query.bindValue(":start_date", startDate.toString("yyyy-MM-dd"));
+    }
+
+    if ( ! query.exec() )
+    {
+        qWarning() << "Cannot load Contacts" << query.lastError();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        ContactEntry entry;
+        entry.dxcc = query.value(1).toInt();
+        entry.band = query.value(2).toString();
+        entry.dxccMode = modeGroups.value(query.value(3).toString());
+        entry.confirmed = ( query.value(4).toString() == "Y"
+                            || query.value(5).toString() == "Y" );
+
+        contacts.insert(query.value(0).toLongLong(), entry);
+        addEntry(entry);
+    }
+
+    loaded = true;
+
+    qCDebug(runtime) << "Loaded" << contacts.size() << "contacts";
+
+    return true;
+}
+
+bool DxccStatusIndex::isLoaded() const
+{
+    FCT_IDENTIFICATION;
+
+    return loaded;
+}
+
+DxccStatus DxccStatusIndex::status(int dxcc, const QString &band, const QString &mode) const
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << dxcc << band << mode;
+
+    if ( !entityCounters.contains(dxcc) )
+    {
+        return DxccStatus::NewEntity;
+    }
+
+    const QString dxccModeGroup = dxccMode(mode);
+    const bool bandWorked = bandCounters.contains(EntityKey(dxcc, band));
+    const bool modeWorked = !dxccModeGroup.isEmpty()
+                            && modeCounters.contains(EntityKey(dxcc, dxccModeGroup));
+
+    if ( !bandWorked )
+    {
+        return ( modeWorked ) ? DxccStatus::NewBand : DxccStatus::NewBandMode;
+    }
+
+    if ( !modeWorked )
+    {
+        return DxccStatus::NewMode;
+    }
+
+    const auto slot = slotCounters.constFind(EntityKey(dxcc, slotKey(band, dxccModeGroup)));
+
+    if ( slot == slotCounters.constEnd() )
+    {
+        return DxccStatus::NewSlot;
+    }
+
+    return ( slot->confirmed > 0 ) ? DxccStatus::Confirmed : DxccStatus::Worked;
+}
+
+void DxccStatusIndex::updateContact(qlonglong contactID,
+                                    const QVariant &dxcc,
+                                    const QString &band,
+                                    const QString &mode,
+                                    const QDateTime &startTime,
+                                    bool confirmed)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contactID << dxcc << band << mode << startTime << confirmed;
+
+    removeContact(contactID);
+
+    bool isDxccValid = false;
+    const int dxccValue = dxcc.toInt(&isDxccValid);
+
+    if ( !isDxccValid )
+    {
+        return;
+    }
+
+    if ( startDate.isValid() && startTime.date() < startDate )
+    {
+        return;
+    }
+
+    ContactEntry entry;
+    entry.dxcc = dxccValue;
+    entry.band = band;
+    entry.dxccMode = modeGroups.value(mode);
+    entry.confirmed = confirmed;
+
+    contacts.insert(contactID, entry);
+    addEntry(entry);
+}
+
+void DxccStatusIndex::removeContact(qlonglong contactID)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contactID;
+
+    auto it = contacts.find(contactID);
+
+    if ( it == contacts.end() )
+    {
+        return;
+    }
+
+    removeEntry(it.value());
+    contacts.erase(it);
+}
+
+void DxccStatusIndex::confirmContact(qlonglong contactID)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contactID;
+
+    auto it = contacts.find(contactID);
+
+    if ( it == contacts.end() || it->confirmed )
+    {
+        return;
+    }
+
+    removeEntry(it.value());
+    it->confirmed = true;
+    addEntry(it.value());
+}
+
+int DxccStatusIndex::count() const
+{
+    FCT_IDENTIFICATION;
+
+    return contacts.size();
+}
+
+QString DxccStatusIndex::slotKey(const QString &band, const QString &dxccMode)
+{
+    return band + QLatin1Char('|') + dxccMode;
+}
+
+QString DxccStatusIndex::dxccMode(const QString &mode) const
+{
+    FCT_IDENTIFICATION;
+
+    if ( mode == Data::MODE_CW
+         || mode == Data::MODE_PHONE
+         || mode == Data::MODE_DIGITAL )
+    {
+        return mode;
+    }
+
+    return modeGroups.value(mode);
+}
+
+void DxccStatusIndex::addEntry(const ContactEntry &entry)
+{
+    FCT_IDENTIFICATION;
+
+    entityCounters[entry.dxcc]++;
+    bandCounters[EntityKey(entry.dxcc, entry.band)]++;
+
+    /* the contact's mode is not in the modes table - it is not counted
+     * to any mode/slot */
+    if ( entry.dxccMode.isEmpty() )
+    {
+        return;
+    }
+
+    modeCounters[EntityKey(entry.dxcc, entry.dxccMode)]++;
+
+    SlotCounter &slot = slotCounters[EntityKey(entry.dxcc, slotKey(entry.band, entry.dxccMode))];
+    slot.worked++;
+
+    if ( entry.confirmed )
+    {
+        slot.confirmed++;
+    }
+}
+
+void DxccStatusIndex::removeEntry(const ContactEntry &entry)
+{
+    FCT_IDENTIFICATION;
+
+    decrement(entityCounters, entry.dxcc);
+    decrement(bandCounters, EntityKey(entry.dxcc, entry.band));
+
+    if ( entry.dxccMode.isEmpty() )
+    {
+        return;
+    }
+
+    decrement(modeCounters, EntityKey(entry.dxcc, entry.dxccMode));
+
+    const EntityKey key(entry.dxcc, slotKey(entry.band, entry.dxccMode));
+    auto slot = slotCounters.find(key);
+
+    if ( slot == slotCounters.end() )
+    {
+        return;
+    }
+
+    slot->worked--;
+
+    if ( entry.confirmed )
+    {
+        slot->confirmed--;
+    }
+
+    if ( slot->worked <= 0 )
+    {
+        slotCounters.erase(slot);
+    }
+}
+
+void DxccStatusIndex::decrement(QHash<int, int> &counters, int key)
+{
+    auto it = counters.find(key);
+
+    if ( it != counters.end() && --it.value() <= 0 )
+    {
+        counters.erase(it);
+    }
+}
+
+void DxccStatusIndex::decrement(QHash<EntityKey, int> &counters, const EntityKey &key)
+{
+    auto it = counters.find(key);
+
+    if ( it != counters.end() && --it.value() <= 0 )
+    {
+        counters.erase(it);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef DXCCSTATUSINDEX_H
+#define DXCCSTATUSINDEX_H
+
+#include <QtCore>
+#include <QSqlDatabase>
+#include "Dxcc.h"
+
+/* In-memory worked/confirmed matrix used to evaluate DXCC Status without SQL.
+ * Contacts are counted per Entity, Entity/Band, Entity/DXCC Mode and
+ * Entity/Band/DXCC Mode (slot). The counters allow to update the matrix
+ * incrementally when a contact is inserted, changed or deleted. */
+class DxccStatusIndex
+{
+public:
+    DxccStatusIndex();
+
+    bool load(const QDate &startDate,
+              const QSqlDatabase &db = QSqlDatabase::database());
+    bool isLoaded() const;
+    DxccStatus status(int dxcc, const QString &band, const QString &mode) const;
+    void updateContact(qlonglong contactID,
+                       const QVariant &dxcc,
+                       const QString &band,
+                       const QString &mode,
+                       const QDateTime &startTime,
+                       bool confirmed);
+    void removeContact(qlonglong contactID);
+    void confirmContact(qlonglong contactID);
+    int count() const;
+
+private:
+    struct ContactEntry
+    {
+        int dxcc;
+        QString band;
+        QString dxccMode;
+        bool confirmed;
+    };
+
+    struct SlotCounter
+    {
+        int worked = 0;
+        int confirmed = 0;
+    };
+
+    typedef QPair<int, QString> EntityKey;
+
+    static QString slotKey(const QString &band, const QString &dxccMode);
+    QString dxccMode(const QString &mode) const;
+    void addEntry(const ContactEntry &entry);
+    void removeEntry(const ContactEntry &entry);
+    static void decrement(QHash<int, int> &counters, int key);
+    static void decrement(QHash<EntityKey, int> &counters, const EntityKey &key);
+
+    QHash<QString, QString> modeGroups;
+    QHash<qlonglong, ContactEntry> contacts;
+    QHash<int, int> entityCounters;
+    QHash<EntityKey, int> bandCounters;
+    QHash<EntityKey, int> modeCounters;
+    QHash<EntityKey, SlotCounter> slotCounters;
+    QDate startDate;
+    bool loaded;
+};
+
+#endif // DXCCSTATUSINDEX_H
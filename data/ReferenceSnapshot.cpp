@@ -0,0 +1,287 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+#include "ReferenceSnapshot.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.referencesnapshot");
+
+#define SNAPSHOT_MAGIC 0x51524653  // QRFS
+#define SNAPSHOT_VERSION 1
+
+/* Snapshot file layout (native byte order):
+ *   Header
+ *   quint32 offsets[count + 1]  - offsets of strings in the string area
+ *   char strings[]              - UTF-8 encoded reference IDs, sorted */
+
+ReferenceSnapshot::ReferenceSnapshot(Source source) :
+    source(source),
+    mappedData(nullptr),
+    entries(0),
+    offsets(nullptr),
+    strings(nullptr)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << source;
+}
+
+ReferenceSnapshot::~ReferenceSnapshot()
+{
+    FCT_IDENTIFICATION;
+
+    if ( mappedData )
+    {
+        file.unmap(mappedData);
+    }
+}
+
+bool ReferenceSnapshot::load()
+{
+    FCT_IDENTIFICATION;
+
+    if ( isLoaded() )
+    {
+        return true;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QStringList fileNames = snapshotFiles(source);
+
+    /* the first start after an upgrade - the snapshot was not created by LOV Downloader yet */
+    if ( fileNames.isEmpty() )
+    {
+        if ( !build(source) )
+        {
+            return false;
+        }
+        fileNames = snapshotFiles(source);
+    }
+
+    if ( fileNames.isEmpty() )
+    {
+        return false;
+    }
+
+    // the newest snapshot is the last one; remove the older ones
+    const QString fileName = fileNames.takeLast();
+    removeSnapshots(fileNames);
+
+    file.setFileName(fileName);
+
+    if ( !file.open(QIODevice::ReadOnly) )
+    {
+        qWarning() << "Cannot open Reference Snapshot" << fileName << file.errorString();
+        return false;
+    }
+
+    const qint64 size = file.size();
+
+    if ( size < static_cast<qint64>(sizeof(Header) + sizeof(quint32)) )
+    {
+        qWarning() << "Invalid Reference Snapshot size" << fileName;
+        file.close();
+        return false;
+    }
+
+    uchar *data = file.map(0, size);
+
+    /* the mapping stays valid after the file is closed */
+    file.close();
+
+    if ( !data )
+    {
+        qWarning() << "Cannot map Reference Snapshot" << fileName;
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header*>(data);
+    const qint64 offsetsSize = ( static_cast<qint64>(header->count) + 1 ) * sizeof(quint32);
+    const qint64 stringsPosition = sizeof(Header) + offsetsSize;
+
+    if ( header->magic != SNAPSHOT_MAGIC
+         || header->version != SNAPSHOT_VERSION
+         || stringsPosition > size )
+    {
+        qWarning() << "Invalid Reference Snapshot" << fileName;
+        file.unmap(data);
+        return false;
+    }
+
+    const quint32 *snapshotOffsets = reinterpret_cast<const quint32*>(data + sizeof(Header));
+
+    if ( stringsPosition + snapshotOffsets[header->count] > size )
+    {
+        qWarning() << "Truncated Reference Snapshot" << fileName;
+        file.unmap(data);
+        return false;
+    }
+
+    mappedData = data;
+    entries = header->count;
+    offsets = snapshotOffsets;
+    strings = reinterpret_cast<const char*>(data + stringsPosition);
+
+    qCDebug(runtime) << "Reference Snapshot loaded" << fileName
+                     << entries << "entries," << size << "bytes in" << timer.elapsed() << "ms";
+
+    return true;
+}
+
+bool ReferenceSnapshot::isLoaded() const
+{
+    return mappedData != nullptr;
+}
+
+int ReferenceSnapshot::count() const
+{
+    return static_cast<int>(entries);
+}
+
+QString ReferenceSnapshot::at(int index) const
+{
+    if ( index < 0 || static_cast<quint32>(index) >= entries )
+    {
+        return QString();
+    }
+
+    return QString::fromUtf8(strings + offsets[index],
+                             static_cast<int>(offsets[index + 1] - offsets[index]));
+}
+
+bool ReferenceSnapshot::build(Source source, const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << source;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if ( ! query.exec(QString("SELECT DISTINCT %1 FROM %2 WHERE %1 IS NOT NULL").arg(columnName(source),
+                                                                                    tableName(source))) )
+    {
+        qWarning() << "Cannot select references" << query.lastError();
+        return false;
+    }
+
+    QStringList references;
+
+    while ( query.next() )
+    {
+        references << query.value(0).toString();
+    }
+
+    /* the same order as QCompleter::CaseSensitivelySortedModel expects */
+    std::sort(references.begin(), references.end());
+
+    QVector<quint32> snapshotOffsets;
+    QByteArray snapshotStrings;
+
+    snapshotOffsets.reserve(references.size() + 1);
+
+    for ( const QString &reference : qAsConst(references) )
+    {
+        snapshotOffsets << static_cast<quint32>(snapshotStrings.size());
+        snapshotStrings.append(reference.toUtf8());
+    }
+    snapshotOffsets << static_cast<quint32>(snapshotStrings.size());
+
+    const Header header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, static_cast<quint32>(references.size())};
+
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+    const QString fileName = dir.filePath(QString("%1.%2.snapshot").arg(tableName(source))
+                                          .arg(QDateTime::currentMSecsSinceEpoch(), 13, 10, QChar('0')));
+
+    const QStringList oldFileNames = snapshotFiles(source);
+
+    QSaveFile file(fileName);
+
+    if ( !file.open(QIODevice::WriteOnly) )
+    {
+        qWarning() << "Cannot create Reference Snapshot" << fileName << file.errorString();
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(snapshotOffsets.constData()),
+               snapshotOffsets.size() * sizeof(quint32));
+    file.write(snapshotStrings);
+
+    if ( !file.commit() )
+    {
+        qWarning() << "Cannot write Reference Snapshot" << fileName << file.errorString();
+        return false;
+    }
+
+    // a still mapped snapshot is removed next time
+    removeSnapshots(oldFileNames);
+
+    qCDebug(runtime) << "Reference Snapshot built" << fileName << references.size()
+                     << "entries in" << timer.elapsed() << "ms";
+
+    return true;
+}
+
+QString ReferenceSnapshot::tableName(Source source)
+{
+    switch ( source )
+    {
+    case IOTA: return "iota";
+    case SOTA: return "sota_summits";
+    case WWFF: return "wwff_directory";
+    case POTA: return "pota_directory";
+    }
+
+    return QString();
+}
+
+QString ReferenceSnapshot::columnName(Source source)
+{
+    switch ( source )
+    {
+    case IOTA: return "iotaid";
+    case SOTA: return "summit_code";
+    case WWFF: return "reference";
+    case POTA: return "reference";
+    }
+
+    return QString();
+}
+
+QStringList ReferenceSnapshot::snapshotFiles(Source source)
+{
+    FCT_IDENTIFICATION;
+
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+    const QStringList fileNames = dir.entryList(QStringList(tableName(source) + ".*.snapshot"),
+                                                QDir::Files, QDir::Name);
+    QStringList ret;
+
+    for ( const QString &fileName : fileNames )
+    {
+        ret << dir.filePath(fileName);
+    }
+
+    return ret;
+}
+
+void ReferenceSnapshot::removeSnapshots(const QStringList &fileNames)
+{
+    FCT_IDENTIFICATION;
+
+    for ( const QString &fileName : fileNames )
+    {
+        if ( !QFile::remove(fileName) )
+        {
+            qCDebug(runtime) << "Cannot remove old Reference Snapshot" << fileName;
+        }
+    }
+}
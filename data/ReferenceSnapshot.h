@@ -0,0 +1,55 @@
+#ifndef REFERENCESNAPSHOT_H
+#define REFERENCESNAPSHOT_H
+
+#include <QtCore>
+#include <QSqlDatabase>
+
+/* Sorted list of reference IDs (IOTA, SOTA, WWFF, POTA) stored in a compact
+ * snapshot file which is memory-mapped on the first use.
+ * The snapshot is regenerated when the source table is refreshed.
+ * Every snapshot has a unique filename therefore a new snapshot can be
+ * created even if the previous one is still mapped */
+class ReferenceSnapshot
+{
+public:
+    enum Source
+    {
+        IOTA,
+        SOTA,
+        WWFF,
+        POTA
+    };
+
+    explicit ReferenceSnapshot(Source source);
+    ~ReferenceSnapshot();
+
+    bool load();
+    bool isLoaded() const;
+    int count() const;
+    QString at(int index) const;
+
+    static bool build(Source source,
+                      const QSqlDatabase &db = QSqlDatabase::database());
+
+private:
+    struct Header
+    {
+        quint32 magic;
+        quint32 version;
+        quint32 count;
+    };
+
+    static QString tableName(Source source);
+    static QString columnName(Source source);
+    static QStringList snapshotFiles(Source source);
+    static void removeSnapshots(const QStringList &fileNames);
+
+    Source source;
+    QFile file;
+    uchar *mappedData;
+    quint32 entries;
+    const quint32 *offsets;
+    const char *strings;
+};
+
+#endif // REFERENCESNAPSHOT_H
@@ -1,4 +1,7 @@
+#include <cstring>
+#include <limits>
 #include <QSqlRecord>
+#include <QSettings>
 #include <QDebug>
 #include "data/Data.h"
 #include "AdiFormat.h"
@@ -7,18 +10,222 @@
 MODULE_IDENTIFICATION("qlog.logformat.adiformat");
 
 #define ALWAYS_PRESENT true
+#define EXPORT_BUFFER_RESERVE 4096
+
+// Size of one input window of a file which does not fit into one buffer
+#define INPUT_WINDOW_SIZE (64 * 1024 * 1024)
+// The smallest accepted input buffer limit (see CONFIG_INPUT_BUFFER_LIMIT_KEY)
+#define MIN_INPUT_BUFFER_LIMIT (4 * 1024)
+
+enum ExportFieldFormat
+{
+    FORMAT_STRING,
+    FORMAT_UPPER,
+    FORMAT_LOWER,
+    FORMAT_DATE,
+    FORMAT_NUMBER
+};
+
+struct ExportField
+{
+    QString adifName;
+    QString column;
+    ExportFieldFormat format;
+};
+
+/* DB columns exported 1:1 to ADIF fields */
+static const ExportField exportFieldTable[] =
+{
+    {QStringLiteral("rst_rcvd"), QStringLiteral("rst_rcvd"), FORMAT_STRING},
+    {QStringLiteral("rst_sent"), QStringLiteral("rst_sent"), FORMAT_STRING},
+    {QStringLiteral("name"), QStringLiteral("name"), FORMAT_STRING},
+    {QStringLiteral("qth"), QStringLiteral("qth"), FORMAT_STRING},
+    {QStringLiteral("gridsquare"), QStringLiteral("gridsquare"), FORMAT_STRING},
+    {QStringLiteral("cqz"), QStringLiteral("cqz"), FORMAT_STRING},
+    {QStringLiteral("ituz"), QStringLiteral("ituz"), FORMAT_STRING},
+    {QStringLiteral("freq"), QStringLiteral("freq"), FORMAT_NUMBER},
+    {QStringLiteral("band"), QStringLiteral("band"), FORMAT_LOWER},
+    {QStringLiteral("mode"), QStringLiteral("mode"), FORMAT_STRING},
+    {QStringLiteral("submode"), QStringLiteral("submode"), FORMAT_STRING},
+    {QStringLiteral("cont"), QStringLiteral("cont"), FORMAT_STRING},
+    {QStringLiteral("dxcc"), QStringLiteral("dxcc"), FORMAT_STRING},
+    {QStringLiteral("country"), QStringLiteral("country"), FORMAT_STRING},
+    {QStringLiteral("pfx"), QStringLiteral("pfx"), FORMAT_STRING},
+    {QStringLiteral("state"), QStringLiteral("state"), FORMAT_STRING},
+    {QStringLiteral("cnty"), QStringLiteral("cnty"), FORMAT_STRING},
+    {QStringLiteral("iota"), QStringLiteral("iota"), FORMAT_UPPER},
+    {QStringLiteral("qsl_rcvd"), QStringLiteral("qsl_rcvd"), FORMAT_STRING},
+    {QStringLiteral("qslrdate"), QStringLiteral("qsl_rdate"), FORMAT_DATE},
+    {QStringLiteral("qsl_sent"), QStringLiteral("qsl_sent"), FORMAT_STRING},
+    {QStringLiteral("qslsdate"), QStringLiteral("qsl_sdate"), FORMAT_DATE},
+    {QStringLiteral("lotw_qsl_rcvd"), QStringLiteral("lotw_qsl_rcvd"), FORMAT_STRING},
+    {QStringLiteral("lotw_qslrdate"), QStringLiteral("lotw_qslrdate"), FORMAT_DATE},
+    {QStringLiteral("lotw_qsl_sent"), QStringLiteral("lotw_qsl_sent"), FORMAT_STRING},
+    {QStringLiteral("lotw_qslsdate"), QStringLiteral("lotw_qslsdate"), FORMAT_DATE},
+    {QStringLiteral("tx_pwr"), QStringLiteral("tx_pwr"), FORMAT_STRING},
+    {QStringLiteral("address"), QStringLiteral("address"), FORMAT_STRING},
+    {QStringLiteral("age"), QStringLiteral("age"), FORMAT_STRING},
+    {QStringLiteral("altitude"), QStringLiteral("altitude"), FORMAT_STRING},
+    {QStringLiteral("a_index"), QStringLiteral("a_index"), FORMAT_STRING},
+    {QStringLiteral("ant_az"), QStringLiteral("ant_az"), FORMAT_STRING},
+    {QStringLiteral("ant_el"), QStringLiteral("ant_el"), FORMAT_STRING},
+    {QStringLiteral("ant_path"), QStringLiteral("ant_path"), FORMAT_STRING},
+    {QStringLiteral("arrl_sect"), QStringLiteral("arrl_sect"), FORMAT_STRING},
+    {QStringLiteral("award_submitted"), QStringLiteral("award_submitted"), FORMAT_STRING},
+    {QStringLiteral("award_granted"), QStringLiteral("award_granted"), FORMAT_STRING},
+    {QStringLiteral("band_rx"), QStringLiteral("band_rx"), FORMAT_LOWER},
+    {QStringLiteral("check"), QStringLiteral("check"), FORMAT_STRING},
+    {QStringLiteral("class"), QStringLiteral("class"), FORMAT_STRING},
+    {QStringLiteral("clublog_qso_upload_date"), QStringLiteral("clublog_qso_upload_date"), FORMAT_DATE},
+    {QStringLiteral("clublog_qso_upload_status"), QStringLiteral("clublog_qso_upload_status"), FORMAT_STRING},
+    {QStringLiteral("comment"), QStringLiteral("comment"), FORMAT_STRING},
+    {QStringLiteral("contacted_op"), QStringLiteral("contacted_op"), FORMAT_STRING},
+    {QStringLiteral("contest_id"), QStringLiteral("contest_id"), FORMAT_STRING},
+    {QStringLiteral("credit_submitted"), QStringLiteral("credit_submitted"), FORMAT_STRING},
+    {QStringLiteral("credit_granted"), QStringLiteral("credit_granted"), FORMAT_STRING},
+    {QStringLiteral("darc_dok"), QStringLiteral("darc_dok"), FORMAT_STRING},
+    {QStringLiteral("distance"), QStringLiteral("distance"), FORMAT_STRING},
+    {QStringLiteral("email"), QStringLiteral("email"), FORMAT_STRING},
+    {QStringLiteral("eq_call"), QStringLiteral("eq_call"), FORMAT_STRING},
+    {QStringLiteral("eqsl_qslrdate"), QStringLiteral("eqsl_qslrdate"), FORMAT_DATE},
+    {QStringLiteral("eqsl_qslsdate"), QStringLiteral("eqsl_qslsdate"), FORMAT_DATE},
+    {QStringLiteral("eqsl_qsl_rcvd"), QStringLiteral("eqsl_qsl_rcvd"), FORMAT_STRING},
+    {QStringLiteral("eqsl_qsl_sent"), QStringLiteral("eqsl_qsl_sent"), FORMAT_STRING},
+    {QStringLiteral("fists"), QStringLiteral("fists"), FORMAT_STRING},
+    {QStringLiteral("fists_cc"), QStringLiteral("fists_cc"), FORMAT_STRING},
+    {QStringLiteral("force_init"), QStringLiteral("force_init"), FORMAT_STRING},
+    {QStringLiteral("freq_rx"), QStringLiteral("freq_rx"), FORMAT_STRING},
+    {QStringLiteral("gridsquare_ext"), QStringLiteral("gridsquare_ext"), FORMAT_STRING},
+    {QStringLiteral("guest_op"), QStringLiteral("guest_op"), FORMAT_STRING},
+    {QStringLiteral("hamlogeu_qso_upload_date"), QStringLiteral("hamlogeu_qso_upload_date"), FORMAT_DATE},
+    {QStringLiteral("hamlogeu_qso_upload_status"), QStringLiteral("hamlogeu_qso_upload_status"), FORMAT_STRING},
+    {QStringLiteral("hamqth_qso_upload_date"), QStringLiteral("hamqth_qso_upload_date"), FORMAT_DATE},
+    {QStringLiteral("hamqth_qso_upload_status"), QStringLiteral("hamqth_qso_upload_status"), FORMAT_STRING},
+    {QStringLiteral("hrdlog_qso_upload_date"), QStringLiteral("hrdlog_qso_upload_date"), FORMAT_DATE},
+    {QStringLiteral("hrdlog_qso_upload_status"), QStringLiteral("hrdlog_qso_upload_status"), FORMAT_STRING},
+    {QStringLiteral("iota_island_id"), QStringLiteral("iota_island_id"), FORMAT_UPPER},
+    {QStringLiteral("k_index"), QStringLiteral("k_index"), FORMAT_STRING},
+    {QStringLiteral("lat"), QStringLiteral("lat"), FORMAT_STRING},
+    {QStringLiteral("lon"), QStringLiteral("lon"), FORMAT_STRING},
+    {QStringLiteral("max_bursts"), QStringLiteral("max_bursts"), FORMAT_STRING},
+    {QStringLiteral("ms_shower"), QStringLiteral("ms_shower"), FORMAT_STRING},
+    {QStringLiteral("my_altitude"), QStringLiteral("my_altitude"), FORMAT_STRING},
+    {QStringLiteral("my_arrl_sect"), QStringLiteral("my_arrl_sect"), FORMAT_STRING},
+    {QStringLiteral("my_antenna"), QStringLiteral("my_antenna"), FORMAT_STRING},
+    {QStringLiteral("my_city"), QStringLiteral("my_city"), FORMAT_STRING},
+    {QStringLiteral("my_cnty"), QStringLiteral("my_cnty"), FORMAT_STRING},
+    {QStringLiteral("my_country"), QStringLiteral("my_country"), FORMAT_STRING},
+    {QStringLiteral("my_cq_zone"), QStringLiteral("my_cq_zone"), FORMAT_STRING},
+    {QStringLiteral("my_dxcc"), QStringLiteral("my_dxcc"), FORMAT_STRING},
+    {QStringLiteral("my_fists"), QStringLiteral("my_fists"), FORMAT_STRING},
+    {QStringLiteral("my_gridsquare"), QStringLiteral("my_gridsquare"), FORMAT_STRING},
+    {QStringLiteral("my_gridsquare_ext"), QStringLiteral("my_gridsquare_ext"), FORMAT_STRING},
+    {QStringLiteral("my_iota"), QStringLiteral("my_iota"), FORMAT_UPPER},
+    {QStringLiteral("my_iota_island_id"), QStringLiteral("my_iota_island_id"), FORMAT_UPPER},
+    {QStringLiteral("my_itu_zone"), QStringLiteral("my_itu_zone"), FORMAT_STRING},
+    {QStringLiteral("my_lat"), QStringLiteral("my_lat"), FORMAT_STRING},
+    {QStringLiteral("my_lon"), QStringLiteral("my_lon"), FORMAT_STRING},
+    {QStringLiteral("my_name"), QStringLiteral("my_name"), FORMAT_STRING},
+    {QStringLiteral("my_postal_code"), QStringLiteral("my_postal_code"), FORMAT_STRING},
+    {QStringLiteral("my_pota_ref"), QStringLiteral("my_pota_ref"), FORMAT_UPPER},
+    {QStringLiteral("my_rig"), QStringLiteral("my_rig"), FORMAT_STRING},
+    {QStringLiteral("my_sig"), QStringLiteral("my_sig"), FORMAT_STRING},
+    {QStringLiteral("my_sig_info"), QStringLiteral("my_sig_info"), FORMAT_STRING},
+    {QStringLiteral("my_sota_ref"), QStringLiteral("my_sota_ref"), FORMAT_UPPER},
+    {QStringLiteral("my_state"), QStringLiteral("my_state"), FORMAT_STRING},
+    {QStringLiteral("my_street"), QStringLiteral("my_street"), FORMAT_STRING},
+    {QStringLiteral("my_usaca_counties"), QStringLiteral("my_usaca_counties"), FORMAT_STRING},
+    {QStringLiteral("my_vucc_grids"), QStringLiteral("my_vucc_grids"), FORMAT_UPPER},
+    {QStringLiteral("my_wwff_ref"), QStringLiteral("my_wwff_ref"), FORMAT_UPPER},
+    {QStringLiteral("notes"), QStringLiteral("notes"), FORMAT_STRING},
+    {QStringLiteral("nr_bursts"), QStringLiteral("nr_bursts"), FORMAT_STRING},
+    {QStringLiteral("nr_pings"), QStringLiteral("nr_pings"), FORMAT_STRING},
+    {QStringLiteral("operator"), QStringLiteral("operator"), FORMAT_STRING},
+    {QStringLiteral("owner_callsign"), QStringLiteral("owner_callsign"), FORMAT_STRING},
+    {QStringLiteral("pota_ref"), QStringLiteral("pota_ref"), FORMAT_UPPER},
+    {QStringLiteral("precedence"), QStringLiteral("precedence"), FORMAT_STRING},
+    {QStringLiteral("prop_mode"), QStringLiteral("prop_mode"), FORMAT_STRING},
+    {QStringLiteral("public_key"), QStringLiteral("public_key"), FORMAT_STRING},
+    {QStringLiteral("qrzcom_qso_upload_date"), QStringLiteral("qrzcom_qso_upload_date"), FORMAT_DATE},
+    {QStringLiteral("qrzcom_qso_upload_status"), QStringLiteral("qrzcom_qso_upload_status"), FORMAT_STRING},
+    {QStringLiteral("qslmsg"), QStringLiteral("qslmsg"), FORMAT_STRING},
+    {QStringLiteral("qsl_rcvd_via"), QStringLiteral("qsl_rcvd_via"), FORMAT_STRING},
+    {QStringLiteral("qsl_sent_via"), QStringLiteral("qsl_sent_via"), FORMAT_STRING},
+    {QStringLiteral("qsl_via"), QStringLiteral("qsl_via"), FORMAT_STRING},
+    {QStringLiteral("qso_complete"), QStringLiteral("qso_complete"), FORMAT_STRING},
+    {QStringLiteral("qso_random"), QStringLiteral("qso_random"), FORMAT_STRING},
+    {QStringLiteral("region"), QStringLiteral("region"), FORMAT_STRING},
+    {QStringLiteral("rig"), QStringLiteral("rig"), FORMAT_STRING},
+    {QStringLiteral("rx_pwr"), QStringLiteral("rx_pwr"), FORMAT_STRING},
+    {QStringLiteral("sat_mode"), QStringLiteral("sat_mode"), FORMAT_STRING},
+    {QStringLiteral("sat_name"), QStringLiteral("sat_name"), FORMAT_STRING},
+    {QStringLiteral("sfi"), QStringLiteral("sfi"), FORMAT_STRING},
+    {QStringLiteral("sig"), QStringLiteral("sig"), FORMAT_STRING},
+    {QStringLiteral("sig_info"), QStringLiteral("sig_info"), FORMAT_STRING},
+    {QStringLiteral("silent_key"), QStringLiteral("silent_key"), FORMAT_STRING},
+    {QStringLiteral("skcc"), QStringLiteral("skcc"), FORMAT_STRING},
+    {QStringLiteral("sota_ref"), QStringLiteral("sota_ref"), FORMAT_UPPER},
+    {QStringLiteral("srx"), QStringLiteral("srx"), FORMAT_STRING},
+    {QStringLiteral("srx_string"), QStringLiteral("srx_string"), FORMAT_STRING},
+    {QStringLiteral("station_callsign"), QStringLiteral("station_callsign"), FORMAT_STRING},
+    {QStringLiteral("stx"), QStringLiteral("stx"), FORMAT_STRING},
+    {QStringLiteral("stx_string"), QStringLiteral("stx_string"), FORMAT_STRING},
+    {QStringLiteral("swl"), QStringLiteral("swl"), FORMAT_STRING},
+    {QStringLiteral("ten_ten"), QStringLiteral("ten_ten"), FORMAT_STRING},
+    {QStringLiteral("uksmg"), QStringLiteral("uksmg"), FORMAT_STRING},
+    {QStringLiteral("usaca_counties"), QStringLiteral("usaca_counties"), FORMAT_STRING},
+    {QStringLiteral("ve_prov"), QStringLiteral("ve_prov"), FORMAT_STRING},
+    {QStringLiteral("vucc_grids"), QStringLiteral("vucc_grids"), FORMAT_UPPER},
+    {QStringLiteral("web"), QStringLiteral("web"), FORMAT_STRING},
+    {QStringLiteral("wwff_ref"), QStringLiteral("wwff_ref"), FORMAT_UPPER}
+};
+
+static const int EXPORT_FIELD_COUNT = sizeof(exportFieldTable) / sizeof(exportFieldTable[0]);
+
+/* positions of the columns in the exportFieldIndex */
+enum
+{
+    COLUMN_CALLSIGN,
+    COLUMN_START_TIME,
+    COLUMN_END_TIME,
+    COLUMN_FIELDS,
+    COLUMN_FIRST_EXPORT_FIELD
+};
+
+static QStringList exportedColumns()
+{
+    QStringList columns;
+
+    columns << "callsign" << "start_time" << "end_time" << "fields";
+
+    for ( int i = 0; i < EXPORT_FIELD_COUNT; i++ )
+    {
+        columns << exportFieldTable[i].column;
+    }
+
+    return columns;
+}
+
+AdiFormat::AdiFormat(QTextStream &stream) :
+    LogFormat(stream),
+    exportFieldIndex(exportedColumns())
+{
+    FCT_IDENTIFICATION;
+}
 
 void AdiFormat::exportStart()
 {
     FCT_IDENTIFICATION;
 
-    stream << "### QLog ADIF Export\n";
+    exportBuffer.reserve(EXPORT_BUFFER_RESERVE);
+    exportBuffer.append("### QLog ADIF Export\n");
     writeField("ADIF_VER", ALWAYS_PRESENT, ADIF_VERSION_STRING);
     writeField("PROGRAMID", ALWAYS_PRESENT, PROGRAMID_STRING);
     writeField("PROGRAMVERSION", ALWAYS_PRESENT, VERSION);
     writeField("CREATED_TIMESTAMP", ALWAYS_PRESENT,
                QDateTime::currentDateTimeUtc().toString("yyyyMMdd hhmmss"));
-    stream << "<EOH>\n\n";
+    exportBuffer.append("<EOH>\n\n");
+    flushExportBuffer();
 }
 
 void AdiFormat::exportContact(const QSqlRecord& record,
@@ -30,7 +237,8 @@ void AdiFormat::exportContact(const QSqlRecord& record,
 
     writeSQLRecord(record, applTags);
 
-    stream << "<eor>\n\n";
+    exportBuffer.append("<eor>\n\n");
+    flushExportBuffer();
 }
 
 void AdiFormat::writeField(const QString &name, bool presenceCondition,
@@ -43,20 +251,30 @@ void AdiFormat::writeField(const QString &name, bool presenceCondition,
                                 << value
                                 << type;
 
-    if (!presenceCondition) return;
+    if ( !presenceCondition || value.isEmpty() ) return;
 
     /* ADIF does not support UTF-8 characterset therefore the Accents are remove */
     QString accentless(Data::removeAccents(value));
 
     qCDebug(runtime) << "Accentless: " << accentless;
 
-    if ( value.isEmpty() || accentless.isEmpty() ) return;
+    if ( accentless.isEmpty() ) return;
+
+    exportBuffer.append('<').append(name).append(':').append(QString::number(accentless.size()));
+
+    if (!type.isEmpty()) exportBuffer.append(':').append(type);
+
+    exportBuffer.append('>').append(accentless).append('\n');
+}
 
-    stream << "<" << name << ":" << accentless.size();
+void AdiFormat::flushExportBuffer()
+{
+    FCT_IDENTIFICATION;
 
-    if (!type.isEmpty()) stream << ":" << type;
+    stream << exportBuffer;
 
-    stream << ">" << accentless << '\n';
+    // resize keeps the allocated capacity for the next record
+    exportBuffer.resize(0);
 }
 
 void AdiFormat::writeSQLRecord(const QSqlRecord &record,
@@ -64,305 +282,57 @@ void AdiFormat::writeSQLRecord(const QSqlRecord &record,
 {
     FCT_IDENTIFICATION;
 
-    QDateTime time_start = record.value("start_time").toDateTime().toTimeSpec(Qt::UTC);
-    QDateTime time_end = record.value("end_time").toDateTime().toTimeSpec(Qt::UTC);
+    exportFieldIndex.resolve(record);
+
+    const QVariant callsign = exportFieldIndex.value(record, COLUMN_CALLSIGN);
+    const QVariant startTime = exportFieldIndex.value(record, COLUMN_START_TIME);
+    const QVariant endTime = exportFieldIndex.value(record, COLUMN_END_TIME);
+
+    QDateTime time_start = startTime.toDateTime().toTimeSpec(Qt::UTC);
+    QDateTime time_end = endTime.toDateTime().toTimeSpec(Qt::UTC);
 
-    writeField("call", record.value("callsign").isValid(),
-               record.value("callsign").toString());
-    writeField("qso_date", record.value("start_time").isValid(),
+    writeField("call", callsign.isValid(),
+               callsign.toString());
+    writeField("qso_date", startTime.isValid(),
                time_start.toString("yyyyMMdd"), "D");
-    writeField("time_on", record.value("start_time").isValid(),
+    writeField("time_on", startTime.isValid(),
                time_start.toString("hhmmss"), "T");
-    writeField("qso_date_off", record.value("end_time").isValid(),
+    writeField("qso_date_off", endTime.isValid(),
                time_end.toString("yyyyMMdd"), "D");
-    writeField("time_off", record.value("end_time").isValid(),
+    writeField("time_off", endTime.isValid(),
                time_end.toString("hhmmss"), "T");
-    writeField("rst_rcvd", record.value("rst_rcvd").isValid(),
-               record.value("rst_rcvd").toString());
-    writeField("rst_sent", record.value("rst_sent").isValid(),
-               record.value("rst_sent").toString());
-    writeField("name", record.value("name").isValid(),
-               record.value("name").toString());
-    writeField("qth", record.value("qth").isValid(),
-               record.value("qth").toString());
-    writeField("gridsquare", record.value("gridsquare").isValid(),
-               record.value("gridsquare").toString());
-    writeField("cqz", record.value("cqz").isValid(),
-               record.value("cqz").toString());
-    writeField("ituz", record.value("ituz").isValid(),
-               record.value("ituz").toString());
-    writeField("freq", record.value("freq").isValid(),
-               record.value("freq").toString(), "N");
-    writeField("band", record.value("band").isValid(),
-               record.value("band").toString().toLower());
-    writeField("mode", record.value("mode").isValid(),
-               record.value("mode").toString());
-    writeField("submode", record.value("submode").isValid(),
-               record.value("submode").toString());
-    writeField("cont", record.value("cont").isValid(),
-               record.value("cont").toString());
-    writeField("dxcc", record.value("dxcc").isValid(),
-               record.value("dxcc").toString());
-    writeField("country", record.value("country").isValid(),
-               record.value("country").toString());
-    writeField("pfx", record.value("pfx").isValid(),
-               record.value("pfx").toString());
-    writeField("state", record.value("state").isValid(),
-               record.value("state").toString());
-    writeField("cnty", record.value("cnty").isValid(),
-               record.value("cnty").toString());
-    writeField("iota", record.value("iota").isValid(),
-               record.value("iota").toString().toUpper());
-    writeField("qsl_rcvd", record.value("qsl_rcvd").isValid(),
-               record.value("qsl_rcvd").toString());
-    writeField("qslrdate", record.value("qsl_rdate").isValid(),
-               record.value("qsl_rdate").toDate().toString("yyyyMMdd"));
-    writeField("qsl_sent", record.value("qsl_sent").isValid(),
-               record.value("qsl_sent").toString());
-    writeField("qslsdate", record.value("qsl_sdate").isValid(),
-               record.value("qsl_sdate").toDate().toString("yyyyMMdd"));
-    writeField("lotw_qsl_rcvd", record.value("lotw_qsl_rcvd").isValid(),
-               record.value("lotw_qsl_rcvd").toString());
-    writeField("lotw_qslrdate", record.value("lotw_qslrdate").isValid(),
-               record.value("lotw_qslrdate").toDate().toString("yyyyMMdd"));
-    writeField("lotw_qsl_sent", record.value("lotw_qsl_sent").isValid(),
-               record.value("lotw_qsl_sent").toString());
-    writeField("lotw_qslsdate", record.value("lotw_qslsdate").isValid(),
-               record.value("lotw_qslsdate").toDate().toString("yyyyMMdd"));
-    writeField("tx_pwr", record.value("tx_pwr").isValid(),
-               record.value("tx_pwr").toString());
-    writeField("address", record.value("address").isValid(),
-               record.value("address").toString());
-    writeField("age", record.value("age").isValid(),
-               record.value("age").toString());
-    writeField("altitude", record.value("altitude").isValid(),
-               record.value("altitude").toString());
-    writeField("a_index", record.value("a_index").isValid(),
-               record.value("a_index").toString());
-    writeField("ant_az", record.value("ant_az").isValid(),
-               record.value("ant_az").toString());
-    writeField("ant_el", record.value("ant_el").isValid(),
-               record.value("ant_el").toString());
-    writeField("ant_path", record.value("ant_path").isValid(),
-               record.value("ant_path").toString());
-    writeField("arrl_sect", record.value("arrl_sect").isValid(),
-               record.value("arrl_sect").toString());
-    writeField("award_submitted", record.value("award_submitted").isValid(),
-               record.value("award_submitted").toString());
-    writeField("award_granted", record.value("award_granted").isValid(),
-               record.value("award_granted").toString());
-    writeField("band_rx", record.value("band_rx").isValid(),
-               record.value("band_rx").toString().toLower());
-    writeField("check", record.value("check").isValid(),
-               record.value("check").toString());
-    writeField("class", record.value("class").isValid(),
-               record.value("class").toString());
-    writeField("clublog_qso_upload_date", record.value("clublog_qso_upload_date").isValid(),
-               record.value("clublog_qso_upload_date").toDate().toString("yyyyMMdd"));
-    writeField("clublog_qso_upload_status", record.value("clublog_qso_upload_status").isValid(),
-               record.value("clublog_qso_upload_status").toString());
-    writeField("comment", record.value("comment").isValid(),
-               record.value("comment").toString());
-    writeField("contacted_op", record.value("contacted_op").isValid(),
-               record.value("contacted_op").toString());
-    writeField("contest_id", record.value("contest_id").isValid(),
-               record.value("contest_id").toString());
-    writeField("credit_submitted", record.value("credit_submitted").isValid(),
-               record.value("credit_submitted").toString());
-    writeField("credit_granted", record.value("credit_granted").isValid(),
-               record.value("credit_granted").toString());
-    writeField("darc_dok", record.value("darc_dok").isValid(),
-               record.value("darc_dok").toString());
-    writeField("distance", record.value("distance").isValid(),
-               record.value("distance").toString());
-    writeField("email", record.value("email").isValid(),
-               record.value("email").toString());
-    writeField("eq_call", record.value("eq_call").isValid(),
-               record.value("eq_call").toString());
-    writeField("eqsl_qslrdate", record.value("eqsl_qslrdate").isValid(),
-               record.value("eqsl_qslrdate").toDate().toString("yyyyMMdd"));
-    writeField("eqsl_qslsdate", record.value("eqsl_qslsdate").isValid(),
-               record.value("eqsl_qslsdate").toDate().toString("yyyyMMdd"));
-    writeField("eqsl_qsl_rcvd", record.value("eqsl_qsl_rcvd").isValid(),
-               record.value("eqsl_qsl_rcvd").toString());
-    writeField("eqsl_qsl_sent", record.value("eqsl_qsl_sent").isValid(),
-               record.value("eqsl_qsl_sent").toString());
-    writeField("fists", record.value("fists").isValid(),
-               record.value("fists").toString());
-    writeField("fists_cc", record.value("fists_cc").isValid(),
-               record.value("fists_cc").toString());
-    writeField("force_init", record.value("force_init").isValid(),
-               record.value("force_init").toString());
-    writeField("freq_rx", record.value("freq_rx").isValid(),
-               record.value("freq_rx").toString());
-    writeField("gridsquare_ext", record.value("gridsquare_ext").isValid(),
-               record.value("gridsquare_ext").toString());
-    writeField("guest_op", record.value("guest_op").isValid(),
-               record.value("guest_op").toString());
-    writeField("hamlogeu_qso_upload_date", record.value("hamlogeu_qso_upload_date").isValid(),
-               record.value("hamlogeu_qso_upload_date").toDate().toString("yyyyMMdd"));
-    writeField("hamlogeu_qso_upload_status", record.value("hamlogeu_qso_upload_status").isValid(),
-               record.value("hamlogeu_qso_upload_status").toString());
-    writeField("hamqth_qso_upload_date", record.value("hamqth_qso_upload_date").isValid(),
-               record.value("hamqth_qso_upload_date").toDate().toString("yyyyMMdd"));
-    writeField("hamqth_qso_upload_status", record.value("hamqth_qso_upload_status").isValid(),
-               record.value("hamqth_qso_upload_status").toString());
-    writeField("hrdlog_qso_upload_date", record.value("hrdlog_qso_upload_date").isValid(),
-               record.value("hrdlog_qso_upload_date").toDate().toString("yyyyMMdd"));
-    writeField("hrdlog_qso_upload_status", record.value("hrdlog_qso_upload_status").isValid(),
-               record.value("hrdlog_qso_upload_status").toString());
-    writeField("iota_island_id", record.value("iota_island_id").isValid(),
-               record.value("iota_island_id").toString().toUpper());
-    writeField("k_index", record.value("k_index").isValid(),
-               record.value("k_index").toString());
-    writeField("lat", record.value("lat").isValid(),
-               record.value("lat").toString());
-    writeField("lon", record.value("lon").isValid(),
-               record.value("lon").toString());
-    writeField("max_bursts", record.value("max_bursts").isValid(),
-               record.value("max_bursts").toString());
-    writeField("ms_shower", record.value("ms_shower").isValid(),
-               record.value("ms_shower").toString());
-    writeField("my_altitude", record.value("my_altitude").isValid(),
-               record.value("my_altitude").toString());
-    writeField("my_arrl_sect", record.value("my_arrl_sect").isValid(),
-               record.value("my_arrl_sect").toString());
-    writeField("my_antenna", record.value("my_antenna").isValid(),
-               record.value("my_antenna").toString());
-    writeField("my_city", record.value("my_city").isValid(),
-               record.value("my_city").toString());
-    writeField("my_cnty", record.value("my_cnty").isValid(),
-               record.value("my_cnty").toString());
-    writeField("my_country", record.value("my_country").isValid(),
-               record.value("my_country").toString());
-    writeField("my_cq_zone", record.value("my_cq_zone").isValid(),
-               record.value("my_cq_zone").toString());
-    writeField("my_dxcc", record.value("my_dxcc").isValid(),
-               record.value("my_dxcc").toString());
-    writeField("my_fists", record.value("my_fists").isValid(),
-               record.value("my_fists").toString());
-    writeField("my_gridsquare", record.value("my_gridsquare").isValid(),
-               record.value("my_gridsquare").toString());
-    writeField("my_gridsquare_ext", record.value("my_gridsquare_ext").isValid(),
-               record.value("my_gridsquare_ext").toString());
-    writeField("my_iota", record.value("my_iota").isValid(),
-               record.value("my_iota").toString().toUpper());
-    writeField("my_iota_island_id", record.value("my_iota_island_id").isValid(),
-               record.value("my_iota_island_id").toString().toUpper());
-    writeField("my_itu_zone", record.value("my_itu_zone").isValid(),
-               record.value("my_itu_zone").toString());
-    writeField("my_lat", record.value("my_lat").isValid(),
-               record.value("my_lat").toString());
-    writeField("my_lon", record.value("my_lon").isValid(),
-               record.value("my_lon").toString());
-    writeField("my_name", record.value("my_name").isValid(),
-               record.value("my_name").toString());
-    writeField("my_postal_code", record.value("my_postal_code").isValid(),
-               record.value("my_postal_code").toString());
-    writeField("my_pota_ref", record.value("my_pota_ref").isValid(),
-               record.value("my_pota_ref").toString().toUpper());
-    writeField("my_rig", record.value("my_rig").isValid(),
-               record.value("my_rig").toString());
-    writeField("my_sig", record.value("my_sig").isValid(),
-               record.value("my_sig").toString());
-    writeField("my_sig_info", record.value("my_sig_info").isValid(),
-               record.value("my_sig_info").toString());
-    writeField("my_sota_ref", record.value("my_sota_ref").isValid(),
-               record.value("my_sota_ref").toString().toUpper());
-    writeField("my_state", record.value("my_state").isValid(),
-               record.value("my_state").toString());
-    writeField("my_street", record.value("my_street").isValid(),
-               record.value("my_street").toString());
-    writeField("my_usaca_counties", record.value("my_usaca_counties").isValid(),
-               record.value("my_usaca_counties").toString());
-    writeField("my_vucc_grids", record.value("my_vucc_grids").isValid(),
-               record.value("my_vucc_grids").toString().toUpper());
-    writeField("my_wwff_ref", record.value("my_wwff_ref").isValid(),
-               record.value("my_wwff_ref").toString().toUpper());
-    writeField("notes", record.value("notes").isValid(),
-               record.value("notes").toString());
-    writeField("nr_bursts", record.value("nr_bursts").isValid(),
-               record.value("nr_bursts").toString());
-    writeField("nr_pings", record.value("nr_pings").isValid(),
-               record.value("nr_pings").toString());
-    writeField("operator", record.value("operator").isValid(),
-               record.value("operator").toString());
-    writeField("owner_callsign", record.value("owner_callsign").isValid(),
-               record.value("owner_callsign").toString());
-    writeField("pota_ref", record.value("pota_ref").isValid(),
-               record.value("pota_ref").toString().toUpper());
-    writeField("precedence", record.value("precedence").isValid(),
-               record.value("precedence").toString());
-    writeField("prop_mode", record.value("prop_mode").isValid(),
-               record.value("prop_mode").toString());
-    writeField("public_key", record.value("public_key").isValid(),
-               record.value("public_key").toString());
-    writeField("qrzcom_qso_upload_date", record.value("qrzcom_qso_upload_date").isValid(),
-               record.value("qrzcom_qso_upload_date").toDate().toString("yyyyMMdd"));
-    writeField("qrzcom_qso_upload_status", record.value("qrzcom_qso_upload_status").isValid(),
-               record.value("qrzcom_qso_upload_status").toString());
-    writeField("qslmsg", record.value("qslmsg").isValid(),
-               record.value("qslmsg").toString());
-    writeField("qsl_rcvd_via", record.value("qsl_rcvd_via").isValid(),
-               record.value("qsl_rcvd_via").toString());
-    writeField("qsl_sent_via", record.value("qsl_sent_via").isValid(),
-               record.value("qsl_sent_via").toString());
-    writeField("qsl_via", record.value("qsl_via").isValid(),
-               record.value("qsl_via").toString());
-    writeField("qso_complete", record.value("qso_complete").isValid(),
-               record.value("qso_complete").toString());
-    writeField("qso_random", record.value("qso_random").isValid(),
-               record.value("qso_random").toString());
-    writeField("region", record.value("region").isValid(),
-               record.value("region").toString());
-    writeField("rig", record.value("rig").isValid(),
-               record.value("rig").toString());
-    writeField("rx_pwr", record.value("rx_pwr").isValid(),
-               record.value("rx_pwr").toString());
-    writeField("sat_mode", record.value("sat_mode").isValid(),
-               record.value("sat_mode").toString());
-    writeField("sat_name", record.value("sat_name").isValid(),
-               record.value("sat_name").toString());
-    writeField("sfi", record.value("sfi").isValid(),
-               record.value("sfi").toString());
-    writeField("sig", record.value("sig").isValid(),
-               record.value("sig").toString());
-    writeField("sig_info", record.value("sig_info").isValid(),
-               record.value("sig_info").toString());
-    writeField("silent_key", record.value("silent_key").isValid(),
-               record.value("silent_key").toString());
-    writeField("skcc", record.value("skcc").isValid(),
-               record.value("skcc").toString());
-    writeField("sota_ref", record.value("sota_ref").isValid(),
-               record.value("sota_ref").toString().toUpper());
-    writeField("srx", record.value("srx").isValid(),
-               record.value("srx").toString());
-    writeField("srx_string", record.value("srx_string").isValid(),
-               record.value("srx_string").toString());
-    writeField("station_callsign", record.value("station_callsign").isValid(),
-               record.value("station_callsign").toString());
-    writeField("stx", record.value("stx").isValid(),
-               record.value("stx").toString());
-    writeField("stx_string", record.value("stx_string").isValid(),
-               record.value("stx_string").toString());
-    writeField("swl", record.value("swl").isValid(),
-               record.value("swl").toString());
-    writeField("ten_ten", record.value("ten_ten").isValid(),
-               record.value("ten_ten").toString());
-    writeField("uksmg", record.value("uksmg").isValid(),
-               record.value("uksmg").toString());
-    writeField("usaca_counties", record.value("usaca_counties").isValid(),
-               record.value("usaca_counties").toString());
-    writeField("ve_prov", record.value("ve_prov").isValid(),
-               record.value("ve_prov").toString());
-    writeField("vucc_grids", record.value("vucc_grids").isValid(),
-               record.value("vucc_grids").toString().toUpper());
-    writeField("web", record.value("web").isValid(),
-               record.value("web").toString());
-    writeField("wwff_ref", record.value("wwff_ref").isValid(),
-               record.value("wwff_ref").toString().toUpper());
-
-    QJsonObject fields = QJsonDocument::fromJson(record.value("fields").toByteArray()).object();
+
+    for ( int i = 0; i < EXPORT_FIELD_COUNT; i++ )
+    {
+        const QVariant value = exportFieldIndex.value(record, COLUMN_FIRST_EXPORT_FIELD + i);
+
+        if ( !value.isValid() )
+        {
+            continue;
+        }
+
+        const ExportField &field = exportFieldTable[i];
+
+        switch ( field.format )
+        {
+        case FORMAT_UPPER:
+            writeField(field.adifName, ALWAYS_PRESENT, value.toString().toUpper());
+            break;
+        case FORMAT_LOWER:
+            writeField(field.adifName, ALWAYS_PRESENT, value.toString().toLower());
+            break;
+        case FORMAT_DATE:
+            writeField(field.adifName, ALWAYS_PRESENT, value.toDate().toString("yyyyMMdd"));
+            break;
+        case FORMAT_NUMBER:
+            writeField(field.adifName, ALWAYS_PRESENT, value.toString(), "N");
+            break;
+        default:
+            writeField(field.adifName, ALWAYS_PRESENT, value.toString());
+        }
+    }
+
+    QJsonObject fields = QJsonDocument::fromJson(exportFieldIndex.value(record, COLUMN_FIELDS).toByteArray()).object();
 
     QStringList keys = fields.keys();
     for (const QString &key : qAsConst(keys))
@@ -381,121 +351,385 @@ void AdiFormat::writeSQLRecord(const QSqlRecord &record,
     }
 }
 
-void AdiFormat::readField(QString& field, QString& value)
+void AdiFormat::importStart()
 {
     FCT_IDENTIFICATION;
 
-    //qCDebug(function_parameters)<<field<< " " << value;
+    releaseInput();
+
+    state = START;
+    inHeader = false;
+
+    QIODevice *device = stream.device();
+
+    if ( device )
+    {
+        inputOffset = device->pos();
+
+        /* Map the file to memory if possible. Text-mode files are read in one block
+         * because the device has to translate line endings */
+        QFile *file = qobject_cast<QFile*>(device);
+
+        if ( file
+             && !file->isTextModeEnabled()
+             && file->size() > inputOffset )
+        {
+            qint64 mapSize = file->size() - inputOffset;
+
+            /* The limit is a hidden setting. A lower value forces the windowed input
+             * also for small files so that the windowed parsing can be checked
+             * against the mapped one */
+            QSettings settings;
+            const qint64 bufferLimit = qBound(static_cast<qint64>(MIN_INPUT_BUFFER_LIMIT),
+                                              settings.value(CONFIG_INPUT_BUFFER_LIMIT_KEY,
+                                                             std::numeric_limits<int>::max()).toLongLong(),
+                                              static_cast<qint64>(std::numeric_limits<int>::max()));
+            inputWindowSize = qMin(static_cast<qint64>(INPUT_WINDOW_SIZE), bufferLimit);
+
+            if ( mapSize > bufferLimit )
+            {
+                /* a QByteArray cannot address the whole file */
+                windowedFile = file;
+                inputEnd = file->size();
+                loadInputWindow(inputOffset);
+            }
+            else
+            {
+                mappedData = file->map(inputOffset, mapSize);
+
+                if ( mappedData )
+                {
+                    mappedFile = file;
+                    inputBuffer = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData),
+                                                          static_cast<int>(mapSize));
+                }
+            }
+        }
+
+        if ( !mappedData && !windowedFile )
+        {
+            inputBuffer = device->readAll();
+        }
+
+        /* the parser works with UTF-8 therefore recode the input if the stream uses
+         * a different encoding. Windows of a large file are not recoded */
+#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
+        QTextCodec *codec = stream.codec();
+
+        if ( windowedFile )
+        {
+            qCDebug(runtime) << "Large file - input is parsed as UTF-8";
+        }
+        else if ( codec && codec->mibEnum() != 106 ) // 106 = UTF-8
+        {
+            QByteArray recoded = codec->toUnicode(inputBuffer).toUtf8();
+            releaseInput();
+            inputBuffer = recoded;
+        }
+#else
+        if ( windowedFile )
+        {
+            qCDebug(runtime) << "Large file - input is parsed as UTF-8";
+        }
+        else if ( stream.encoding() != QStringConverter::Utf8 )
+        {
+            QStringDecoder decoder(stream.encoding());
+            QByteArray recoded = QString(decoder(inputBuffer)).toUtf8();
+            releaseInput();
+            inputBuffer = recoded;
+        }
+#endif
+    }
+    else if ( stream.string() )
+    {
+        inputBuffer = stream.string()->mid(stream.pos()).toUtf8();
+    }
+
+    /* skip UTF-8 BOM */
+    if ( inputBuffer.startsWith("\xEF\xBB\xBF") )
+    {
+        inputPos = 3;
+    }
+
+    qCDebug(runtime) << "Input size" << inputBuffer.size()
+                     << "mapped" << ( mappedData != nullptr )
+                     << "windowed" << ( windowedFile != nullptr );
+}
+
+void AdiFormat::importEnd()
+{
+    FCT_IDENTIFICATION;
+
+    releaseInput();
+}
+
+qint64 AdiFormat::streamPosition()
+{
+    FCT_IDENTIFICATION;
+
+    /* ADX and other inherited formats do not use the input buffer */
+    if ( inputBuffer.isNull() )
+    {
+        return LogFormat::streamPosition();
+    }
+
+    return inputOffset + inputPos;
+}
+
+void AdiFormat::releaseInput()
+{
+    FCT_IDENTIFICATION;
+
+    unmapInput();
+
+    inputPos = 0;
+    windowedFile = nullptr;
+    inputEnd = 0;
+}
+
+void AdiFormat::unmapInput()
+{
+    FCT_IDENTIFICATION;
+
+    /* the buffer can point to the mapped memory therefore it must be released first */
+    inputBuffer = QByteArray();
+
+    if ( mappedFile && mappedData )
+    {
+        mappedFile->unmap(mappedData);
+    }
+
+    mappedFile = nullptr;
+    mappedData = nullptr;
+}
+
+bool AdiFormat::loadInputWindow(qint64 offset)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << offset;
+
+    unmapInput();
+
+    inputOffset = offset;
+    inputPos = 0;
 
-    char c;
+    const qint64 windowSize = qMin(inputWindowSize, inputEnd - offset);
 
-    QString typeString;
-    QString lengthString;
+    if ( windowSize <= 0 )
+    {
+        return false;
+    }
+
+    mappedData = windowedFile->map(offset, windowSize);
+
+    if ( mappedData )
+    {
+        mappedFile = windowedFile;
+        inputBuffer = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData),
+                                              static_cast<int>(windowSize));
+    }
+    else if ( windowedFile->seek(offset) )
+    {
+        inputBuffer = windowedFile->read(windowSize);
+    }
+
+    return !inputBuffer.isEmpty();
+}
+
+/* ADIF Data-Length is interpreted as a number of characters (the same as
+ * QTextStream::read() did). Returns the number of UTF-8 bytes which
+ * represent the requested number of UTF-16 characters */
+static qsizetype utf8Span(const char *data, qsizetype available, int length)
+{
+    qsizetype i = 0;
+    int units = 0;
+
+    while ( i < available && units < length )
+    {
+        const uchar c = static_cast<uchar>(data[i]);
+
+        if ( c < 0x80 )
+        {
+            i++;
+            units++;
+        }
+        else if ( (c & 0xE0) == 0xC0 )
+        {
+            i += 2;
+            units++;
+        }
+        else if ( (c & 0xF0) == 0xE0 )
+        {
+            i += 3;
+            units++;
+        }
+        else if ( (c & 0xF8) == 0xF0 )
+        {
+            // surrogate pair
+            i += 4;
+            units += 2;
+        }
+        else
+        {
+            // invalid byte - decoded as a replacement character
+            i++;
+            units++;
+        }
+    }
+
+    return qMin(i, available);
+}
+
+/* Data-Length parser. Whitespaces are ignored, invalid number returns 0 */
+static int parseDataLength(const char *data, qsizetype len)
+{
     int length = 0;
 
-    while (!stream.atEnd()) {
-        switch (state) {
+    for ( qsizetype i = 0; i < len; i++ )
+    {
+        const char c = data[i];
+
+        if ( c == ' ' || c == '\t' || c == '\r' || c == '\n' )
+        {
+            continue;
+        }
+
+        if ( c < '0' || c > '9' )
+        {
+            return 0;
+        }
+
+        length = length * 10 + (c - '0');
+    }
+
+    return length;
+}
+
+QString AdiFormat::fieldName(const char *data, qsizetype len)
+{
+    /* field names are repeated in every record - convert them only once */
+    const QByteArray rawName = QByteArray::fromRawData(data, static_cast<int>(len));
+
+    QHash<QByteArray, QString>::const_iterator it = fieldNameCache.constFind(rawName);
+
+    if ( it != fieldNameCache.constEnd() )
+    {
+        return it.value();
+    }
+
+    QString name = QString::fromLatin1(data, static_cast<int>(len)).simplified().remove(' ').toLower();
+    fieldNameCache.insert(QByteArray(data, static_cast<int>(len)), name);
+    return name;
+}
+
+void AdiFormat::readField(QString& field, QString& value)
+{
+    FCT_IDENTIFICATION;
+
+    const char *data = inputBuffer.constData();
+    const qsizetype size = inputBuffer.size();
+
+    while ( inputPos < size )
+    {
+        switch ( state )
+        {
         case START:
-            stream >> c;
-            if (c == '<') {
+            if ( QChar::isSpace(static_cast<uchar>(data[inputPos])) )
+            {
+                inputPos++;
+                break;
+            }
+
+            if ( data[inputPos] == '<' )
+            {
                 inHeader = false;
                 state = KEY;
-                field = "";
             }
-            else {
+            else
+            {
                 inHeader = true;
                 state = FIELD;
             }
+            inputPos++;
             break;
 
         case FIELD:
-            stream >> c;
-            if (c == '<') {
-                state = KEY;
-                field = "";
+        {
+            const char *tagStart = static_cast<const char*>(memchr(data + inputPos, '<', size - inputPos));
+
+            if ( !tagStart )
+            {
+                inputPos = size;
+                break;
             }
+
+            inputPos = tagStart - data + 1;
+            state = KEY;
             break;
+        }
 
         case KEY:
-            stream >> c;
-            if (c == ':') {
-                state = SIZE;
-                lengthString = "";
+        {
+            /* <name:length:type> or <name> */
+            const char *tag = data + inputPos;
+            const char *tagEnd = static_cast<const char*>(memchr(tag, '>', size - inputPos));
+
+            if ( !tagEnd )
+            {
+                // truncated input
+                inputPos = size;
+                field.clear();
+                value.clear();
+                return;
             }
-            else if (c == '>') {
-                state = FIELD;
-                if (inHeader && field.toLower() == "eoh") {
+
+            const char *lengthSep = static_cast<const char*>(memchr(tag, ':', tagEnd - tag));
+
+            field = fieldName(tag, ( lengthSep ) ? lengthSep - tag : tagEnd - tag);
+            inputPos = tagEnd - data + 1;
+            state = FIELD;
+
+            if ( !lengthSep )
+            {
+                if ( inHeader && field == "eoh" )
+                {
                     inHeader = false;
+                    break;
                 }
-                else {
-                    value = "";
-                    return;
-                }
-            }
-            else {
-                field.append(c);
-            }
-            break;
 
-        case SIZE:
-            stream >> c;
-            if (c == ':') {
-                 if (!lengthString.isEmpty()) {
-                    length = lengthString.toInt();
-                 }
-                 state = DATA_TYPE;
-                 typeString = "";
+                value.clear();
+                return;
             }
-            else if (c == '>') {
-                if (!lengthString.isEmpty()) {
-                    length = lengthString.toInt();
-                }
 
-                if (length > 0) {
-                    state = VALUE;
-                    value = "";
-                }
-                else {
-                    state = FIELD;
-                    if (!inHeader) {
-                        value = "";
-                        return;
-                    }
+            const char *lengthStart = lengthSep + 1;
+            const char *typeSep = static_cast<const char*>(memchr(lengthStart, ':', tagEnd - lengthStart));
+            const int length = parseDataLength(lengthStart,
+                                               ( typeSep ) ? typeSep - lengthStart : tagEnd - lengthStart);
 
+            if ( length <= 0 )
+            {
+                if ( !inHeader )
+                {
+                    value.clear();
+                    return;
                 }
+                break;
             }
-            else {
-                lengthString.append(c);
-            }
-            break;
 
-        case DATA_TYPE:
-            stream >> c;
-            if (c == '>') {
-                if (length > 0) {
-                    state = VALUE;
-                    value = "";
-                }
-                else {
-                    state = FIELD;
-                    if (!inHeader) {
-                        value = "";
-                        return;
-                    }
-                }
-            }
-            else {
-                typeString.append(c);
-            }
-            break;
+            const qsizetype valueLen = utf8Span(data + inputPos, size - inputPos, length);
 
-        case VALUE:
-            value = QString(stream.read(length));
-            state = FIELD;
-            if (!inHeader) {
-                return;
+            /* Header values are not used - skip them without decoding */
+            if ( inHeader )
+            {
+                inputPos += valueLen;
+                break;
             }
-            break;
+
+            value = QString::fromUtf8(data + inputPos, static_cast<int>(valueLen));
+            inputPos += valueLen;
+            return;
+        }
         }
     }
 }
@@ -824,26 +1058,59 @@ bool AdiFormat::readContact(QMap<QString, QVariant>& contact)
 {
     FCT_IDENTIFICATION;
 
-    while (!stream.atEnd())
+    while ( true )
     {
-        QString field;
-        QString value;
+        const qsizetype recordStart = inputPos;
+        const ParserState recordState = state;
+        const bool recordInHeader = inHeader;
 
-        readField(field, value);
-        field = field.toLower();
+        while ( inputPos < inputBuffer.size() )
+        {
+            QString field;
+            QString value;
+
+            readField(field, value);
 
-        if (field == "eor")
+            if (field == "eor")
+            {
+                return true;
+            }
+
+            if (!value.isEmpty())
+            {
+                contact[field] = QVariant(value);
+            }
+        }
+
+        /* the record continues in the next window of a large file - the window
+         * is moved to the record start and the record is parsed again */
+        if ( !windowedFile
+             || inputOffset + inputBuffer.size() >= inputEnd )
+        {
+            if ( !contact.isEmpty() )
+            {
+                qWarning() << "ADIF input ends inside a record at" << inputOffset + recordStart;
+            }
+            return false;
+        }
+
+        if ( recordStart == 0 )
         {
-            return true;
+            /* the record does not fit into one window */
+            qWarning() << "ADIF record at" << inputOffset
+                       << "is longer than the input window" << inputWindowSize;
+            return false;
         }
 
-        if (!value.isEmpty())
+        contact.clear();
+        state = recordState;
+        inHeader = recordInHeader;
+
+        if ( !loadInputWindow(inputOffset + recordStart) )
         {
-            contact[field] = QVariant(value);
+            return false;
         }
     }
-
-    return false;
 }
 
 bool AdiFormat::importNext(QSqlRecord& record)
@@ -979,3 +1246,5 @@ QMap<QString, QString> AdiFormat::fieldname2INTLNameMapping =
     {"sig", "sig_intl"},
     {"sig_info", "sig_info_intl"}
 };
+
+const QString AdiFormat::CONFIG_INPUT_BUFFER_LIMIT_KEY = "import/adif_input_buffer_limit";
@@ -2,14 +2,17 @@
 #define ADIFORMAT_H
 
 #include "LogFormat.h"
+#include "ExportFieldIndex.h"
 #define ADIF_VERSION_STRING "3.1.4"
 #define PROGRAMID_STRING "QLog"
 
 class AdiFormat : public LogFormat
 {
 public:
-    explicit AdiFormat(QTextStream& stream) : LogFormat(stream) {}
+    explicit AdiFormat(QTextStream& stream);
 
+    virtual void importStart() override;
+    virtual void importEnd() override;
     virtual bool importNext(QSqlRecord& ) override;
 
     virtual void exportContact(const QSqlRecord&,
@@ -17,6 +20,7 @@ public:
     virtual void exportStart() override;
 
     static QMap<QString, QString> fieldname2INTLNameMapping;
+    const static QString CONFIG_INPUT_BUFFER_LIMIT_KEY;
     template<typename T>
     static void preprocessINTLFields(T &contact)
     {
@@ -41,10 +45,19 @@ protected:
                               QSqlRecord &record);
     void contactFields2SQLRecord(QMap<QString, QVariant> &contact,
                               QSqlRecord &record);
+    virtual qint64 streamPosition() override;
+
+    ExportFieldIndex exportFieldIndex;
+
 private:
 
     void readField(QString& field,
                    QString& value);
+    QString fieldName(const char *data, qsizetype len);
+    void releaseInput();
+    void unmapInput();
+    bool loadInputWindow(qint64 offset);
+    void flushExportBuffer();
     QDate parseDate(const QString &date);
     QTime parseTime(const QString &time);
     QString parseQslRcvd(const QString &value);
@@ -53,10 +66,7 @@ private:
     enum ParserState {
         START,
         FIELD,
-        KEY,
-        SIZE,
-        DATA_TYPE,
-        VALUE
+        KEY
     };
 
     static void preprocessINTLField(const QString &sourceField,
@@ -68,6 +78,21 @@ private:
 
     ParserState state = START;
     bool inHeader = false;
+
+    /* The whole input is parsed as one byte buffer - mapped file or one block read.
+     * Files which do not fit into one buffer are parsed in windows */
+    QByteArray inputBuffer;
+    qsizetype inputPos = 0;
+    qint64 inputOffset = 0;
+    QFile *mappedFile = nullptr;
+    uchar *mappedData = nullptr;
+    QFile *windowedFile = nullptr;
+    qint64 inputEnd = 0;
+    qint64 inputWindowSize = 0;
+
+    /* an exported record is composed in the buffer and written to the stream at once */
+    QString exportBuffer;
+    QHash<QByteArray, QString> fieldNameCache;
 };
 
 #endif // ADIF2FORMAT_H
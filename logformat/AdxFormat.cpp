@@ -7,10 +7,14 @@
 
 MODULE_IDENTIFICATION("qlog.logformat.adxformat");
 
+#define OUTPUT_BUFFER_SIZE (1024 * 1024)
+
 AdxFormat::AdxFormat(QTextStream &stream) :
     AdiFormat(stream),
     writer(nullptr),
-    reader(nullptr)
+    reader(nullptr),
+    intlFields(fieldname2INTLNameMapping.values()),
+    intlFieldIndex(intlFields)
 {
     FCT_IDENTIFICATION;
 }
@@ -66,7 +70,11 @@ void AdxFormat::exportStart()
 
     QString date = QDateTime::currentDateTimeUtc().toString("yyyyMMdd hhmmss");
 
-    writer = new QXmlStreamWriter(stream.device());
+    /* XML is written to a memory buffer which is written to the device in large blocks */
+    outputBuffer.buffer().reserve(OUTPUT_BUFFER_SIZE);
+    outputBuffer.open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+
+    writer = new QXmlStreamWriter(&outputBuffer);
 
     writer->setAutoFormatting(true);
 
@@ -92,7 +100,22 @@ void AdxFormat::exportEnd()
         writer->writeEndDocument();
         delete writer;
         writer = nullptr;
+        flushOutputBuffer();
+        outputBuffer.close();
+    }
+}
+
+void AdxFormat::flushOutputBuffer()
+{
+    FCT_IDENTIFICATION;
+
+    if ( stream.device() )
+    {
+        stream.device()->write(outputBuffer.data());
     }
+
+    outputBuffer.seek(0);
+    outputBuffer.buffer().resize(0);
 }
 
 void AdxFormat::exportContact(const QSqlRecord& record, QMap<QString, QString> *applTags)
@@ -112,6 +135,11 @@ void AdxFormat::exportContact(const QSqlRecord& record, QMap<QString, QString> *
     writeSQLRecord(record, applTags);
 
     writer->writeEndElement();
+
+    if ( outputBuffer.size() >= OUTPUT_BUFFER_SIZE )
+    {
+        flushOutputBuffer();
+    }
 }
 
 void AdxFormat::writeField(const QString &name,
@@ -139,11 +167,12 @@ void AdxFormat::writeSQLRecord(const QSqlRecord &record, QMap<QString, QString>
 
     // Add _INTL fields
 
-    QStringList fieldMappingList = fieldname2INTLNameMapping.values();
-    for ( const QString& value :  qAsConst(fieldMappingList) )
+    intlFieldIndex.resolve(record);
+
+    for ( int i = 0; i < intlFields.size(); i++ )
     {
-        writeField(value, record.value(value).isValid(),
-                   record.value(value).toString());
+        const QVariant value = intlFieldIndex.value(record, i);
+        writeField(intlFields.at(i), value.isValid(), value.toString());
     }
 }
 
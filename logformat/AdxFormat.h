@@ -2,6 +2,7 @@
 #define ADXFORMAT_H
 
 #include <QXmlStreamWriter>
+#include <QBuffer>
 
 #include "AdiFormat.h"
 
@@ -28,8 +29,13 @@ protected:
     virtual bool readContact(QVariantMap& ) override;
 
 private:
+    void flushOutputBuffer();
+
     QXmlStreamWriter *writer;
     QXmlStreamReader *reader;
+    QBuffer outputBuffer;
+    const QStringList intlFields;
+    ExportFieldIndex intlFieldIndex;
 };
 
 #endif // ADXFORMAT_H
@@ -0,0 +1,239 @@
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlField>
+#include <QObject>
+#include "ContactBulkInserter.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.logformat.contactbulkinserter");
+
+ContactBulkInserter::ContactBulkInserter(const QSqlDatabase &db, int commitSize) :
+    db(db),
+    insertQuery(db),
+    commitSize(( commitSize > 0 ) ? commitSize : DEFAULT_COMMIT_SIZE),
+    pendingRows(0),
+    started(false)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << commitSize;
+
+    contactRecord = this->db.record("contacts");
+    contactRecord.remove(contactRecord.indexOf("id"));
+}
+
+ContactBulkInserter::~ContactBulkInserter()
+{
+    FCT_IDENTIFICATION;
+
+    if ( started )
+    {
+        finish();
+    }
+}
+
+bool ContactBulkInserter::start()
+{
+    FCT_IDENTIFICATION;
+
+    if ( started )
+    {
+        return true;
+    }
+
+    QStringList columns;
+    QStringList placeholders;
+
+    for ( int i = 0; i < contactRecord.count(); i++ )
+    {
+        columns << db.driver()->escapeIdentifier(contactRecord.fieldName(i), QSqlDriver::FieldName);
+        placeholders << "?";
+    }
+
+    if ( ! insertQuery.prepare(QString("INSERT INTO contacts (%1) VALUES (%2)").arg(columns.join(", "),
+                                                                                 placeholders.join(", "))) )
+    {
+        errorString = insertQuery.lastError().text();
+        qWarning() << "Cannot prepare insert statement" << insertQuery.lastError();
+        return false;
+    }
+
+    /* pragmas cannot be changed inside a transaction */
+    setImportPragmas();
+
+    if ( ! db.transaction() )
+    {
+        errorString = db.lastError().text();
+        qWarning() << "Cannot start a transaction" << db.lastError();
+        restorePragmas();
+        return false;
+    }
+
+    pendingRows = 0;
+    started = true;
+    return true;
+}
+
+bool ContactBulkInserter::insert(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    if ( !started )
+    {
+        errorString = QObject::tr("Insert is not started");
+        return false;
+    }
+
+    /* the record is expected to be created from record() therefore the field order is the same */
+    for ( int i = 0; i < contactRecord.count(); i++ )
+    {
+        insertQuery.bindValue(i, record.value(i));
+    }
+
+    if ( ! insertQuery.exec() )
+    {
+        errorString = insertQuery.lastError().text();
+        qCDebug(runtime) << "Cannot insert a record" << insertQuery.lastError();
+        return false;
+    }
+
+    pendingRows++;
+    return true;
+}
+
+qlonglong ContactBulkInserter::lastInsertId() const
+{
+    const QVariant id = insertQuery.lastInsertId();
+
+    return ( id.isValid() ) ? id.toLongLong() : -1;
+}
+
+bool ContactBulkInserter::isBatchFull() const
+{
+    return pendingRows >= commitSize;
+}
+
+bool ContactBulkInserter::commit()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !started )
+    {
+        return false;
+    }
+
+    qCDebug(runtime) << "Committing" << pendingRows << "rows";
+
+    pendingRows = 0;
+
+    if ( ! db.commit() )
+    {
+        errorString = db.lastError().text();
+        qWarning() << "Cannot commit changes to Contact Table - " << db.lastError();
+        db.rollback();
+        db.transaction();
+        return false;
+    }
+
+    return db.transaction();
+}
+
+bool ContactBulkInserter::finish()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !started )
+    {
+        return true;
+    }
+
+    bool ret = true;
+
+    insertQuery.finish();
+
+    if ( ! db.commit() )
+    {
+        errorString = db.lastError().text();
+        qWarning() << "Cannot commit changes to Contact Table - " << db.lastError();
+        db.rollback();
+        ret = false;
+    }
+
+    started = false;
+    pendingRows = 0;
+    restorePragmas();
+
+    return ret;
+}
+
+const QSqlRecord &ContactBulkInserter::record() const
+{
+    return contactRecord;
+}
+
+QString ContactBulkInserter::lastError() const
+{
+    return errorString;
+}
+
+void ContactBulkInserter::setImportPragmas()
+{
+    FCT_IDENTIFICATION;
+
+    savedSynchronous = pragmaValue("synchronous");
+    savedAutoCheckpoint = pragmaValue("wal_autocheckpoint");
+
+    /* The journal mode is kept (WAL), because it cannot be switched while other
+     * connections are open. Instead of it, WAL checkpoints are postponed
+     * to the end of the import */
+    QSqlQuery query(db);
+
+    if ( ! query.exec("PRAGMA synchronous = OFF") )
+    {
+        qCDebug(runtime) << "Cannot set PRAGMA synchronous" << query.lastError();
+    }
+
+    if ( ! query.exec("PRAGMA wal_autocheckpoint = 0") )
+    {
+        qCDebug(runtime) << "Cannot set PRAGMA wal_autocheckpoint" << query.lastError();
+    }
+}
+
+void ContactBulkInserter::restorePragmas()
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query(db);
+
+    if ( !savedSynchronous.isEmpty()
+         && ! query.exec(QString("PRAGMA synchronous = %1").arg(savedSynchronous.toInt())) )
+    {
+        qCDebug(runtime) << "Cannot restore PRAGMA synchronous" << query.lastError();
+    }
+
+    if ( !savedAutoCheckpoint.isEmpty()
+         && ! query.exec(QString("PRAGMA wal_autocheckpoint = %1").arg(savedAutoCheckpoint.toInt())) )
+    {
+        qCDebug(runtime) << "Cannot restore PRAGMA wal_autocheckpoint" << query.lastError();
+    }
+
+    if ( ! query.exec("PRAGMA wal_checkpoint(PASSIVE)") )
+    {
+        qCDebug(runtime) << "Cannot run WAL checkpoint" << query.lastError();
+    }
+}
+
+QString ContactBulkInserter::pragmaValue(const QString &name)
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query(db);
+
+    if ( ! query.exec(QString("PRAGMA %1").arg(name)) || !query.next() )
+    {
+        qCDebug(runtime) << "Cannot read PRAGMA" << name << query.lastError();
+        return QString();
+    }
+
+    return query.value(0).toString();
+}
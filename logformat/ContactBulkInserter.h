@@ -0,0 +1,46 @@
+#ifndef CONTACTBULKINSERTER_H
+#define CONTACTBULKINSERTER_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+/* Bulk insert path for the contacts table. It uses one prepared INSERT statement
+ * with the column list resolved once and commits every commitSize rows.
+ * SQLite pragmas are switched to import-friendly values until finish() is called */
+class ContactBulkInserter
+{
+public:
+    explicit ContactBulkInserter(const QSqlDatabase &db = QSqlDatabase::database(),
+                                 int commitSize = DEFAULT_COMMIT_SIZE);
+    ~ContactBulkInserter();
+
+    bool start();
+    bool insert(const QSqlRecord &record);
+    qlonglong lastInsertId() const;
+    bool isBatchFull() const;
+    bool commit();
+    bool finish();
+
+    const QSqlRecord &record() const;
+    QString lastError() const;
+
+    static const int DEFAULT_COMMIT_SIZE = 500;
+
+private:
+    void setImportPragmas();
+    void restorePragmas();
+    QString pragmaValue(const QString &name);
+
+    QSqlDatabase db;
+    QSqlQuery insertQuery;
+    QSqlRecord contactRecord;
+    int commitSize;
+    int pendingRows;
+    bool started;
+    QString errorString;
+    QString savedSynchronous;
+    QString savedAutoCheckpoint;
+};
+
+#endif // CONTACTBULKINSERTER_H
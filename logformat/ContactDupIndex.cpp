@@ -0,0 +1,127 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <algorithm>
+#include "ContactDupIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.logformat.contactdupindex");
+
+ContactDupIndex::ContactDupIndex(const QSqlDatabase &db) :
+    db(db),
+    entries(0)
+{
+    FCT_IDENTIFICATION;
+}
+
+bool ContactDupIndex::load()
+{
+    FCT_IDENTIFICATION;
+
+    index.clear();
+    entries = 0;
+
+    QSqlQuery query(db);
+
+    query.setForwardOnly(true);
+
+    /* callsign is not converted to uppercase, the same as in the original
+     * SQL duplicate condition callsign = upper(:callsign) */
+    if ( ! query.exec("SELECT id, callsign, upper(band), upper(mode), "
+                      "       CAST(strftime('%s', start_time) AS INTEGER) "
+                      "FROM contacts") )
+    {
+        qWarning() << "Cannot load Dup Index" << query.lastError();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        Entry entry;
+        entry.contactID = query.value(0).toLongLong();
+        entry.startTime = query.value(4).toLongLong();
+        index[query.value(1).toString()
+              + QChar('|') + query.value(2).toString()
+              + QChar('|') + query.value(3).toString()].append(entry);
+        entries++;
+    }
+
+    for ( QVector<Entry> &group : index )
+    {
+        std::sort(group.begin(), group.end());
+    }
+
+    qCDebug(runtime) << "Dup Index loaded" << entries << "contacts" << index.size() << "groups";
+
+    return true;
+}
+
+qlonglong ContactDupIndex::find(const QString &callsign,
+                                const QString &band,
+                                const QString &mode,
+                                const QDateTime &startTime) const
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsign << band << mode << startTime;
+
+    QHash<QString, QVector<Entry>>::const_iterator group = index.constFind(indexKey(callsign, band, mode));
+
+    if ( group == index.constEnd() )
+    {
+        return -1;
+    }
+
+    const qint64 time = startTime.toSecsSinceEpoch();
+    Entry lowerBound;
+    lowerBound.startTime = time - DUPLICATE_WINDOW_SECS + 1;
+    lowerBound.contactID = -1;
+
+    QVector<Entry>::const_iterator it = std::lower_bound(group->constBegin(),
+                                                         group->constEnd(),
+                                                         lowerBound);
+
+    if ( it != group->constEnd()
+         && it->startTime < time + DUPLICATE_WINDOW_SECS )
+    {
+        return it->contactID;
+    }
+
+    return -1;
+}
+
+void ContactDupIndex::insert(qlonglong contactID,
+                             const QString &callsign,
+                             const QString &band,
+                             const QString &mode,
+                             const QDateTime &startTime)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contactID << callsign << band << mode << startTime;
+
+    Entry entry;
+    entry.contactID = contactID;
+    entry.startTime = startTime.toSecsSinceEpoch();
+
+    /* the stored callsign is used as is - see load() */
+    insertEntry(callsign + QChar('|') + band.toUpper() + QChar('|') + mode.toUpper(), entry);
+}
+
+int ContactDupIndex::count() const
+{
+    return entries;
+}
+
+QString ContactDupIndex::indexKey(const QString &callsign,
+                                  const QString &band,
+                                  const QString &mode)
+{
+    return callsign.toUpper() + QChar('|') + band.toUpper() + QChar('|') + mode.toUpper();
+}
+
+void ContactDupIndex::insertEntry(const QString &key, const Entry &entry)
+{
+    QVector<Entry> &group = index[key];
+    group.insert(std::upper_bound(group.begin(), group.end(), entry), entry);
+    entries++;
+}
@@ -0,0 +1,54 @@
+#ifndef CONTACTDUPINDEX_H
+#define CONTACTDUPINDEX_H
+
+#include <QHash>
+#include <QVector>
+#include <QDateTime>
+#include <QSqlDatabase>
+
+/* In-memory index of contacts used for duplicate detection during an import.
+ * Contacts are grouped by (callsign, band, mode) and every group holds
+ * sorted start times. A duplicate is a contact of the same group
+ * whose start time differs less than 30 minutes */
+class ContactDupIndex
+{
+public:
+    explicit ContactDupIndex(const QSqlDatabase &db = QSqlDatabase::database());
+
+    bool load();
+    qlonglong find(const QString &callsign,
+                   const QString &band,
+                   const QString &mode,
+                   const QDateTime &startTime) const;
+    void insert(qlonglong contactID,
+                const QString &callsign,
+                const QString &band,
+                const QString &mode,
+                const QDateTime &startTime);
+    int count() const;
+
+    static const qint64 DUPLICATE_WINDOW_SECS = 30 * 60;
+
+private:
+    struct Entry
+    {
+        qint64 startTime;
+        qlonglong contactID;
+
+        bool operator<(const Entry &other) const
+        {
+            return startTime < other.startTime;
+        }
+    };
+
+    static QString indexKey(const QString &callsign,
+                            const QString &band,
+                            const QString &mode);
+    void insertEntry(const QString &key, const Entry &entry);
+
+    QSqlDatabase db;
+    QHash<QString, QVector<Entry>> index;
+    int entries;
+};
+
+#endif // CONTACTDUPINDEX_H
@@ -0,0 +1,66 @@
+#include <QSqlRecord>
+#include "ExportFieldIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.logformat.exportfieldindex");
+
+ExportFieldIndex::ExportFieldIndex(const QStringList &columns) :
+    columns(columns),
+    positions(columns.size(), -1),
+    layoutFieldCount(-1)
+{
+    FCT_IDENTIFICATION;
+}
+
+void ExportFieldIndex::resolve(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    if ( isResolved(record) )
+    {
+        return;
+    }
+
+    qCDebug(runtime) << "Resolving record layout with" << record.count() << "fields";
+
+    for ( int i = 0; i < columns.size(); i++ )
+    {
+        positions[i] = record.indexOf(columns.at(i));
+    }
+
+    layoutFieldCount = record.count();
+}
+
+QVariant ExportFieldIndex::value(const QSqlRecord &record, int column) const
+{
+    const int position = positions.at(column);
+
+    return ( position < 0 ) ? QVariant() : record.value(position);
+}
+
+int ExportFieldIndex::count() const
+{
+    return columns.size();
+}
+
+bool ExportFieldIndex::isResolved(const QSqlRecord &record) const
+{
+    /* Exported records are usually produced by one query therefore they have
+     * the same layout. The layout is considered the same when the number of fields
+     * is the same and all resolved columns are at their positions */
+    if ( record.count() != layoutFieldCount )
+    {
+        return false;
+    }
+
+    for ( int i = 0; i < positions.size(); i++ )
+    {
+        if ( positions.at(i) >= 0
+             && record.fieldName(positions.at(i)) != columns.at(i) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
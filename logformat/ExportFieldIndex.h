@@ -0,0 +1,30 @@
+#ifndef EXPORTFIELDINDEX_H
+#define EXPORTFIELDINDEX_H
+
+#include <QStringList>
+#include <QVector>
+#include <QVariant>
+
+class QSqlRecord;
+
+/* Positions of exported columns in a record. The positions are resolved once
+ * per record layout therefore values are read by index instead of
+ * searching a field by its name for every field of every exported record */
+class ExportFieldIndex
+{
+public:
+    explicit ExportFieldIndex(const QStringList &columns);
+
+    void resolve(const QSqlRecord &record);
+    QVariant value(const QSqlRecord &record, int column) const;
+    int count() const;
+
+private:
+    bool isResolved(const QSqlRecord &record) const;
+
+    QStringList columns;
+    QVector<int> positions;
+    int layoutFieldCount;
+};
+
+#endif // EXPORTFIELDINDEX_H
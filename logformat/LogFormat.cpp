@@ -4,16 +4,25 @@
 #include "AdxFormat.h"
 #include "JsonFormat.h"
 #include "CSVFormat.h"
+#include "ContactBulkInserter.h"
+#include "ContactDupIndex.h"
+#include "QSLMerger.h"
 #include "data/Data.h"
 #include "core/debug.h"
 #include "core/Gridsquare.h"
 
 MODULE_IDENTIFICATION("qlog.logformat.logformat");
 
+// Import log lines are sent in batches - max once per interval (ms) or when the batch is full
+#define IMPORT_LOG_INTERVAL 500
+#define IMPORT_LOG_BATCH_SIZE 1000
+
 LogFormat::LogFormat(QTextStream& stream) :
     QObject(nullptr),
     stream(stream),
+    db(QSqlDatabase::database()),
     exportedFields("*"),
+    importCommitSize(ContactBulkInserter::DEFAULT_COMMIT_SIZE),
     duplicateQSOFunc(nullptr)
 {
     FCT_IDENTIFICATION;
@@ -225,6 +234,15 @@ void LogFormat::setUpdateDxcc(bool updateDxcc) {
     this->updateDxcc = updateDxcc;
 }
 
+void LogFormat::setImportCommitSize(int commitSize)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << commitSize;
+
+    importCommitSize = commitSize;
+}
+
 void LogFormat::setDuplicateQSOCallback(duplicateQSOBehaviour (*func)(QSqlRecord *, QSqlRecord *))
 {
     FCT_IDENTIFICATION;
@@ -232,42 +250,108 @@ void LogFormat::setDuplicateQSOCallback(duplicateQSOBehaviour (*func)(QSqlRecord
     duplicateQSOFunc = func;
 }
 
+void LogFormat::setDatabase(const QSqlDatabase &database)
+{
+    FCT_IDENTIFICATION;
+
+    db = database;
+}
+
+void LogFormat::cancel()
+{
+    FCT_IDENTIFICATION;
+
+    cancelled.storeRelease(1);
+}
+
+bool LogFormat::isCancelled() const
+{
+    return cancelled.loadAcquire() != 0;
+}
+
+LogFormat::duplicateQSOBehaviour LogFormat::askDuplicateQSO(QSqlRecord *imported, QSqlRecord *original)
+{
+    FCT_IDENTIFICATION;
+
+    if ( QThread::currentThread() == QCoreApplication::instance()->thread() )
+    {
+        return duplicateQSOFunc(imported, original);
+    }
+
+    /* the import runs in a worker thread but the callback shows a dialog -
+     * it has to be called in the GUI thread */
+    duplicateQSOBehaviour ret = ASK_NEXT;
+
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [&]()
+    {
+        ret = duplicateQSOFunc(imported, original);
+    }, Qt::BlockingQueuedConnection);
+
+    return ret;
+}
+
+bool LogFormat::isProgressDue()
+{
+    /* progress is sent max 10 times per second - the receiver can be in another thread */
+    if ( progressTimer.isValid() && progressTimer.elapsed() < 100 )
+    {
+        return false;
+    }
+
+    progressTimer.start();
+    return true;
+}
+
 unsigned long LogFormat::runImport(QTextStream& importLogStream,
                                    unsigned long *warnings,
                                    unsigned long *errors)
 {
     FCT_IDENTIFICATION;
 
-    this->importStart();
-
     unsigned long count = 0L;
     *errors = 0L;
     *warnings = 0L;
     unsigned long processedRec = 0;
 
-    QSqlQuery dupQuery;
+    QSqlQuery dupQuery(db);
 
-    // It is important to use callsign index here
-    if ( ! dupQuery.prepare("SELECT * FROM contacts "
-                            "WHERE callsign=upper(:callsign) "
-                            "AND upper(mode)=upper(:mode) "
-                            "AND upper(band)=upper(:band) "
-                            "AND ABS(JULIANDAY(start_time)-JULIANDAY(datetime(:startdate)))*24*60<30") )
+    if ( ! dupQuery.prepare("SELECT * FROM contacts WHERE id = :id") )
     {
         qWarning() << "cannot prepare Dup statement";
         return 0;
     }
 
-    QSqlDatabase::database().transaction();
+    /* Duplicates are searched in memory - it contains existing contacts
+     * and contacts inserted by this import */
+    ContactDupIndex dupIndex(db);
 
-    QSqlTableModel model;
-    model.setTable("contacts");
-    model.removeColumn(model.fieldIndex("id"));
-    QSqlRecord record = model.record();
-    model.setEditStrategy(QSqlTableModel::OnManualSubmit);
+    if ( ! dupIndex.load() )
+    {
+        qWarning() << "cannot load Dup Index";
+        return 0;
+    }
+
+    ContactBulkInserter inserter(db, importCommitSize);
+
+    if ( ! inserter.start() )
+    {
+        qWarning() << "Cannot start the import - " << inserter.lastError();
+        writeImportLog(importLogStream,
+                       ERROR_SEVERITY,
+                       tr("Cannot insert to database") + " - " + inserter.lastError());
+        flushImportLog();
+        (*errors)++;
+        return 0;
+    }
+
+    /* the input is opened (mapped) only when all DB objects are ready
+     * therefore the error paths above do not have to call importEnd() */
+    this->importStart();
+
+    QSqlRecord record = inserter.record();
     duplicateQSOBehaviour dupSetting = LogFormat::ASK_NEXT;
 
-    while (true)
+    while ( !isCancelled() )
     {
         record.clearValues();
 
@@ -293,9 +377,9 @@ unsigned long LogFormat::runImport(QTextStream& importLogStream,
             continue;
         }
 
-        if ( processedRec % 10 == 0)
+        if ( isProgressDue() )
         {
-            emit importPosition(stream.pos());
+            emit importPosition(streamPosition());
         }
 
         if ( isDateRange() )
@@ -321,17 +405,12 @@ unsigned long LogFormat::runImport(QTextStream& importLogStream,
 
         if ( dupSetting != ACCEPT_ALL )
         {
-            dupQuery.bindValue(":callsign", record.value("callsign"));
-            dupQuery.bindValue(":mode", record.value("mode"));
-            dupQuery.bindValue(":band", record.value("band"));
-            dupQuery.bindValue(":startdate", record.value("start_time").toDateTime().toTimeSpec(Qt::UTC).toString("yyyy-MM-dd hh:mm:ss"));
-
-            if ( !dupQuery.exec() )
-            {
-                qWarning() << "Cannot exect DUP statement";
-            }
+            qlonglong dupContactID = dupIndex.find(record.value("callsign").toString(),
+                                                   record.value("band").toString(),
+                                                   record.value("mode").toString(),
+                                                   record.value("start_time").toDateTime());
 
-            if ( dupQuery.next() )
+            if ( dupContactID >= 0 )
             {
                 if ( dupSetting == SKIP_ALL)
                 {
@@ -348,8 +427,19 @@ unsigned long LogFormat::runImport(QTextStream& importLogStream,
                 if ( duplicateQSOFunc )
                 {
                     QSqlRecord dupRecord;
-                    dupRecord= dupQuery.record();
-                    dupSetting = duplicateQSOFunc(&record, &dupRecord);
+
+                    dupQuery.bindValue(":id", dupContactID);
+
+                    if ( !dupQuery.exec() )
+                    {
+                        qWarning() << "Cannot exect DUP statement";
+                    }
+                    else if ( dupQuery.next() )
+                    {
+                        dupRecord = dupQuery.record();
+                    }
+
+                    dupSetting = askDuplicateQSO(&record, &dupRecord);
                 }
 
                 switch ( dupSetting )
@@ -492,14 +582,14 @@ unsigned long LogFormat::runImport(QTextStream& importLogStream,
             }
         }
 
-        if ( !model.insertRecord(-1, record) )
+        if ( !inserter.insert(record) )
         {
             writeImportLog(importLogStream,
                            ERROR_SEVERITY,
                            processedRec,
                            record,
-                           tr("Cannot insert to database") + " - " + model.lastError().text());
-            qWarning() << "Cannot insert a record to Contact Table - " << model.lastError();
+                           tr("Cannot insert to database") + " - " + inserter.lastError());
+            qWarning() << "Cannot insert a record to Contact Table - " << inserter.lastError();
             qCDebug(runtime) << record;
             (*errors)++;
         }
@@ -510,43 +600,39 @@ unsigned long LogFormat::runImport(QTextStream& importLogStream,
                            processedRec,
                            record,
                            tr("Imported"));
+            dupIndex.insert(inserter.lastInsertId(),
+                            record.value("callsign").toString(),
+                            record.value("band").toString(),
+                            record.value("mode").toString(),
+                            record.value("start_time").toDateTime());
+            Data::instance()->updateDxccStatusContact(inserter.lastInsertId(), record);
             count++;
         }
 
-        if ( count % 50 == 0 )
+        if ( inserter.isBatchFull() && ! inserter.commit() )
         {
-            if (! model.submitAll() )
-            {
-                qWarning() << "Cannot commit changes to Contact Table - " << model.lastError();
-                writeImportLog(importLogStream,
-                               ERROR_SEVERITY,
-                               tr("Cannot commit the changes to database") + " - " + model.lastError().text());
-                (*errors)++;
-            }
-            else
-            {
-                QSqlDatabase::database().commit();
-                QSqlDatabase::database().transaction();
-            }
+            Data::invalidateDxccStatus();
+            writeImportLog(importLogStream,
+                           ERROR_SEVERITY,
+                           tr("Cannot commit the changes to database") + " - " + inserter.lastError());
+            (*errors)++;
         }
-
     }
 
-    emit importPosition(stream.pos());
+    emit importPosition(streamPosition());
     emit finished(count);
 
-    if (! model.submitAll() )
+    if ( ! inserter.finish() )
     {
-        qWarning() << "Cannot commit changes to Contact Table - " << model.lastError();
+        Data::invalidateDxccStatus();
         writeImportLog(importLogStream,
                        ERROR_SEVERITY,
-                       tr("Cannot commit the changes to database") + " - " + model.lastError().text());
+                       tr("Cannot commit the changes to database") + " - " + inserter.lastError());
         (*errors)++;
     }
 
-    QSqlDatabase::database().commit();
-
     this->importEnd();
+    flushImportLog();
 
     return count;
 }
@@ -559,10 +645,19 @@ void LogFormat::runQSLImport(QSLFrom fromService)
 
     this->importStart();
 
-    QSqlTableModel model;
-    model.setTable("contacts");
-    QSqlRecord QSLRecord = model.record(0);
+    QSLMerger merger(fromService, db);
 
+    if ( ! merger.start() )
+    {
+        qWarning() << "Cannot start QSL merge";
+        this->importEnd();
+        emit QSLMergeFinished(stats);
+        return;
+    }
+
+    QSqlRecord QSLRecord = db.record("contacts");
+
+    /* Step 1: stage all downloaded QSLs */
     while ( true )
     {
         QSLRecord.clearValues();
@@ -571,9 +666,9 @@ void LogFormat::runQSLImport(QSLFrom fromService)
 
         stats.qsos_checked++;
 
-        if ( stats.qsos_checked % 10 == 0 )
+        if ( isProgressDue() )
         {
-            emit importPosition(stream.pos());
+            emit importPosition(streamPosition());
         }
 
         /* checking matching fields if they are not empty */
@@ -588,199 +683,22 @@ void LogFormat::runQSLImport(QSLFrom fromService)
             continue;
         }
 
-        // It is important to use callsign index here
-        QString matchFilter = QString("callsign=upper('%1') AND upper(mode)=upper('%2') AND upper(band)=upper('%3') AND ABS(JULIANDAY(start_time)-JULIANDAY(datetime('%4')))*24*60<30")
-                .arg(QSLRecord.value("callsign").toString(),
-                     QSLRecord.value("mode").toString(),
-                     QSLRecord.value("band").toString(),
-                     QSLRecord.value("start_time").toDateTime().toTimeSpec(Qt::UTC).toString("yyyy-MM-dd hh:mm:ss"));
-
-        /* set filter */
-        model.setFilter(matchFilter);
-        model.select();
-
-        if ( model.rowCount() != 1 )
+        if ( ! merger.stage(QSLRecord) )
         {
-            stats.qsos_unmatched++;
-            stats.unmatchedQSLs.append(QSLRecord.value("callsign").toString());
-            continue;
-        }
-
-        /* we have one row for updating */
-        /* lets update it */
-        QSqlRecord originalRecord = model.record(0);
-
-        switch ( fromService )
-        {
-        case LOTW:
-        {
-            /* https://lotw.arrl.org/lotw-help/developer-query-qsos-qsls/?lang=en */
-            if ( !QSLRecord.value("lotw_qsl_rcvd").toString().isEmpty() )
-            {
-                if ( QSLRecord.value("qsl_rcvd") != originalRecord.value("lotw_qsl_rcvd")
-                     && QSLRecord.value("qsl_rcvd").toString() == 'Y' )
-                {
-                    originalRecord.setValue("lotw_qsl_rcvd", QSLRecord.value("qsl_rcvd"));
-
-                    originalRecord.setValue("lotw_qslrdate", QSLRecord.value("qsl_rdate"));
-
-                    Gridsquare dxNewGrid(QSLRecord.value("gridsquare").toString());
-
-                    if ( dxNewGrid.isValid()
-                         && ( originalRecord.value("gridsquare").toString().isEmpty()
-                              ||
-                              dxNewGrid.getGrid().contains(originalRecord.value("gridsquare").toString()))
-                       )
-                    {
-                        Gridsquare myGrid(originalRecord.value("my_gridsquare").toString());
-
-                        originalRecord.setValue("gridsquare", dxNewGrid.getGrid());
-
-                        double distance;
-
-                        if ( myGrid.distanceTo(dxNewGrid, distance) )
-                        {
-                            originalRecord.setValue("distance", QVariant(distance));
-                        }
-                    }
-
-                    if ( !QSLRecord.value("credit_granted").toString().isEmpty() )
-                    {
-                        originalRecord.setValue("credit_granted", QSLRecord.value("credit_granted"));
-                    }
-
-                    if ( !QSLRecord.value("credit_submitted").toString().isEmpty() )
-                    {
-                        originalRecord.setValue("credit_submitted", QSLRecord.value("credit_submitted"));
-                    }
-
-                    if ( !QSLRecord.value("pfx").toString().isEmpty() )
-                    {
-                        originalRecord.setValue("pfx", QSLRecord.value("pfx"));
-                    }
-
-                    if ( !QSLRecord.value("iota").toString().isEmpty() )
-                    {
-                        originalRecord.setValue("iota", QSLRecord.value("iota"));
-                    }
-
-                    if ( !QSLRecord.value("vucc_grids").toString().isEmpty() )
-                    {
-                        originalRecord.setValue("vucc_grids", QSLRecord.value("vucc_grids"));
-                    }
-
-                    if ( !QSLRecord.value("state").toString().isEmpty() )
-                    {
-                        originalRecord.setValue("state", QSLRecord.value("state"));
-                    }
-
-                    if ( !QSLRecord.value("cnty").toString().isEmpty() )
-                    {
-                        originalRecord.setValue("cnty", QSLRecord.value("cnty"));
-                    }
-
-                    originalRecord.setValue("qsl_rcvd_via", "E");
-
-                    if ( !model.setRecord(0, originalRecord) )
-                    {
-                        qWarning() << "Cannot update a Contact record - " << model.lastError();
-                        qCDebug(runtime) << originalRecord;
-                    }
-
-                    if ( !model.submitAll() )
-                    {
-                        qWarning() << "Cannot commit changes to Contact Table - " << model.lastError();
-                    }
-                    stats.qsos_updated++;
-                    stats.newQSLs.append(QSLRecord.value("callsign").toString());
-                }
-            }
-            else
-            {
-                qCInfo(runtime) << "Malformed Lotw Record " << QSLRecord;
-            }
-            break;
-        }
-
-        case EQSL:
-        {
-            /* http://www.eqsl.cc/qslcard/DownloadInBox.txt */
-            /*   CALL
-                 QSO_DATE
-                 TIME_ON
-                 BAND
-                 MODE
-                 SUBMODE (tag only present if non-blank)
-                 PROP_MODE (tag only present if non-blank)
-                 RST_SENT (will be the sender's RST Sent, not yours)
-                 RST_RCVD (we do not capture this in uploads, so will normally be 0 length)
-                 QSL_SENT (always Y)
-                 QSL_SENT_VIA (always E)
-                 QSLMSG (if non-null and containing only valid printable ASCII characters)
-                 QSLMSG_INTL (if non-null and containing international characters - see ADIF V3 specs)
-                 APP_EQSL_SWL (tag only present if sender is SWL and then always Y)
-                 APP_EQSL_AG (tag only present if sender has Authenticity Guaranteed status and then always Y)
-                 GRIDSQUARE (tag only present if non-blank and at least 4 long)
-            */
-
-            if ( originalRecord.value("eqsl_qsl_rcvd").toString() != 'Y' )
-            {
-                originalRecord.setValue("eqsl_qsl_rcvd", QSLRecord.value("qsl_sent"));
-
-                originalRecord.setValue("eqsl_qslrdate", QDateTime::currentDateTimeUtc().date().toString("yyyy-MM-dd"));
-
-                Gridsquare dxNewGrid(QSLRecord.value("gridsquare").toString());
-
-                if ( dxNewGrid.isValid()
-                     && ( originalRecord.value("gridsquare").toString().isEmpty()
-                          ||
-                          dxNewGrid.getGrid().contains(originalRecord.value("gridsquare").toString()))
-                     )
-                {
-                    Gridsquare myGrid(originalRecord.value("my_gridsquare").toString());
-
-                    originalRecord.setValue("gridsquare", dxNewGrid.getGrid());
-
-                    double distance;
-
-                    if ( myGrid.distanceTo(dxNewGrid, distance) )
-                    {
-                        originalRecord.setValue("distance", QVariant(distance));
-                    }
-                }
-
-                originalRecord.setValue("qslmsg", QSLRecord.value("qslmsg"));
-
-                originalRecord.setValue("qslmsg_int", QSLRecord.value("qslmsg_int"));
-
-                originalRecord.setValue("qsl_rcvd_via", QSLRecord.value("qsl_sent_via"));
-
-                if ( !model.setRecord(0, originalRecord) )
-                {
-                    qWarning() << "Cannot update a Contact record - " << model.lastError();
-                    qCDebug(runtime) << originalRecord;
-                }
-
-                if ( !model.submitAll() )
-                {
-                    qWarning() << "Cannot commit changes to Contact Table - " << model.lastError();
-                }
-                stats.qsos_updated++;
-                stats.newQSLs.append(QSLRecord.value("callsign").toString());
-            }
-
-            break;
-        }
-
-        default:
-            qCDebug(runtime) << "Uknown QSL import";
+            stats.qsos_errors++;
         }
     }
 
-    emit importPosition(stream.pos());
+    emit importPosition(streamPosition());
 
     this->importEnd();
 
+    /* Step 2 and 3: match and update contacts */
+    if ( ! merger.merge(stats) )
+    {
+        qWarning() << "Cannot merge QSLs";
+    }
+
     emit QSLMergeFinished(stats);
 }
 
@@ -790,7 +708,9 @@ long LogFormat::runExport()
 
     this->exportStart();
 
-    QSqlQuery query;
+    QSqlQuery query(db);
+
+    query.setForwardOnly(true);
 
     QString queryStmt = QString("SELECT %1 FROM contacts WHERE %2 ORDER BY start_time ASC").arg(exportedFields.join(", "), getWhereClause());
 
@@ -811,22 +731,37 @@ long LogFormat::runExport()
     }
 
     long count = 0L;
+    int rows = 0;
+
+    /* SQLite does not return a correct value for QSqlQuery.size
+     * therefore the number of rows is counted by an extra query. It allows to
+     * read the export query forward-only without caching all rows */
+    QSqlQuery countQuery(db);
+
+    if ( countQuery.prepare(QString("SELECT COUNT(*) FROM contacts WHERE %1").arg(getWhereClause())) )
+    {
+        bindWhereClause(countQuery);
 
-    /* following 3 lines are a workaround - SQLite does not
-     * return a correct value for QSqlQuery.size
-     */
-    int rows = (query.last()) ? query.at() + 1 : 0;
-    query.first();
-    query.previous();
+        if ( countQuery.exec() && countQuery.next() )
+        {
+            rows = countQuery.value(0).toInt();
+        }
+    }
 
-    while (query.next())
+    int lastProgress = -1;
+
+    while ( !isCancelled() && query.next() )
     {
-        QSqlRecord record = query.record();
-        this->exportContact(record);
+        this->exportContact(query.record());
         count++;
-        if (count % 10 == 0)
+
+        /* do not flood the receiver - emit only when the value is changed */
+        int progress = ( rows > 0 ) ? static_cast<int>(count * 100 / rows) : 0;
+
+        if ( progress != lastProgress )
         {
-            emit exportProgress((int)(count * 100 / rows));
+            lastProgress = progress;
+            emit exportProgress(progress);
         }
     }
 
@@ -843,8 +778,15 @@ long LogFormat::runExport(const QList<QSqlRecord> &selectedQSOs)
     this->exportStart();
 
     long count = 0L;
+    int lastProgress = -1;
+
     for (const QSqlRecord &qso: selectedQSOs)
     {
+        if ( isCancelled() )
+        {
+            break;
+        }
+
         QSqlRecord contactRecord;
 
         if ( exportedFields.first() != "*" )
@@ -860,9 +802,13 @@ long LogFormat::runExport(const QList<QSqlRecord> &selectedQSOs)
         }
         this->exportContact(contactRecord);
         count++;
-        if ( count % 10 == 0 )
+
+        int progress = static_cast<int>(count * 100 / selectedQSOs.size());
+
+        if ( progress != lastProgress )
         {
-            emit exportProgress((int)(count * 100 / selectedQSOs.size()));
+            lastProgress = progress;
+            emit exportProgress(progress);
         }
     }
 
@@ -904,11 +850,48 @@ QString LogFormat::importLogSeverityToString(ImportLogSeverity severity)
     return QString();
 }
 
+void LogFormat::appendImportLog(const QString &line)
+{
+    FCT_IDENTIFICATION;
+
+    /* the receiver is in the GUI thread - lines are not sent one by one */
+    pendingImportLog.append(line);
+
+    if ( pendingImportLog.size() >= IMPORT_LOG_BATCH_SIZE
+         || !importLogTimer.isValid()
+         || importLogTimer.elapsed() >= IMPORT_LOG_INTERVAL )
+    {
+        flushImportLog();
+    }
+}
+
+void LogFormat::flushImportLog()
+{
+    FCT_IDENTIFICATION;
+
+    if ( pendingImportLog.isEmpty() )
+    {
+        return;
+    }
+
+    emit importLogLines(pendingImportLog);
+    pendingImportLog.clear();
+    importLogTimer.start();
+}
+
 void LogFormat::writeImportLog(QTextStream &errorLogStream, ImportLogSeverity severity, const QString &msg)
 {
     FCT_IDENTIFICATION;
 
-    errorLogStream << importLogSeverityToString(severity) << msg << "\n";
+    const QString line = importLogSeverityToString(severity) + msg;
+
+    // a stream without a device/string is used when only the signal is processed
+    if ( errorLogStream.device() || errorLogStream.string() )
+    {
+        errorLogStream << line << "\n";
+    }
+
+    appendImportLog(line);
 }
 
 void LogFormat::writeImportLog(QTextStream& errorLogStream, ImportLogSeverity severity,
@@ -918,12 +901,19 @@ void LogFormat::writeImportLog(QTextStream& errorLogStream, ImportLogSeverity se
 {
     FCT_IDENTIFICATION;
 
-    errorLogStream << QString("[QSO#%1]: ").arg(recordNo)
-                   << importLogSeverityToString(severity)
-                   << msg
-                   << QString(" (%1; %2; %3)").arg(record.value("start_time").toDateTime().toTimeSpec(Qt::UTC).toString(locale.formatDateShortWithYYYY()),
-                                                   record.value("callsign").toString(),
-                                                   record.value("mode").toString())
-                   << "\n";
+    const QString line = QString("[QSO#%1]: ").arg(recordNo)
+                         + importLogSeverityToString(severity)
+                         + msg
+                         + QString(" (%1; %2; %3)").arg(record.value("start_time").toDateTime().toTimeSpec(Qt::UTC).toString(locale.formatDateShortWithYYYY()),
+                                                        record.value("callsign").toString(),
+                                                        record.value("mode").toString());
+
+    // a stream without a device/string is used when only the signal is processed
+    if ( errorLogStream.device() || errorLogStream.string() )
+    {
+        errorLogStream << line << "\n";
+    }
+
+    appendImportLog(line);
 }
 
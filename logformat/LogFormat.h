@@ -4,6 +4,7 @@
 #include <QtCore>
 #include <QMap>
 #include <QSqlQuery>
+#include <QSqlDatabase>
 
 #include "core/LogLocale.h"
 
@@ -67,7 +68,11 @@ public:
     void bindWhereClause(QSqlQuery &);
     void setExportedFields(const QStringList& fieldsList);
     void setUpdateDxcc(bool updateDxcc);
+    void setImportCommitSize(int commitSize);
     void setDuplicateQSOCallback(duplicateQSOBehaviour (*func)(QSqlRecord *, QSqlRecord *));
+    void setDatabase(const QSqlDatabase &database);
+    void cancel();
+    bool isCancelled() const;
 
     virtual void importStart() {}
     virtual void importEnd() {}
@@ -82,10 +87,14 @@ signals:
     void exportProgress(float value);
     void finished(int count);
     void QSLMergeFinished(QSLMergeStat stats);
+    void importLogLines(QStringList lines);
 
 protected:
+    virtual qint64 streamPosition() { return stream.pos(); }
+
     QTextStream& stream;
     QMap<QString, QString>* defaults;
+    QSqlDatabase db;
 
 private:
     enum ImportLogSeverity
@@ -95,6 +104,8 @@ private:
         ERROR_SEVERITY
     };
 
+    duplicateQSOBehaviour askDuplicateQSO(QSqlRecord *imported, QSqlRecord *original);
+    bool isProgressDue();
     bool isDateRange();
     bool inDateRange(QDate date);
 
@@ -108,6 +119,8 @@ private:
                         const unsigned long recordNo,
                         const QSqlRecord &record,
                         const QString &msg);
+    void appendImportLog(const QString &line);
+    void flushImportLog();
     QDate filterStartDate, filterEndDate;
     QString filterMyCallsign;
     QString filterMyGridsquare;
@@ -116,8 +129,13 @@ private:
     QStringList whereClause;
     QStringList exportedFields;
     bool updateDxcc = false;
+    int importCommitSize;
     duplicateQSOBehaviour (*duplicateQSOFunc)(QSqlRecord *, QSqlRecord *);
     LogLocale locale;
+    QAtomicInt cancelled;
+    QElapsedTimer progressTimer;
+    QStringList pendingImportLog;
+    QElapsedTimer importLogTimer;
 };
 
 #endif // LOGFORMAT_H
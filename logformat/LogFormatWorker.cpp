@@ -0,0 +1,151 @@
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include "LogFormatWorker.h"
+#include "data/Data.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.logformat.logformatworker");
+
+LogFormatWorker::LogFormatWorker(LogFormat *format,
+                                 Operation operation,
+                                 QObject *parent) :
+    QThread(parent),
+    format(format),
+    operation(operation),
+    resultCount(0L),
+    resultWarnings(0L),
+    resultErrors(0L)
+{
+    FCT_IDENTIFICATION;
+
+    connect(this, &QThread::finished, this, &LogFormatWorker::workFinished);
+}
+
+LogFormatWorker::~LogFormatWorker()
+{
+    FCT_IDENTIFICATION;
+
+    if ( isRunning() )
+    {
+        cancel();
+        wait();
+    }
+}
+
+void LogFormatWorker::setExportedQSOs(const QList<QSqlRecord> &qsos)
+{
+    FCT_IDENTIFICATION;
+
+    exportedQSOs = qsos;
+}
+
+void LogFormatWorker::cancel()
+{
+    FCT_IDENTIFICATION;
+
+    if ( format )
+    {
+        format->cancel();
+    }
+}
+
+bool LogFormatWorker::isCancelled() const
+{
+    return format && format->isCancelled();
+}
+
+long LogFormatWorker::count() const
+{
+    return resultCount;
+}
+
+unsigned long LogFormatWorker::warnings() const
+{
+    return resultWarnings;
+}
+
+unsigned long LogFormatWorker::errors() const
+{
+    return resultErrors;
+}
+
+void LogFormatWorker::run()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !format )
+    {
+        return;
+    }
+
+    const QString connectionName = QString("logformat_%1").arg(reinterpret_cast<quintptr>(this), 0, 16);
+
+    if ( openDatabase(connectionName) )
+    {
+        format->setDatabase(QSqlDatabase::database(connectionName));
+
+        switch ( operation )
+        {
+        case IMPORT:
+        {
+            /* the import log is processed via importLogLines signal */
+            QTextStream importLogStream;
+            resultCount = format->runImport(importLogStream, &resultWarnings, &resultErrors);
+            break;
+        }
+
+        case EXPORT:
+            resultCount = ( exportedQSOs.isEmpty() ) ? format->runExport()
+                                                     : format->runExport(exportedQSOs);
+            break;
+        }
+
+        // release the worker's connection - it is removed below
+        format->setDatabase(QSqlDatabase());
+    }
+    else
+    {
+        resultErrors++;
+    }
+
+    {
+        QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+        db.close();
+    }
+
+    QSqlDatabase::removeDatabase(connectionName);
+
+    qCDebug(runtime) << "Worker finished" << resultCount << resultWarnings << resultErrors;
+}
+
+bool LogFormatWorker::openDatabase(const QString &connectionName)
+{
+    FCT_IDENTIFICATION;
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(Data::dbFilename());
+    db.setConnectOptions("QSQLITE_ENABLE_REGEXP");
+
+    if ( ! db.open() )
+    {
+        qWarning() << "Cannot open DB Connection for the worker" << db.lastError();
+        return false;
+    }
+
+    QSqlQuery query(db);
+
+    if ( ! query.exec("PRAGMA foreign_keys = ON") )
+    {
+        qWarning() << "Cannot set PRAGMA foreign_keys" << query.lastError();
+        return false;
+    }
+
+    /* the main connection can hold the lock for a short time */
+    if ( ! query.exec("PRAGMA busy_timeout = 5000") )
+    {
+        qWarning() << "Cannot set PRAGMA busy_timeout" << query.lastError();
+    }
+
+    return true;
+}
@@ -0,0 +1,51 @@
+#ifndef LOGFORMATWORKER_H
+#define LOGFORMATWORKER_H
+
+#include <QThread>
+#include <QSqlRecord>
+#include "LogFormat.h"
+
+/* Runs LogFormat import or export in a worker thread with its own DB connection.
+ * LogFormat signals (progress, import log lines) are delivered to the receivers
+ * in the GUI thread as queued signals. The operation can be cancelled by cancel() */
+class LogFormatWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    enum Operation
+    {
+        IMPORT,
+        EXPORT
+    };
+
+    explicit LogFormatWorker(LogFormat *format,
+                             Operation operation,
+                             QObject *parent = nullptr);
+    ~LogFormatWorker();
+
+    void setExportedQSOs(const QList<QSqlRecord> &qsos);
+    void cancel();
+    bool isCancelled() const;
+    long count() const;
+    unsigned long warnings() const;
+    unsigned long errors() const;
+
+signals:
+    void workFinished();
+
+protected:
+    virtual void run() override;
+
+private:
+    bool openDatabase(const QString &connectionName);
+
+    LogFormat *format;
+    Operation operation;
+    QList<QSqlRecord> exportedQSOs;
+    long resultCount;
+    unsigned long resultWarnings;
+    unsigned long resultErrors;
+};
+
+#endif // LOGFORMATWORKER_H
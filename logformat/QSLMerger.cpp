@@ -0,0 +1,455 @@
+#include <QSqlError>
+#include "QSLMerger.h"
+#include "data/Data.h"
+#include "core/Gridsquare.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.logformat.qslmerger");
+
+QSLMerger::QSLMerger(LogFormat::QSLFrom fromService,
+                     const QSqlDatabase &db) :
+    fromService(fromService),
+    db(db),
+    stageQuery(db),
+    lotwUpdateQuery(db),
+    eqslUpdateQuery(db),
+    stagedRows(0),
+    started(false)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << fromService;
+}
+
+QSLMerger::~QSLMerger()
+{
+    FCT_IDENTIFICATION;
+
+    if ( started )
+    {
+        db.rollback();
+    }
+
+    stageQuery.finish();
+    dropStage();
+}
+
+bool QSLMerger::start()
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query(db);
+
+    dropStage();
+
+    if ( ! query.exec("CREATE TEMP TABLE qsl_merge_stage ("
+                      "   row_no INTEGER PRIMARY KEY,"
+                      "   callsign TEXT,"
+                      "   band TEXT,"
+                      "   mode TEXT,"
+                      "   start_time TEXT,"
+                      "   qsl_rcvd TEXT,"
+                      "   qsl_rdate TEXT,"
+                      "   lotw_qsl_rcvd TEXT,"
+                      "   gridsquare TEXT,"
+                      "   credit_granted TEXT,"
+                      "   credit_submitted TEXT,"
+                      "   pfx TEXT,"
+                      "   iota TEXT,"
+                      "   vucc_grids TEXT,"
+                      "   state TEXT,"
+                      "   cnty TEXT,"
+                      "   qsl_sent TEXT,"
+                      "   qslmsg TEXT,"
+                      "   qslmsg_int TEXT,"
+                      "   qsl_sent_via TEXT)") )
+    {
+        qWarning() << "Cannot create QSL stage table" << query.lastError();
+        return false;
+    }
+
+    if ( ! stageQuery.prepare("INSERT INTO qsl_merge_stage (row_no, callsign, band, mode, start_time, "
+                              "                             qsl_rcvd, qsl_rdate, lotw_qsl_rcvd, gridsquare, "
+                              "                             credit_granted, credit_submitted, pfx, iota, "
+                              "                             vucc_grids, state, cnty, qsl_sent, qslmsg, qslmsg_int, "
+                              "                             qsl_sent_via) "
+                              "VALUES (:row_no, :callsign, :band, :mode, :start_time, "
+                              "        :qsl_rcvd, :qsl_rdate, :lotw_qsl_rcvd, :gridsquare, "
+                              "        :credit_granted, :credit_submitted, :pfx, :iota, "
+                              "        :vucc_grids, :state, :cnty, :qsl_sent, :qslmsg, :qslmsg_int, "
+                              "        :qsl_sent_via)") )
+    {
+        qWarning() << "Cannot prepare QSL stage statement" << stageQuery.lastError();
+        return false;
+    }
+
+    /* optional fields are set only if they are present - COALESCE keeps the original value */
+    if ( ! lotwUpdateQuery.prepare("UPDATE contacts "
+                                   "SET lotw_qsl_rcvd = :lotw_qsl_rcvd, "
+                                   "    lotw_qslrdate = :lotw_qslrdate, "
+                                   "    gridsquare = COALESCE(:gridsquare, gridsquare), "
+                                   "    distance = COALESCE(:distance, distance), "
+                                   "    credit_granted = COALESCE(:credit_granted, credit_granted), "
+                                   "    credit_submitted = COALESCE(:credit_submitted, credit_submitted), "
+                                   "    pfx = COALESCE(:pfx, pfx), "
+                                   "    iota = COALESCE(:iota, iota), "
+                                   "    vucc_grids = COALESCE(:vucc_grids, vucc_grids), "
+                                   "    state = COALESCE(:state, state), "
+                                   "    cnty = COALESCE(:cnty, cnty), "
+                                   "    qsl_rcvd_via = 'E' "
+                                   "WHERE id = :id") )
+    {
+        qWarning() << "Cannot prepare LoTW update statement" << lotwUpdateQuery.lastError();
+        return false;
+    }
+
+    if ( ! eqslUpdateQuery.prepare("UPDATE contacts "
+                                   "SET eqsl_qsl_rcvd = :eqsl_qsl_rcvd, "
+                                   "    eqsl_qslrdate = :eqsl_qslrdate, "
+                                   "    gridsquare = COALESCE(:gridsquare, gridsquare), "
+                                   "    distance = COALESCE(:distance, distance), "
+                                   "    qslmsg = :qslmsg, "
+                                   "    qslmsg_int = :qslmsg_int, "
+                                   "    qsl_rcvd_via = :qsl_rcvd_via "
+                                   "WHERE id = :id") )
+    {
+        qWarning() << "Cannot prepare eQSL update statement" << eqslUpdateQuery.lastError();
+        return false;
+    }
+
+    stagedRows = 0;
+    started = db.transaction();
+
+    return started;
+}
+
+bool QSLMerger::stage(const QSqlRecord &QSLRecord)
+{
+    FCT_IDENTIFICATION;
+
+    stageQuery.bindValue(":row_no", stagedRows);
+    stageQuery.bindValue(":callsign", QSLRecord.value("callsign"));
+    stageQuery.bindValue(":band", QSLRecord.value("band"));
+    stageQuery.bindValue(":mode", QSLRecord.value("mode"));
+    stageQuery.bindValue(":start_time", QSLRecord.value("start_time").toDateTime().toTimeSpec(Qt::UTC).toString("yyyy-MM-dd hh:mm:ss"));
+    stageQuery.bindValue(":qsl_rcvd", QSLRecord.value("qsl_rcvd"));
+    stageQuery.bindValue(":qsl_rdate", QSLRecord.value("qsl_rdate"));
+    stageQuery.bindValue(":lotw_qsl_rcvd", QSLRecord.value("lotw_qsl_rcvd"));
+    stageQuery.bindValue(":gridsquare", QSLRecord.value("gridsquare"));
+    stageQuery.bindValue(":credit_granted", QSLRecord.value("credit_granted"));
+    stageQuery.bindValue(":credit_submitted", QSLRecord.value("credit_submitted"));
+    stageQuery.bindValue(":pfx", QSLRecord.value("pfx"));
+    stageQuery.bindValue(":iota", QSLRecord.value("iota"));
+    stageQuery.bindValue(":vucc_grids", QSLRecord.value("vucc_grids"));
+    stageQuery.bindValue(":state", QSLRecord.value("state"));
+    stageQuery.bindValue(":cnty", QSLRecord.value("cnty"));
+    stageQuery.bindValue(":qsl_sent", QSLRecord.value("qsl_sent"));
+    stageQuery.bindValue(":qslmsg", QSLRecord.value("qslmsg"));
+    stageQuery.bindValue(":qslmsg_int", QSLRecord.value("qslmsg_int"));
+    stageQuery.bindValue(":qsl_sent_via", QSLRecord.value("qsl_sent_via"));
+
+    if ( ! stageQuery.exec() )
+    {
+        qWarning() << "Cannot stage QSL record" << stageQuery.lastError();
+        qCDebug(runtime) << QSLRecord;
+        return false;
+    }
+
+    stagedRows++;
+    return true;
+}
+
+bool QSLMerger::merge(QSLMergeStat &stats)
+{
+    FCT_IDENTIFICATION;
+
+    QList<QSLMatch> matches;
+
+    if ( !started )
+    {
+        return false;
+    }
+
+    started = false;
+
+    if ( ! loadMatches(matches) )
+    {
+        db.rollback();
+        return false;
+    }
+
+    /* the same contact can be confirmed more times in one download -
+     * the contact state is tracked in memory to evaluate it the same way
+     * as if the QSLs were merged one by one */
+    QHash<qlonglong, ContactState> contacts;
+    QList<qlonglong> confirmedContacts;
+
+    /* the results are added to stats only if the transaction is committed */
+    QStringList newQSLs;
+    QStringList unmatchedQSLs;
+    int updatedCount = 0;
+    int errorCount = 0;
+
+    for ( const QSLMatch &match : qAsConst(matches) )
+    {
+        if ( match.matchCount != 1 )
+        {
+            unmatchedQSLs.append(match.callsign);
+            continue;
+        }
+
+        if ( !contacts.contains(match.contactID) )
+        {
+            ContactState state;
+            state.lotwQslRcvd = match.contactLotwQslRcvd;
+            state.eqslQslRcvd = match.contactEqslQslRcvd;
+            state.gridsquare = match.contactGridsquare;
+            state.myGridsquare = match.contactMyGridsquare;
+            contacts.insert(match.contactID, state);
+        }
+
+        ContactState &contact = contacts[match.contactID];
+        bool updated = false;
+        bool ret = false;
+
+        switch ( fromService )
+        {
+        case LogFormat::LOTW:
+            ret = applyLotw(match, contact, updated);
+            break;
+
+        case LogFormat::EQSL:
+            ret = applyEqsl(match, contact, updated);
+            break;
+
+        default:
+            qCDebug(runtime) << "Uknown QSL import";
+            ret = true;
+        }
+
+        if ( !ret )
+        {
+            errorCount++;
+            continue;
+        }
+
+        if ( updated )
+        {
+            updatedCount++;
+            newQSLs.append(match.callsign);
+
+            // only LoTW QSL changes DXCC Confirmed status
+            if ( fromService == LogFormat::LOTW )
+            {
+                confirmedContacts.append(match.contactID);
+            }
+        }
+    }
+
+    if ( ! db.commit() )
+    {
+        qWarning() << "Cannot commit changes to Contact Table - " << db.lastError();
+        db.rollback();
+        stats.qsos_errors += matches.size();
+        return false;
+    }
+
+    stats.qsos_updated += updatedCount;
+    stats.qsos_errors += errorCount;
+    stats.qsos_unmatched += unmatchedQSLs.size();
+    stats.newQSLs.append(newQSLs);
+    stats.unmatchedQSLs.append(unmatchedQSLs);
+
+    Data::instance()->confirmDxccStatusContacts(confirmedContacts);
+
+    return true;
+}
+
+bool QSLMerger::loadMatches(QList<QSLMatch> &matches)
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query(db);
+
+    query.setForwardOnly(true);
+
+    // It is important to use callsign index here
+    if ( ! query.exec("SELECT m.match_count, c.id, c.lotw_qsl_rcvd, c.eqsl_qsl_rcvd, c.gridsquare, c.my_gridsquare, "
+                      "       s.callsign, s.qsl_rcvd, s.qsl_rdate, s.lotw_qsl_rcvd, s.gridsquare, "
+                      "       s.credit_granted, s.credit_submitted, s.pfx, s.iota, s.vucc_grids, "
+                      "       s.state, s.cnty, s.qsl_sent, s.qslmsg, s.qslmsg_int, s.qsl_sent_via "
+                      "FROM (SELECT st.row_no, COUNT(con.id) match_count, MIN(con.id) contact_id "
+                      "      FROM qsl_merge_stage st "
+                      "      LEFT JOIN contacts con "
+                      "           ON con.callsign = upper(st.callsign) "
+                      "              AND upper(con.mode) = upper(st.mode) "
+                      "              AND upper(con.band) = upper(st.band) "
+                      "              AND ABS(JULIANDAY(con.start_time) - JULIANDAY(datetime(st.start_time)))*24*60 < 30 "
+                      "      GROUP BY st.row_no) m "
+                      "     INNER JOIN qsl_merge_stage s ON s.row_no = m.row_no "
+                      "     LEFT JOIN contacts c ON c.id = m.contact_id AND m.match_count = 1 "
+                      "ORDER BY m.row_no") )
+    {
+        qWarning() << "Cannot match QSLs" << query.lastError();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        QSLMatch match;
+        match.matchCount = query.value(0).toInt();
+        match.contactID = query.value(1).toLongLong();
+        match.contactLotwQslRcvd = query.value(2).toString();
+        match.contactEqslQslRcvd = query.value(3).toString();
+        match.contactGridsquare = query.value(4).toString();
+        match.contactMyGridsquare = query.value(5).toString();
+        match.callsign = query.value(6).toString();
+        match.qslRcvd = query.value(7);
+        match.qslRdate = query.value(8);
+        match.lotwQslRcvd = query.value(9).toString();
+        match.gridsquare = query.value(10).toString();
+        match.creditGranted = query.value(11);
+        match.creditSubmitted = query.value(12);
+        match.pfx = query.value(13);
+        match.iota = query.value(14);
+        match.vuccGrids = query.value(15);
+        match.state = query.value(16);
+        match.cnty = query.value(17);
+        match.qslSent = query.value(18);
+        match.qslmsg = query.value(19);
+        match.qslmsgInt = query.value(20);
+        match.qslSentVia = query.value(21);
+        matches.append(match);
+    }
+
+    qCDebug(runtime) << "Staged" << stagedRows << "QSLs";
+
+    return true;
+}
+
+bool QSLMerger::applyLotw(const QSLMatch &match, ContactState &contact, bool &updated)
+{
+    FCT_IDENTIFICATION;
+
+    updated = false;
+
+    /* https://lotw.arrl.org/lotw-help/developer-query-qsos-qsls/?lang=en */
+    if ( match.lotwQslRcvd.isEmpty() )
+    {
+        qCInfo(runtime) << "Malformed Lotw Record " << match.callsign;
+        return true;
+    }
+
+    if ( match.qslRcvd.toString() == contact.lotwQslRcvd
+         || match.qslRcvd.toString() != "Y" )
+    {
+        return true;
+    }
+
+    QVariant distance;
+    QVariant gridsquare = mergeGridsquare(match.gridsquare, contact, distance);
+
+    lotwUpdateQuery.bindValue(":lotw_qsl_rcvd", match.qslRcvd);
+    lotwUpdateQuery.bindValue(":lotw_qslrdate", match.qslRdate);
+    lotwUpdateQuery.bindValue(":gridsquare", gridsquare);
+    lotwUpdateQuery.bindValue(":distance", distance);
+    lotwUpdateQuery.bindValue(":credit_granted", nonEmpty(match.creditGranted));
+    lotwUpdateQuery.bindValue(":credit_submitted", nonEmpty(match.creditSubmitted));
+    lotwUpdateQuery.bindValue(":pfx", nonEmpty(match.pfx));
+    lotwUpdateQuery.bindValue(":iota", nonEmpty(match.iota));
+    lotwUpdateQuery.bindValue(":vucc_grids", nonEmpty(match.vuccGrids));
+    lotwUpdateQuery.bindValue(":state", nonEmpty(match.state));
+    lotwUpdateQuery.bindValue(":cnty", nonEmpty(match.cnty));
+    lotwUpdateQuery.bindValue(":id", match.contactID);
+
+    if ( ! lotwUpdateQuery.exec() )
+    {
+        qWarning() << "Cannot update a Contact record - " << lotwUpdateQuery.lastError();
+        return false;
+    }
+
+    contact.lotwQslRcvd = match.qslRcvd.toString();
+    updated = true;
+    return true;
+}
+
+bool QSLMerger::applyEqsl(const QSLMatch &match, ContactState &contact, bool &updated)
+{
+    FCT_IDENTIFICATION;
+
+    updated = false;
+
+    /* http://www.eqsl.cc/qslcard/DownloadInBox.txt */
+    if ( contact.eqslQslRcvd == "Y" )
+    {
+        return true;
+    }
+
+    QVariant distance;
+    QVariant gridsquare = mergeGridsquare(match.gridsquare, contact, distance);
+
+    eqslUpdateQuery.bindValue(":eqsl_qsl_rcvd", match.qslSent);
+    eqslUpdateQuery.bindValue(":eqsl_qslrdate", QDateTime::currentDateTimeUtc().date().toString("yyyy-MM-dd"));
+    eqslUpdateQuery.bindValue(":gridsquare", gridsquare);
+    eqslUpdateQuery.bindValue(":distance", distance);
+    eqslUpdateQuery.bindValue(":qslmsg", match.qslmsg);
+    eqslUpdateQuery.bindValue(":qslmsg_int", match.qslmsgInt);
+    eqslUpdateQuery.bindValue(":qsl_rcvd_via", match.qslSentVia);
+    eqslUpdateQuery.bindValue(":id", match.contactID);
+
+    if ( ! eqslUpdateQuery.exec() )
+    {
+        qWarning() << "Cannot update a Contact record - " << eqslUpdateQuery.lastError();
+        return false;
+    }
+
+    contact.eqslQslRcvd = match.qslSent.toString();
+    updated = true;
+    return true;
+}
+
+QVariant QSLMerger::mergeGridsquare(const QString &qslGrid,
+                                    ContactState &contact,
+                                    QVariant &distance)
+{
+    FCT_IDENTIFICATION;
+
+    Gridsquare dxNewGrid(qslGrid);
+
+    distance = QVariant();
+
+    if ( dxNewGrid.isValid()
+         && ( contact.gridsquare.isEmpty()
+              || dxNewGrid.getGrid().contains(contact.gridsquare) ) )
+    {
+        Gridsquare myGrid(contact.myGridsquare);
+        double dist;
+
+        if ( myGrid.distanceTo(dxNewGrid, dist) )
+        {
+            distance = dist;
+        }
+
+        contact.gridsquare = dxNewGrid.getGrid();
+        return contact.gridsquare;
+    }
+
+    return QVariant();
+}
+
+QVariant QSLMerger::nonEmpty(const QVariant &value)
+{
+    return ( value.toString().isEmpty() ) ? QVariant() : value;
+}
+
+void QSLMerger::dropStage()
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query(db);
+
+    if ( ! query.exec("DROP TABLE IF EXISTS temp.qsl_merge_stage") )
+    {
+        qCDebug(runtime) << "Cannot drop QSL stage table" << query.lastError();
+    }
+}
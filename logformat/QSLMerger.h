@@ -0,0 +1,78 @@
+#ifndef QSLMERGER_H
+#define QSLMERGER_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+#include "LogFormat.h"
+
+/* Set-based merge of downloaded QSLs (LoTW, eQSL) to the contacts table.
+ * 1) incoming QSLs are staged to a temporary table
+ * 2) they are matched to contacts by one join (callsign/band/mode/+-30min)
+ * 3) updates are applied in one transaction */
+class QSLMerger
+{
+public:
+    explicit QSLMerger(LogFormat::QSLFrom fromService,
+                       const QSqlDatabase &db = QSqlDatabase::database());
+    ~QSLMerger();
+
+    bool start();
+    bool stage(const QSqlRecord &QSLRecord);
+    bool merge(QSLMergeStat &stats);
+
+private:
+    struct QSLMatch
+    {
+        int matchCount;
+        qlonglong contactID;
+        QString contactLotwQslRcvd;
+        QString contactEqslQslRcvd;
+        QString contactGridsquare;
+        QString contactMyGridsquare;
+        QString callsign;
+        QVariant qslRcvd;
+        QVariant qslRdate;
+        QString lotwQslRcvd;
+        QString gridsquare;
+        QVariant creditGranted;
+        QVariant creditSubmitted;
+        QVariant pfx;
+        QVariant iota;
+        QVariant vuccGrids;
+        QVariant state;
+        QVariant cnty;
+        QVariant qslSent;
+        QVariant qslmsg;
+        QVariant qslmsgInt;
+        QVariant qslSentVia;
+    };
+
+    struct ContactState
+    {
+        QString lotwQslRcvd;
+        QString eqslQslRcvd;
+        QString gridsquare;
+        QString myGridsquare;
+    };
+
+    bool loadMatches(QList<QSLMatch> &matches);
+    bool applyLotw(const QSLMatch &match, ContactState &contact, bool &updated);
+    bool applyEqsl(const QSLMatch &match, ContactState &contact, bool &updated);
+    QVariant mergeGridsquare(const QString &qslGrid,
+                             ContactState &contact,
+                             QVariant &distance);
+    static QVariant nonEmpty(const QVariant &value);
+    void dropStage();
+
+    LogFormat::QSLFrom fromService;
+    QSqlDatabase db;
+    QSqlQuery stageQuery;
+    QSqlQuery lotwUpdateQuery;
+    QSqlQuery eqslUpdateQuery;
+    int stagedRows;
+    bool started;
+};
+
+#endif // QSLMERGER_H
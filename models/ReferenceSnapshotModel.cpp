@@ -0,0 +1,49 @@
+#include "ReferenceSnapshotModel.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.models.referencesnapshotmodel");
+
+ReferenceSnapshotModel::ReferenceSnapshotModel(ReferenceSnapshot::Source source,
+                                               QObject *parent) :
+    QAbstractListModel(parent),
+    snapshot(source),
+    loadTried(false)
+{
+    FCT_IDENTIFICATION;
+}
+
+int ReferenceSnapshotModel::rowCount(const QModelIndex &parent) const
+{
+    if ( parent.isValid() )
+    {
+        return 0;
+    }
+
+    return loadedSnapshot().count();
+}
+
+QVariant ReferenceSnapshotModel::data(const QModelIndex &index, int role) const
+{
+    if ( !index.isValid()
+         || ( role != Qt::DisplayRole && role != Qt::EditRole ) )
+    {
+        return QVariant();
+    }
+
+    return loadedSnapshot().at(index.row());
+}
+
+const ReferenceSnapshot &ReferenceSnapshotModel::loadedSnapshot() const
+{
+    if ( !loadTried )
+    {
+        loadTried = true;
+
+        if ( !snapshot.load() )
+        {
+            qWarning() << "Cannot load Reference Snapshot";
+        }
+    }
+
+    return snapshot;
+}
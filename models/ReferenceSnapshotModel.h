@@ -0,0 +1,27 @@
+#ifndef REFERENCESNAPSHOTMODEL_H
+#define REFERENCESNAPSHOTMODEL_H
+
+#include <QAbstractListModel>
+#include "data/ReferenceSnapshot.h"
+
+/* List model of reference IDs used by completers.
+ * The snapshot is mapped when the model is used for the first time */
+class ReferenceSnapshotModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit ReferenceSnapshotModel(ReferenceSnapshot::Source source,
+                                    QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    const ReferenceSnapshot &loadedSnapshot() const;
+
+    mutable ReferenceSnapshot snapshot;
+    mutable bool loadTried;
+};
+
+#endif // REFERENCESNAPSHOTMODEL_H
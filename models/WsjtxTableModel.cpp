@@ -4,9 +4,19 @@
 #include "data/StationProfile.h"
 #include "core/Gridsquare.h"
 
-bool operator==(const WsjtxEntry& a, const WsjtxEntry& b)
+WsjtxTableModel::WsjtxTableModel(QObject* parent) :
+    QAbstractTableModel(parent),
+    spotPeriod(120),
+    firstChangedRow(-1),
+    lastChangedRow(-1)
 {
-    return a.callsign == b.callsign;
+    agingTimer.setSingleShot(true);
+    connect(&agingTimer, &QTimer::timeout, this, [this]()
+    {
+        spotAging();
+        scheduleSpotAging();
+    });
+    scheduleSpotAging();
 }
 
 int WsjtxTableModel::rowCount(const QModelIndex&) const
@@ -21,7 +31,7 @@ int WsjtxTableModel::columnCount(const QModelIndex&) const
 
 QVariant WsjtxTableModel::data(const QModelIndex& index, int role) const
 {
-    WsjtxEntry entry = wsjtxData.at(index.row());
+    const WsjtxEntry &entry = wsjtxData.at(index.row());
 
     if (role == Qt::DisplayRole)
     {
@@ -80,53 +90,107 @@ QVariant WsjtxTableModel::headerData(int section, Qt::Orientation orientation, i
 
 void WsjtxTableModel::addOrReplaceEntry(WsjtxEntry entry)
 {
-    int idx = wsjtxData.indexOf(entry);
+    /* the change is visible after commitUpdates() - all decodes
+     * of one decode cycle are committed together */
+    const int idx = callsignIndex.value(entry.callsign, -1);
 
     if ( idx >= 0 )
     {
+        WsjtxEntry &current = ( idx < wsjtxData.count() ) ? wsjtxData[idx]
+                                                          : pendingEntries[idx - wsjtxData.count()];
+
         if ( ! entry.grid.isEmpty() )
         {
-            wsjtxData[idx].grid = entry.grid;
+            current.grid = entry.grid;
         }
 
-        wsjtxData[idx].status = entry.status;
-        wsjtxData[idx].decode = entry.decode;
-        wsjtxData[idx].receivedTime = entry.receivedTime;
+        current.status = entry.status;
+        current.decode = entry.decode;
+        current.receivedTime = entry.receivedTime;
         // does not update club info
 
-        emit dataChanged(createIndex(idx,0), createIndex(idx,4));
+        if ( idx < wsjtxData.count() )
+        {
+            firstChangedRow = ( firstChangedRow < 0 ) ? idx : qMin(firstChangedRow, idx);
+            lastChangedRow = qMax(lastChangedRow, idx);
+        }
     }
     else
     {
-        beginInsertRows(QModelIndex(), wsjtxData.count(), wsjtxData.count());
-        wsjtxData.append(entry);
+        callsignIndex.insert(entry.callsign, wsjtxData.count() + pendingEntries.count());
+        pendingEntries.append(entry);
+    }
+}
+
+void WsjtxTableModel::commitUpdates()
+{
+    if ( firstChangedRow >= 0 )
+    {
+        emit dataChanged(createIndex(firstChangedRow, 0), createIndex(lastChangedRow, 4));
+        firstChangedRow = lastChangedRow = -1;
+    }
+
+    if ( !pendingEntries.isEmpty() )
+    {
+        beginInsertRows(QModelIndex(), wsjtxData.count(), wsjtxData.count() + pendingEntries.count() - 1);
+        wsjtxData.append(pendingEntries);
+        pendingEntries.clear();
         endInsertRows();
     }
 }
 
 void WsjtxTableModel::spotAging()
 {
-    beginResetModel();
+    commitUpdates();
 
-    QMutableListIterator<WsjtxEntry> entry(wsjtxData);
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    bool removed = false;
 
-    while ( entry.hasNext() )
-    {
-        WsjtxEntry current = entry.next();
+    /* only expired rows are removed; continuous blocks of expired rows are
+     * removed at once. The list is processed from the end to keep row numbers valid */
+    int row = wsjtxData.count() - 1;
 
-        if ( current.receivedTime.secsTo(QDateTime::currentDateTimeUtc()) > (3.0 * spotPeriod)*1.2 )
+    while ( row >= 0 )
+    {
+        if ( wsjtxData.at(row).receivedTime.secsTo(now) <= (3.0 * spotPeriod)*1.2 )
             /* +20% time of period because WSTX sends messages in waves and not exactly in time period */
         {
-            entry.remove();
+            row--;
+            continue;
+        }
+
+        const int lastRow = row;
+
+        while ( row > 0
+                && wsjtxData.at(row - 1).receivedTime.secsTo(now) > (3.0 * spotPeriod)*1.2 )
+        {
+            row--;
         }
+
+        beginRemoveRows(QModelIndex(), row, lastRow);
+        wsjtxData.erase(wsjtxData.begin() + row, wsjtxData.begin() + lastRow + 1);
+        endRemoveRows();
+
+        removed = true;
+        row--;
     }
 
-    endResetModel();
+    if ( removed )
+    {
+        rebuildCallsignIndex();
+    }
+
+    // the background of old spots depends on time
+    if ( !wsjtxData.isEmpty() )
+    {
+        emit dataChanged(createIndex(0, 0), createIndex(wsjtxData.count() - 1, columnCount() - 1),
+                         QVector<int>() << Qt::BackgroundRole);
+    }
 }
 
 bool WsjtxTableModel::callsignExists(const WsjtxEntry &call)
 {
-    return wsjtxData.contains(call);
+    return callsignIndex.contains(call.callsign);
 }
 
 QString WsjtxTableModel::getCallsign(QModelIndex idx)
@@ -147,12 +211,36 @@ WsjtxDecode WsjtxTableModel::getDecode(QModelIndex idx)
 void WsjtxTableModel::setCurrentSpotPeriod(float period)
 {
     spotPeriod = period;
+    scheduleSpotAging();
 }
 
 void WsjtxTableModel::clear()
 {
     beginResetModel();
     wsjtxData.clear();
+    pendingEntries.clear();
+    callsignIndex.clear();
+    firstChangedRow = lastChangedRow = -1;
     endResetModel();
 }
 
+void WsjtxTableModel::scheduleSpotAging()
+{
+    /* WSJTX periods are aligned to UTC time. Aging runs at the beginning of each period */
+    const qint64 periodMs = qMax(static_cast<qint64>(spotPeriod * 1000), static_cast<qint64>(1000));
+    const qint64 sinceStartOfDay = QDateTime::currentDateTimeUtc().time().msecsSinceStartOfDay();
+
+    agingTimer.start(static_cast<int>(periodMs - sinceStartOfDay % periodMs));
+}
+
+void WsjtxTableModel::rebuildCallsignIndex()
+{
+    // it is called only when no entry is pending
+    callsignIndex.clear();
+
+    for ( int i = 0; i < wsjtxData.count(); i++ )
+    {
+        callsignIndex.insert(wsjtxData.at(i).callsign, i);
+    }
+}
+
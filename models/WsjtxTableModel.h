@@ -2,18 +2,20 @@
 #define WSJTXTABLEMODEL_H
 
 #include <QAbstractTableModel>
+#include <QTimer>
 #include "data/WsjtxEntry.h"
 
 class WsjtxTableModel : public QAbstractTableModel {
     Q_OBJECT
 
 public:
-    WsjtxTableModel(QObject* parent = nullptr) : QAbstractTableModel(parent) {spotPeriod = 120;}
+    WsjtxTableModel(QObject* parent = nullptr);
     int rowCount(const QModelIndex& parent = QModelIndex()) const;
     int columnCount(const QModelIndex& parent = QModelIndex()) const;
     QVariant data(const QModelIndex& index, int role) const;
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
     void addOrReplaceEntry(WsjtxEntry entry);
+    void commitUpdates();
     void spotAging();
     bool callsignExists(const WsjtxEntry &);
     QString getCallsign(QModelIndex idx);
@@ -23,8 +25,19 @@ public:
     void clear();
 
 private:
+    void scheduleSpotAging();
+    void rebuildCallsignIndex();
+
     QList<WsjtxEntry> wsjtxData;
     float spotPeriod;
+
+    /* callsign -> row. Rows after the last wsjtxData row point
+     * to pendingEntries, which are not inserted to the model yet */
+    QHash<QString, int> callsignIndex;
+    QList<WsjtxEntry> pendingEntries;
+    int firstChangedRow;
+    int lastChangedRow;
+    QTimer agingTimer;
 };
 
 #endif // WSJTXTABLEMODEL_H
@@ -0,0 +1,9 @@
+CREATE TABLE IF NOT EXISTS callbook_cache (
+        callsign TEXT PRIMARY KEY,
+        data TEXT NOT NULL,
+        fetched_at INTEGER NOT NULL,
+        last_used INTEGER NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS callbook_cache_fetched_idx ON callbook_cache(fetched_at);
+CREATE INDEX IF NOT EXISTS callbook_cache_last_used_idx ON callbook_cache(last_used);
@@ -0,0 +1,12 @@
+CREATE TABLE IF NOT EXISTS upload_outbox (
+        id INTEGER PRIMARY KEY AUTOINCREMENT,
+        service TEXT NOT NULL,
+        contactid INTEGER NOT NULL REFERENCES contacts(id) ON DELETE CASCADE,
+        attempts INTEGER NOT NULL DEFAULT 0,
+        next_attempt INTEGER NOT NULL DEFAULT 0,
+        last_error TEXT,
+        UNIQUE (service, contactid)
+);
+
+CREATE INDEX IF NOT EXISTS upload_outbox_service_idx ON upload_outbox(service, next_attempt);
+CREATE INDEX IF NOT EXISTS upload_outbox_contact_idx ON upload_outbox(contactid);
@@ -0,0 +1,22 @@
+DROP TABLE IF EXISTS contacts_callsign_trigrams;
+DROP TABLE IF EXISTS contacts_callsign_positions;
+
+CREATE TABLE IF NOT EXISTS contacts_callsign_positions (
+        n INTEGER PRIMARY KEY
+);
+
+WITH RECURSIVE pos(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM pos WHERE n < 32)
+INSERT INTO contacts_callsign_positions(n) SELECT n FROM pos;
+
+CREATE TABLE IF NOT EXISTS contacts_callsign_trigrams (
+        trigram TEXT NOT NULL,
+        contactid INTEGER NOT NULL,
+        PRIMARY KEY (trigram, contactid)
+) WITHOUT ROWID;
+
+INSERT INTO contacts_callsign_trigrams (trigram, contactid)
+SELECT DISTINCT substr(upper(c.callsign), p.n, 3), c.id
+FROM contacts c, contacts_callsign_positions p
+WHERE p.n <= length(c.callsign) - 2;
+
+CREATE INDEX IF NOT EXISTS contacts_callsign_trigrams_contact_idx ON contacts_callsign_trigrams(contactid);
@@ -7,6 +7,9 @@
 #include <QGraphicsSceneMouseEvent>
 #include <algorithm>
 #include <QWheelEvent>
+#include <QPainter>
+#include <QElapsedTimer>
+#include <QtMath>
 
 #include "BandmapWidget.h"
 #include "ui_BandmapWidget.h"
@@ -26,6 +29,9 @@ MODULE_IDENTIFICATION("qlog.ui.bandmapwidget");
 //Pixel between each step in BandMap
 #define PIXELSPERSTEP 10
 
+//Height of one rendered part of the frequency scale
+#define SCALE_TILE_HEIGHT 2048
+
 BandmapWidget::BandmapWidget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::BandmapWidget),
@@ -84,19 +90,19 @@ void BandmapWidget::update()
      ****************/
     update_timer->setInterval(BANDMAP_MAX_REFRESH_TIME);
 
-    /*************
-     * Clear All *
-     *************/
-    clearAllCallsignFromScene();
-
+    /***************
+     * Clear Scale *
+     ***************/
+    /* Spot items are kept, they are moved by updateStations */
     clearFreqMark(&rxMark);
     clearFreqMark(&txMark);
 
-    bandmapScene->clear();
+    clearScale();
 
     // do not show bandmap for submm bands
     if ( rx_freq > 250000.0 || currentBand.start >= 300000.0 )
     {
+        clearAllCallsignFromScene();
         return;
     }
 
@@ -115,21 +121,7 @@ void BandmapWidget::update()
     /****************/
     /* Draw bandmap */
     /****************/
-    for ( int i = 0; i <= steps; i++ )
-    {
-        bandmapScene->addLine(0,
-                              i * PIXELSPERSTEP,
-                              (i % 5 == 0) ? 15 : 10,
-                              i * PIXELSPERSTEP,
-                              QPen(QColor(192,192,192)));
-
-        if (i % 5 == 0)
-        {
-            QGraphicsTextItem* text = bandmapScene->addText(QString::number(currentBand.start + step*i, 'f', digits));
-            text->setPos(- (text->boundingRect().width()) - 10,
-                         i * PIXELSPERSTEP - (text->boundingRect().height() / 2));
-        }
-    }
+    drawScale(step, digits, steps);
 
     QString endFreqDigits= QString::number(currentBand.end + step*steps, 'f', digits);
     bandmapScene->setSceneRect(160 - (endFreqDigits.size() * PIXELSPERSTEP),
@@ -184,54 +176,106 @@ void BandmapWidget::updateStations()
      ****************/
     update_timer->setInterval(BANDMAP_MAX_REFRESH_TIME);
 
-    clearAllCallsignFromScene();
-
     spotAging();
 
     // do not show bandmap for submm bands
     if ( rx_freq > 250000.0 || currentBand.start >= 300000.0 )
     {
+        clearAllCallsignFromScene();
         return;
     }
 
     determineStepDigits(step, digits);
 
+    int added = 0;
+    int removed = 0;
+
+    /********************************
+     * Remove items of hidden spots *
+     ********************************/
+    QMutableMapIterator<double, SpotItem> itemIterator(spotItems);
+
+    while ( itemIterator.hasNext() )
+    {
+        itemIterator.next();
+
+        const double freq = itemIterator.key();
+
+        if ( freq < currentBand.start
+             || freq > currentBand.end
+             || !spots.contains(freq) )
+        {
+            removeSpotItem(itemIterator.value());
+            itemIterator.remove();
+            removed++;
+        }
+    }
+
+    const QColor defaultTextColor = qApp->palette().color(QPalette::Text);
+    const QString timeFormat = locale.formatTimeShort();
+
     QMap<double, DxSpot>::iterator lower = spots.lowerBound(currentBand.start);
     QMap<double, DxSpot>::iterator upper = spots.upperBound(currentBand.end);
 
     for (; lower != upper; lower++)
     {
+        const DxSpot &spot = lower.value();
         double freq_y = ((lower.key() - currentBand.start) / step) * PIXELSPERSTEP;
         double text_y = std::max(min_y + 5, freq_y);
 
-        /*************************
-         * Draw Line to Callsign *
-         *************************/
-        lineItemList.append(bandmapScene->addLine(17,
-                                                  freq_y,
-                                                  40,
-                                                  text_y,
-                                                  QPen(QColor(192,192,192))));
+        SpotItem &item = spotItems[lower.key()];
+
+        if ( !item.text )
+        {
+            item.line = bandmapScene->addLine(QLineF(), QPen(QColor(192,192,192)));
+
+            item.text = bandmapScene->addText(QString());
+            item.text->document()->setDocumentMargin(0);
+            item.text->setFlags(QGraphicsItem::ItemIsFocusable |
+                                QGraphicsItem::ItemIsSelectable |
+                                item.text->flags());
+            item.text->setProperty("freq", lower.key());
+            added++;
+        }
 
-        QString callsignTmp = lower.value().callsign;
-        QString timeTmp = lower.value().time.toString(locale.formatTimeShort());
+        /* the text item is re-laid out only if its content is changed */
+        const QString label = spot.callsign + " @ " + spot.time.toString(timeFormat);
 
-        QGraphicsTextItem* text = bandmapScene->addText(callsignTmp + " @ " + timeTmp);
-        text->document()->setDocumentMargin(0);
-        text->setPos(40, text_y - (text->boundingRect().height() / 2));
-        text->setFlags(QGraphicsItem::ItemIsFocusable |
-                       QGraphicsItem::ItemIsSelectable |
-                       text->flags());
-        text->setProperty("freq", lower.key());
-        text->setToolTip(lower.value().comment);
+        if ( item.label != label )
+        {
+            item.text->setPlainText(label);
+            item.label = label;
+        }
+
+        if ( item.comment != spot.comment )
+        {
+            item.text->setToolTip(spot.comment);
+            item.comment = spot.comment;
+        }
 
-        min_y = text_y + text->boundingRect().height() / 2;
+        const QColor textColor = Data::statusToColor(spot.status, defaultTextColor);
 
-        QColor textColor = Data::statusToColor(lower.value().status, qApp->palette().color(QPalette::Text));
-        text->setDefaultTextColor(textColor);
-        textItemList.append(text);
+        if ( item.color != textColor )
+        {
+            item.text->setDefaultTextColor(textColor);
+            item.color = textColor;
+        }
+
+        /*************************
+         * Move Line to Callsign *
+         *************************/
+        const qreal textHeight = item.text->boundingRect().height();
+
+        item.line->setLine(17, freq_y, 40, text_y);
+        item.text->setPos(40, text_y - (textHeight / 2));
+
+        min_y = text_y + textHeight / 2;
     }
 
+    qCDebug(runtime) << "Spot items" << spotItems.size()
+                     << "added" << added
+                     << "removed" << removed;
+
     pendingSpots = 0;
     lastStationUpdate = QDateTime::currentMSecsSinceEpoch();
 }
@@ -274,27 +318,152 @@ void BandmapWidget::clearAllCallsignFromScene()
 {
     FCT_IDENTIFICATION;
 
-    QMutableListIterator<QGraphicsLineItem*> lineIterator(lineItemList);
+    for ( SpotItem &item : spotItems )
+    {
+        removeSpotItem(item);
+    }
 
-    while ( lineIterator.hasNext() )
+    spotItems.clear();
+}
+
+void BandmapWidget::removeSpotItem(SpotItem &item)
+{
+    FCT_IDENTIFICATION;
+
+    if ( item.line )
     {
-        lineIterator.next();
-        bandmapScene->removeItem(lineIterator.value());
-        delete lineIterator.value();
+        bandmapScene->removeItem(item.line);
+        delete item.line;
+        item.line = nullptr;
     }
 
-    lineItemList.clear();
+    if ( item.text )
+    {
+        bandmapScene->removeItem(item.text);
+        delete item.text;
+        item.text = nullptr;
+    }
+}
+
+void BandmapWidget::drawScale(double step, int digits, int steps)
+{
+    FCT_IDENTIFICATION;
 
-    QMutableListIterator<QGraphicsTextItem*> textIterator(textItemList);
+    qCDebug(function_parameters) << step << digits << steps;
 
-    while ( textIterator.hasNext() )
+    const qreal pixelRatio = ui->graphicsView->devicePixelRatioF();
+    const QString cacheKey = QString("%1|%2|%3|%4|%5").arg(currentBand.start)
+                                                        .arg(currentBand.end)
+                                                        .arg(zoom)
+                                                        .arg(qApp->palette().color(QPalette::Text).name())
+                                                        .arg(pixelRatio);
+
+    QHash<QString, QList<ScaleTile>>::const_iterator it = scaleCache.constFind(cacheKey);
+
+    if ( it == scaleCache.constEnd() )
     {
-        textIterator.next();
-        bandmapScene->removeItem(textIterator.value());
-        delete textIterator.value();
+        QElapsedTimer timer;
+        timer.start();
+
+        it = scaleCache.insert(cacheKey, renderScale(step, digits, steps));
+
+        qCDebug(runtime) << "Scale rendered" << cacheKey << timer.elapsed() << "ms";
     }
 
-    textItemList.clear();
+    for ( const ScaleTile &tile : it.value() )
+    {
+        QGraphicsPixmapItem *item = bandmapScene->addPixmap(tile.pixmap);
+        item->setOffset(tile.offset);
+        scaleItems.append(item);
+    }
+}
+
+void BandmapWidget::clearScale()
+{
+    FCT_IDENTIFICATION;
+
+    for ( QGraphicsPixmapItem *item : qAsConst(scaleItems) )
+    {
+        bandmapScene->removeItem(item);
+        delete item;
+    }
+
+    scaleItems.clear();
+}
+
+QList<BandmapWidget::ScaleTile> BandmapWidget::renderScale(double step, int digits, int steps) const
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << step << digits << steps;
+
+    const QFont font = bandmapScene->font();
+    const QFontMetrics metrics(font);
+    const QColor textColor = qApp->palette().color(QPalette::Text);
+    const QPen linePen(QColor(192,192,192));
+    const qreal pixelRatio = ui->graphicsView->devicePixelRatioF();
+    const int labelHeight = metrics.height();
+    /* labels end at the same position as the former text items with their document margins */
+    const int labelRight = -14;
+
+    QStringList labels;
+    int labelWidth = 0;
+
+    for ( int i = 0; i <= steps; i += 5 )
+    {
+        const QString label = QString::number(currentBand.start + step*i, 'f', digits);
+        labelWidth = qMax(labelWidth, metrics.boundingRect(label).width());
+        labels << label;
+    }
+
+    const int left = labelRight - labelWidth - 2;
+    const int width = 16 - left;
+    const int top = -labelHeight / 2 - 1;
+    const int bottom = steps * PIXELSPERSTEP + labelHeight / 2 + 1;
+
+    QList<ScaleTile> ret;
+
+    /* the scale is split to tiles because the pixmap size is limited */
+    for ( int tileTop = top; tileTop < bottom; tileTop += SCALE_TILE_HEIGHT )
+    {
+        const int tileHeight = qMin(SCALE_TILE_HEIGHT, bottom - tileTop);
+
+        QPixmap pixmap(qCeil(width * pixelRatio), qCeil(tileHeight * pixelRatio));
+        pixmap.setDevicePixelRatio(pixelRatio);
+        pixmap.fill(Qt::transparent);
+
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        painter.setFont(font);
+        painter.translate(-left, -tileTop);
+
+        /* draw only steps which can intersect the tile */
+        const int firstStep = qMax(0, (tileTop - labelHeight) / PIXELSPERSTEP);
+        const int lastStep = qMin(steps, (tileTop + tileHeight + labelHeight) / PIXELSPERSTEP + 1);
+
+        for ( int i = firstStep; i <= lastStep; i++ )
+        {
+            const int y = i * PIXELSPERSTEP;
+
+            painter.setPen(linePen);
+            painter.drawLine(0, y, (i % 5 == 0) ? 15 : 10, y);
+
+            if ( i % 5 == 0 )
+            {
+                painter.setPen(textColor);
+                painter.drawText(QRect(labelRight - labelWidth, y - labelHeight / 2,
+                                       labelWidth, labelHeight),
+                                 Qt::AlignRight | Qt::AlignVCenter,
+                                 labels.at(i / 5));
+            }
+        }
+
+        painter.end();
+
+        ret << ScaleTile{pixmap, QPointF(left, tileTop)};
+    }
+
+    return ret;
 }
 
 void BandmapWidget::clearFreqMark(QGraphicsPolygonItem **currentPolygon)
@@ -504,6 +673,13 @@ void BandmapWidget::setBand(const Band &newBand, bool savePrevBandZoom)
     {
         saveCurrentZoom();
     }
+
+    /* the rendered scales are cached only for the current band */
+    if ( newBand.name != currentBand.name )
+    {
+        scaleCache.clear();
+    }
+
     currentBand = newBand;
     zoom = savedZoom(newBand);
 }
@@ -607,20 +783,40 @@ void BandmapWidget::spotsDxccStatusRecal(const QSqlRecord &record)
     QString band = record.value("band").toString();
     QString mode = Data::instance()->modeToDXCCMode(record.value("mode").toString());
 
+    bool statusChanged = false;
+
     QMutableMapIterator<double, DxSpot> spotIterator(spots);
 
     while ( spotIterator.hasNext() )
     {
         spotIterator.next();
-        spotIterator.value().status = Data::dxccFutureStatus(spotIterator.value().status,
-                                                             spotIterator.value().dxcc.dxcc,
-                                                             spotIterator.value().band,
-                                                             Data::freqToDXCCMode(spotIterator.value().freq),
-                                                             dxcc,
-                                                             band,
-                                                             mode);
+
+        DxSpot &spot = spotIterator.value();
+
+        /* the QSO can change only the status of spots with the same DXCC Entity */
+        if ( spot.dxcc.dxcc != dxcc )
+        {
+            continue;
+        }
+
+        const DxccStatus newStatus = Data::dxccFutureStatus(spot.status,
+                                                            spot.dxcc.dxcc,
+                                                            spot.band,
+                                                            Data::freqToDXCCMode(spot.freq),
+                                                            dxcc,
+                                                            band,
+                                                            mode);
+        if ( newStatus != spot.status )
+        {
+            spot.status = newStatus;
+            statusChanged = true;
+        }
+    }
+
+    if ( statusChanged )
+    {
+        updateStations();
     }
-    updateStations();
 }
 
 void BandmapWidget::focusZoomFreq(int, int)
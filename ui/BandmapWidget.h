@@ -9,6 +9,7 @@
 #include <QMutex>
 #include <QColor>
 #include <QSqlRecord>
+#include <QPixmap>
 
 #include "data/DxSpot.h"
 #include "data/Band.h"
@@ -69,11 +70,33 @@ signals:
     void nearestSpotFound(const DxSpot &);
 
 private:
+    /* Scene items of one spot. Items are kept between the refreshes
+     * and they are only moved/updated when the spot is changed */
+    struct SpotItem
+    {
+        QGraphicsLineItem *line = nullptr;
+        QGraphicsTextItem *text = nullptr;
+        QString label;
+        QString comment;
+        QColor color;
+    };
+
+    /* Part of the rendered frequency scale */
+    struct ScaleTile
+    {
+        QPixmap pixmap;
+        QPointF offset;
+    };
+
     void removeDuplicates(DxSpot &spot);
     void spotAging();
     void updateStations();
     void determineStepDigits(double &steps, int &digits) const;
     void clearAllCallsignFromScene();
+    void removeSpotItem(SpotItem &item);
+    void drawScale(double step, int digits, int steps);
+    void clearScale();
+    QList<ScaleTile> renderScale(double step, int digits, int steps) const;
     void clearFreqMark(QGraphicsPolygonItem **);
     void drawFreqMark(const double, const double, const QColor&, QGraphicsPolygonItem **);
     void drawTXRXMarks(double);
@@ -106,8 +129,9 @@ private:
     GraphicsScene* bandmapScene;
     QMap<double, DxSpot> spots;
     QTimer *update_timer;
-    QList<QGraphicsLineItem *> lineItemList;
-    QList<QGraphicsTextItem *> textItemList;
+    QMap<double, SpotItem> spotItems;
+    QList<QGraphicsPixmapItem *> scaleItems;
+    QHash<QString, QList<ScaleTile>> scaleCache;
     QGraphicsPolygonItem* rxMark;
     QGraphicsPolygonItem* txMark;
     bool keepRXCenter;
@@ -7,7 +7,7 @@
 #include "ClublogDialog.h"
 #include "ui_ClublogDialog.h"
 #include "core/debug.h"
-#include "core/ClubLog.h"
+#include "core/UploadOutbox.h"
 #include "models/SqlListModel.h"
 #include "logformat/AdiFormat.h"
 #include "ui/ShowUploadDialog.h"
@@ -41,11 +41,6 @@ void ClublogDialog::upload()
 {
     FCT_IDENTIFICATION;
 
-    QByteArray data;
-    QTextStream stream(&data, QIODevice::ReadWrite);
-
-    AdiFormat adi(stream);
-
     QString QSOList;
     int count = 0;
 
@@ -57,16 +52,8 @@ void ClublogDialog::upload()
     }
 
     /* https://clublog.freshdesk.com/support/solutions/articles/54905-how-to-upload-logs-directly-into-club-log */
-    /* https://clublog.freshdesk.com/support/solutions/articles/53202-which-adif-fields-does-club-log-use- */
-    QString query_string = "SELECT start_time, "
-                           "       qsl_rdate, qsl_sdate, "
-                           "       callsign, operator, "
-                           "       mode, band, band_rx, freq, "
-                           "       qsl_rcvd, lotw_qsl_rcvd, "
-                           "       qsl_sent, dxcc, "
-                           "       prop_mode, credit_granted, "
-                           "       rst_sent, rst_rcvd, notes, "
-                           "       gridsquare, vucc_grids, sat_name ";
+    /* the uploaded fields are selected by the Upload Outbox */
+    QString query_string = "SELECT id, start_time, callsign, mode ";
     QString query_from   = "FROM contacts ";
     QString query_where =  QString("WHERE (upper(clublog_qso_upload_status) in (%1) OR clublog_qso_upload_status is NULL) ").arg(qslUploadStatuses.join(","));
     QString query_order = " ORDER BY start_time ";
@@ -88,8 +75,7 @@ void ClublogDialog::upload()
     qCDebug(runtime) << query_string;
 
     QSqlQuery query(query_string);
-
-    adi.exportStart();
+    QList<int> contactIDs;
 
     while (query.next())
     {
@@ -101,11 +87,10 @@ void ClublogDialog::upload()
                        + "\t" + record.value("mode").toString()
                        + "\n");
 
-        adi.exportContact(record);
-        count++;
+        contactIDs.append(record.value("id").toInt());
     }
 
-    stream.flush();
+    count = contactIDs.count();
 
     if (count > 0)
     {
@@ -113,46 +98,62 @@ void ClublogDialog::upload()
 
         if ( showDialog.exec() == QDialog::Accepted )
         {
-            QProgressDialog* dialog = new QProgressDialog(tr("Uploading to Clublog"), tr("Cancel"), 0, 0, this);
+            QProgressDialog* dialog = new QProgressDialog(tr("Uploading to Clublog"), tr("Cancel"), 0, count, this);
             dialog->setWindowModality(Qt::WindowModal);
-            dialog->setRange(0, 0);
+            dialog->setValue(0);
             dialog->setAttribute(Qt::WA_DeleteOnClose, true);
             dialog->show();
 
-            ClubLog *clublog = new ClubLog(dialog);
+            /* QSOs are uploaded by the Upload Outbox, the dialog only shows their progress */
+            UploadOutboxWatcher *watcher = new UploadOutboxWatcher(UploadOutbox::CLUBLOG, contactIDs, dialog);
 
-            connect(clublog, &ClubLog::uploadOK, this, [this, dialog, query_where, count, clublog](const QString &msg)
+            connect(watcher, &UploadOutboxWatcher::progress, dialog, &QProgressDialog::setValue);
+
+            connect(watcher, &UploadOutboxWatcher::finished, dialog, [this, dialog](int uploaded)
             {
+                dialog->disconnect(this);
                 dialog->done(QDialog::Accepted);
-                qCDebug(runtime) << "Clublog Upload OK: " << msg;
-                QMessageBox::information(this, tr("QLog Information"), tr("%n QSO(s) uploaded.", "", count));
-                QString query_string = "UPDATE contacts "
-                                       "SET clublog_qso_upload_status='Y', clublog_qso_upload_date = strftime('%Y-%m-%d',DATETIME('now', 'utc')) "
-                        + query_where;
-
-                qCDebug(runtime) << query_string;
-
-                QSqlQuery query_update(query_string);
-                query_update.exec();
-                clublog->deleteLater();
+                qCDebug(runtime) << "Clublog Upload OK";
+
+                const QString failed = UploadOutbox::failedSummary(UploadOutbox::CLUBLOG);
+
+                if ( failed.isEmpty() )
+                {
+                    QMessageBox::information(this, tr("QLog Information"),
+                                             tr("%n QSO(s) uploaded.", "", uploaded));
+                }
+                else
+                {
+                    QMessageBox::warning(this, tr("QLog Warning"),
+                                         tr("%n QSO(s) uploaded.", "", uploaded) + "\n" + failed);
+                }
             });
 
-            connect(clublog, &ClubLog::uploadError, this, [this, dialog, clublog](const QString &msg)
+            connect(watcher, &UploadOutboxWatcher::failed, dialog, [this, dialog](const QString &msg, int notUploaded)
             {
+                dialog->disconnect(this);
                 dialog->done(QDialog::Accepted);
                 qCInfo(runtime) << "Clublog Upload Error: " << msg;
-                QMessageBox::warning(this, tr("QLog Warning"), tr("Cannot upload the QSO(s): ") + msg);
-                clublog->deleteLater();
+
+                QString text = tr("Cannot upload the QSO(s): ") + msg + "\n"
+                               + tr("%n QSO(s) stay in the upload queue and will be retried later.", "", notUploaded);
+                const QString failed = UploadOutbox::failedSummary(UploadOutbox::CLUBLOG);
+
+                if ( !failed.isEmpty() )
+                {
+                    text.append("\n" + failed);
+                }
+
+                QMessageBox::warning(this, tr("QLog Warning"), text);
             });
 
-            connect(dialog, &QProgressDialog::canceled, this, [clublog]()
+            connect(dialog, &QProgressDialog::canceled, this, [watcher]()
             {
                 qCDebug(runtime)<< "Operation canceled";
-                clublog->abortRequest();
-                clublog->deleteLater();
+                watcher->cancel();
             });
 
-            clublog->uploadAdif(data);
+            watcher->start();
         }
     }
     else
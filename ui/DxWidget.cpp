@@ -30,6 +30,7 @@
 #define CONSOLE_VIEW 4
 #define NUM_OF_RECONNECT_ATTEMPTS 3
 #define RECONNECT_TIMEOUT 10000
+#define SPOT_EXPIRE_CHECK_INTERVAL 60000
 
 MODULE_IDENTIFICATION("qlog.ui.dxwidget");
 
@@ -44,7 +45,7 @@ int DxTableModel::columnCount(const QModelIndex&) const {
 QVariant DxTableModel::data(const QModelIndex& index, int role) const
 {
     if (role == Qt::DisplayRole) {
-        DxSpot spot = dxData.at(index.row());
+        const DxSpot &spot = dxData.at(index.row());
         switch (index.column()) {
         case 0:
             return spot.time.toString(locale.formatTimeLongWithoutTZ());
@@ -71,15 +72,15 @@ QVariant DxTableModel::data(const QModelIndex& index, int role) const
         }
     }
     else if (index.column() == 1 && role == Qt::BackgroundRole) {
-        DxSpot spot = dxData.at(index.row());
+        const DxSpot &spot = dxData.at(index.row());
         return Data::statusToColor(spot.status, QColor(Qt::transparent));
     }
     else if (index.column() == 1 && role == Qt::ToolTipRole) {
-        DxSpot spot = dxData.at(index.row());
+        const DxSpot &spot = dxData.at(index.row());
         return spot.dxcc.country + " [" + Data::statusToText(spot.status) + "]";
     }
     /*else if (index.column() == 1 && role == Qt::ForegroundRole) {
-        DxSpot spot = dxData.at(index.row());
+        const DxSpot &spot = dxData.at(index.row());
         return Data::statusToInverseColor(spot.status, QColor(Qt::black));
     }*/
 
@@ -108,33 +109,92 @@ QVariant DxTableModel::headerData(int section, Qt::Orientation orientation, int
 bool DxTableModel::addEntry(DxSpot entry, bool deduplicate,
                             qint16 dedup_interval, double dedup_freq_tolerance)
 {
-    bool shouldInsert = true;
+    return !addEntries(QList<DxSpot>() << entry, deduplicate,
+                       dedup_interval, dedup_freq_tolerance).isEmpty();
+}
+
+QList<DxSpot> DxTableModel::addEntries(const QList<DxSpot> &entries, bool deduplicate,
+                                       qint16 dedup_interval, double dedup_freq_tolerance)
+{
+    QList<DxSpot> newEntries;
 
-    if ( deduplicate )
+    for ( const DxSpot &entry : entries )
     {
-        for (const DxSpot &record : qAsConst(dxData))
+        if ( deduplicate
+             && isDuplicate(entry, newEntries, dedup_interval, dedup_freq_tolerance) )
         {
-            if ( record.time.secsTo(entry.time) > dedup_interval )
-                break;
-
-            if ( record.callsign == entry.callsign
-                 && qAbs(record.freq - entry.freq) < dedup_freq_tolerance )
-            {
-                qCDebug(runtime) << "Duplicate spot" << record.callsign << record.freq <<  entry.callsign << entry.freq;
-                shouldInsert = false;
-                break;
-            }
+            continue;
         }
+
+        newEntries.append(entry);
     }
 
-    if ( shouldInsert )
+    if ( newEntries.isEmpty() )
+    {
+        return newEntries;
+    }
+
+    // only the newest spots can be stored
+    if ( newEntries.size() > dxData.capacity() )
+    {
+        newEntries = newEntries.mid(newEntries.size() - dxData.capacity());
+    }
+
+    removeExpiredEntries();
+
+    // the store is full - the oldest rows are removed in one range
+    removeOldestEntries(dxData.count() + newEntries.size() - dxData.capacity());
+
+    /* one row-insert batch; the newest spot is on the top */
+    beginInsertRows(QModelIndex(), 0, newEntries.size() - 1);
+    for ( const DxSpot &entry : qAsConst(newEntries) )
     {
-        beginInsertRows(QModelIndex(), 0, 0);
         dxData.prepend(entry);
-        endInsertRows();
+    }
+    endInsertRows();
+
+    return newEntries;
+}
+
+bool DxTableModel::isDuplicate(const DxSpot &entry,
+                               const QList<DxSpot> &newEntries,
+                               qint16 dedup_interval,
+                               double dedup_freq_tolerance) const
+{
+    // spots of the same batch are not in the store yet
+    for ( auto it = newEntries.crbegin(); it != newEntries.crend(); ++it )
+    {
+        if ( it->callsign == entry.callsign
+             && qAbs(it->freq - entry.freq) < dedup_freq_tolerance )
+        {
+            qCDebug(runtime) << "Duplicate spot" << it->callsign << it->freq <<  entry.callsign << entry.freq;
+            return true;
+        }
+    }
+
+    return dxData.isDuplicate(entry, dedup_interval, dedup_freq_tolerance);
+}
+
+void DxTableModel::removeExpiredEntries(qint64 maxAge)
+{
+    const int expired = dxData.countOlderThan(QDateTime::currentDateTimeUtc().addSecs(-maxAge));
+
+    removeOldestEntries(expired);
+}
+
+void DxTableModel::removeOldestEntries(int number)
+{
+    if ( number <= 0 )
+    {
+        return;
     }
 
-    return shouldInsert;
+    qCDebug(runtime) << "Removing" << number << "oldest spots";
+
+    // the oldest spots are at the bottom of the table
+    beginRemoveRows(QModelIndex(), dxData.count() - number, dxData.count() - 1);
+    dxData.removeOldest(number);
+    endRemoveRows();
 }
 
 QString DxTableModel::getCallsign(const QModelIndex& index) {
@@ -378,7 +438,8 @@ DxWidget::DxWidget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::DxWidget),
     deduplicateSpots(false),
-    reconnectAttempts(0)
+    reconnectAttempts(0),
+    ingest(new DxClusterIngest())
 {
     FCT_IDENTIFICATION;
 
@@ -386,6 +447,13 @@ DxWidget::DxWidget(QWidget *parent) :
 
     socket = nullptr;
 
+    // DX Spots are parsed and enriched in the ingest thread
+    ingest->moveToThread(&ingestThread);
+    connect(&ingestThread, &QThread::finished, ingest, &QObject::deleteLater);
+    connect(this, &DxWidget::spotLinesReceived, ingest, &DxClusterIngest::processLines);
+    connect(ingest, &DxClusterIngest::spotsReady, this, &DxWidget::processSpotBatch);
+    ingestThread.start();
+
     ui->setupUi(this);
 
     ui->serverSelect->setStyleSheet("QComboBox {color: red}");
@@ -461,6 +529,13 @@ DxWidget::DxWidget(QWidget *parent) :
     reconnectTimer.setSingleShot(true);
     connect(&reconnectTimer, &QTimer::timeout, this, &DxWidget::connectCluster);
 
+    // aged spots are removed also when no new spot is received
+    connect(&spotExpireTimer, &QTimer::timeout, this, [this]()
+    {
+        dxTableModel->removeExpiredEntries();
+    });
+    spotExpireTimer.start(SPOT_EXPIRE_CHECK_INTERVAL);
+
     restoreWidgetSetting();
 }
 
@@ -741,10 +816,6 @@ void DxWidget::receive()
 {
     FCT_IDENTIFICATION;
 
-    static QRegularExpression dxSpotRE("^DX de ([a-zA-Z0-9\\/]+).*:\\s+([0-9|.]+)\\s+([a-zA-Z0-9\\/]+)[^\\s]*\\s+(.*)\\s+(\\d{4}Z)",
-                                       QRegularExpression::CaseInsensitiveOption);
-    QRegularExpressionMatch dxSpotMatch;
-
     static QRegularExpression wcySpotRE("^(WCY de) +([A-Z0-9\\-#]*) +<(\\d{2})> *: +K=(\\d{1,3}) expK=(\\d{1,3}) A=(\\d{1,3}) R=(\\d{1,3}) SFI=(\\d{1,3}) SA=([a-zA-Z]{1,3}) GMF=([a-zA-Z]{1,3}) Au=([a-zA-Z]{2}) *$",
                                         QRegularExpression::CaseInsensitiveOption);
     QRegularExpressionMatch wcySpotMatch;
@@ -763,6 +834,7 @@ void DxWidget::receive()
     reconnectAttempts = 0;
     QString data(socket->readAll());
     QStringList lines = data.split(splitLineRE);
+    QStringList spotLines;
 
     foreach (QString line, lines)
     {
@@ -790,47 +862,7 @@ void DxWidget::receive()
         /********************/
         if ( line.startsWith("DX") )
         {
-            dxSpotMatch = dxSpotRE.match(line);
-
-            if ( dxSpotMatch.hasMatch() )
-            {
-                QString spotter = dxSpotMatch.captured(1);
-                QString freq =    dxSpotMatch.captured(2);
-                QString call =    dxSpotMatch.captured(3);
-                QString comment = dxSpotMatch.captured(4);
-
-                DxccEntity dxcc = Data::instance()->lookupDxcc(call);
-                DxccEntity dxcc_spotter = Data::instance()->lookupDxcc(spotter);
-
-                DxSpot spot;
-
-                spot.time =  QDateTime::currentDateTime().toTimeSpec(Qt::UTC);
-                spot.callsign = call;
-                spot.freq = freq.toDouble() / 1000;
-                spot.band = Data::band(spot.freq).name;
-                spot.mode = Data::freqToDXCCMode(spot.freq);
-                spot.spotter = spotter;
-                spot.comment = comment;
-                spot.dxcc = dxcc;
-                spot.dxcc_spotter = dxcc_spotter;
-                spot.status = Data::dxccStatus(spot.dxcc.dxcc, spot.band, Data::freqToDXCCMode(spot.freq));
-                spot.callsign_member = MembershipQE::instance()->query(spot.callsign);
-
-                emit newSpot(spot);
-
-                if ( spot.mode.contains(moderegexp)
-                     && spot.dxcc.cont.contains(contregexp)
-                     && spot.dxcc_spotter.cont.contains(spottercontregexp)
-                     && spot.band.contains(bandregexp)
-                     && ( spot.status & dxccStatusFilter)
-                     && ( dxMemberFilter.size() == 0
-                          || (dxMemberFilter.size() && spot.memberList2Set().intersects(dxMemberFilter)))
-                    )
-                {
-                    if ( dxTableModel->addEntry(spot, deduplicateSpots) )
-                        emit newFilteredSpot(spot);
-                }
-            }
+            spotLines << line;
         }
         /************************/
         /* Received WCY Info */
@@ -902,6 +934,48 @@ void DxWidget::receive()
         }
         ui->log->appendPlainText(line);
     }
+
+    if ( !spotLines.isEmpty() )
+    {
+        emit spotLinesReceived(spotLines);
+    }
+}
+
+void DxWidget::processSpotBatch(const QList<DxSpot> &spots,
+                                const DxClusterIngestStats &stats)
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer insertTimer;
+    insertTimer.start();
+
+    QList<DxSpot> filteredSpots;
+
+    for ( const DxSpot &spot : spots )
+    {
+        emit newSpot(spot);
+
+        if ( spot.mode.contains(moderegexp)
+             && spot.dxcc.cont.contains(contregexp)
+             && spot.dxcc_spotter.cont.contains(spottercontregexp)
+             && spot.band.contains(bandregexp)
+             && ( spot.status & dxccStatusFilter)
+             && ( dxMemberFilter.size() == 0
+                  || (dxMemberFilter.size() && spot.memberList2Set().intersects(dxMemberFilter)))
+            )
+        {
+            filteredSpots << spot;
+        }
+    }
+
+    const QList<DxSpot> insertedSpots = dxTableModel->addEntries(filteredSpots, deduplicateSpots);
+
+    for ( const DxSpot &spot : insertedSpots )
+    {
+        emit newFilteredSpot(spot);
+    }
+
+    qCDebug(runtime) << stats << "; Model:" << insertTimer.nsecsElapsed() / 1000 << "us";
 }
 
 void DxWidget::socketError(QAbstractSocket::SocketError socker_error)
@@ -1202,6 +1276,12 @@ QStringList DxWidget::getDXCServerList()
 DxWidget::~DxWidget() {
     FCT_IDENTIFICATION;
 
+    /* queued spot lines are not processed anymore */
+    disconnect(this, &DxWidget::spotLinesReceived, ingest, &DxClusterIngest::processLines);
+    ingest->cancel();
+    ingestThread.quit();
+    ingestThread.wait();
+
     saveDXCServers();
     saveWidgetSetting();
     delete ui;
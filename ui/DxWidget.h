@@ -9,14 +9,18 @@
 
 #include "data/Data.h"
 #include "data/DxSpot.h"
+#include "data/DxSpotStore.h"
 #include "data/WCYSpot.h"
 #include "data/WWVSpot.h"
 #include "data/ToAllSpot.h"
 #include "ui/SwitchButton.h"
 #include "core/LogLocale.h"
+#include "core/DxClusterIngest.h"
 
 #define DEDUPLICATION_TIME 3
 #define DEDUPLICATION_FREQ_TOLERANCE 0.005
+#define DX_SPOT_CAPACITY 10000
+#define DX_SPOT_MAX_AGE 43200
 
 namespace Ui {
 class DxWidget;
@@ -26,7 +30,8 @@ class DxTableModel : public QAbstractTableModel {
     Q_OBJECT
 
 public:
-    DxTableModel(QObject* parent = 0) : QAbstractTableModel(parent) {}
+    DxTableModel(QObject* parent = 0) : QAbstractTableModel(parent),
+                                        dxData(DX_SPOT_CAPACITY) {}
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const;
     int columnCount(const QModelIndex& parent = QModelIndex()) const;
@@ -36,12 +41,23 @@ public:
                   bool deduplicate = false,
                   qint16 dedup_interval = DEDUPLICATION_TIME,
                   double freq_tolerance = DEDUPLICATION_FREQ_TOLERANCE);
+    QList<DxSpot> addEntries(const QList<DxSpot> &entries,
+                             bool deduplicate = false,
+                             qint16 dedup_interval = DEDUPLICATION_TIME,
+                             double freq_tolerance = DEDUPLICATION_FREQ_TOLERANCE);
+    void removeExpiredEntries(qint64 maxAge = DX_SPOT_MAX_AGE);
     QString getCallsign(const QModelIndex& index);
     double getFrequency(const QModelIndex& index);
     void clear();
 
 private:
-    QList<DxSpot> dxData;
+    bool isDuplicate(const DxSpot &entry,
+                     const QList<DxSpot> &newEntries,
+                     qint16 dedup_interval,
+                     double dedup_freq_tolerance) const;
+    void removeOldestEntries(int number);
+
+    DxSpotStore dxData;
     LogLocale locale;
 };
 
@@ -125,7 +141,8 @@ public slots:
     void adjusteServerSelectSize(QString);
     void serverSelectChanged(int);
     void setLastQSO(QSqlRecord);
-
+    void processSpotBatch(const QList<DxSpot> &spots,
+                          const DxClusterIngestStats &stats);
 
 private slots:
     void actionCommandSpotQSO();
@@ -143,6 +160,7 @@ signals:
     void newWWVSpot(WWVSpot);
     void newToAllSpot(ToAllSpot);
     void newFilteredSpot(DxSpot);
+    void spotLinesReceived(QStringList);
 
 private:
     DxTableModel* dxTableModel;
@@ -161,6 +179,9 @@ private:
     QSqlRecord lastQSO;
     quint8 reconnectAttempts;
     QTimer reconnectTimer;
+    QTimer spotExpireTimer;
+    QThread ingestThread;
+    DxClusterIngest *ingest;
 
     void connectCluster();
     void disconnectCluster(bool tryReconnect = false);
@@ -1,6 +1,9 @@
 #include <QFileDialog>
 #include <QDebug>
 #include <QMessageBox>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QPushButton>
 #include <QSqlError>
 #include "ui/ExportDialog.h"
 #include "ui_ExportDialog.h"
@@ -34,7 +37,9 @@ ExportDialog::ExportDialog(QWidget *parent) :
 ExportDialog::ExportDialog(const QList<QSqlRecord>& qsos, QWidget *parent) :
     QDialog(parent),
     ui(new Ui::ExportDialog),
-    qsos4export(qsos)
+    qsos4export(qsos),
+    activeWorker(nullptr),
+    contactsUpdated(false)
 {
     FCT_IDENTIFICATION;
 
@@ -204,31 +209,59 @@ void ExportDialog::runExport()
         format->setExportedFields(fields);
     }
 
-    if ( qsos4export.size() > 0 )
-    {
-        count = format->runExport(qsos4export);
-    }
-    else
-    {
-        count = format->runExport();
+    // only Cancel is available during the export
+    ui->buttonBox->setEnabled(true);
+    ui->buttonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
+
+    QElapsedTimer exportTimer;
+    exportTimer.start();
+
+    /* the export runs in a worker thread, the GUI is still responsive */
+    LogFormatWorker worker(format, LogFormatWorker::EXPORT);
+    QEventLoop loop;
+
+    connect(&worker, &LogFormatWorker::workFinished, &loop, &QEventLoop::quit);
 
-        if ( count > 0
-             && ui->exportTypeCombo->currentData() == "qsl"
-             && ui->markAsSentCheckbox->isChecked() )
+    worker.setExportedQSOs(qsos4export);
+    activeWorker = &worker;
+    worker.start();
+    loop.exec();
+    worker.wait();
+    activeWorker = nullptr;
+
+    const qint64 exportTime = exportTimer.elapsed();
+    const bool cancelled = worker.isCancelled();
+
+    count = worker.count();
+
+    if ( count > 0
+         && qsos4export.isEmpty()
+         && !cancelled
+         && ui->exportTypeCombo->currentData() == "qsl"
+         && ui->markAsSentCheckbox->isChecked() )
+    {
+        if ( ! markQSOAsSent(format) )
         {
-            if ( ! markQSOAsSent(format) )
-            {
-                QMessageBox::warning(this,
-                                    tr("QLog Error"),
-                                    tr("Cannot mark exported QSOs as Sent"));
-            }
+            QMessageBox::warning(this,
+                                tr("QLog Error"),
+                                tr("Cannot mark exported QSOs as Sent"));
+        }
+        else
+        {
+            contactsUpdated = true;
         }
     }
 
+    const double exportRate = ( exportTime > 0 ) ? count * 1000.0 / exportTime : count;
+
+    qCDebug(runtime) << "Exported" << count << "contacts in" << exportTime << "ms";
+
     delete format;
 
     QMessageBox::information(nullptr, QMessageBox::tr("QLog Information"),
-                         QMessageBox::tr("Exported %n contact(s).", "", count));
+                         QMessageBox::tr("Exported %n contact(s).", "", count)
+                         + "\n" + tr("Throughput: %1 QSOs/s").arg(exportRate, 0, 'f', 0)
+                         + (( cancelled ) ? "\n" + tr("Export was cancelled") : QString()));
 
     accept();
 }
@@ -395,7 +428,28 @@ void ExportDialog::setProgress(float progress)
     FCT_IDENTIFICATION;
 
     ui->progressBar->setValue(progress);
-    QCoreApplication::processEvents();
+}
+
+bool ExportDialog::contactsChanged() const
+{
+    FCT_IDENTIFICATION;
+
+    return contactsUpdated;
+}
+
+void ExportDialog::reject()
+{
+    FCT_IDENTIFICATION;
+
+    /* the export is running - cancel it, the dialog is closed when the export finishes */
+    if ( activeWorker )
+    {
+        qCDebug(runtime) << "Cancelling export";
+        activeWorker->cancel();
+        return;
+    }
+
+    QDialog::reject();
 }
 
 void ExportDialog::fillQSLSendViaCombo()
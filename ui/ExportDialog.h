@@ -10,6 +10,7 @@
 #include "core/LogLocale.h"
 #include "models/LogbookModel.h"
 #include "logformat/LogFormat.h"
+#include "logformat/LogFormatWorker.h"
 
 namespace Ui {
 class ExportDialog;
@@ -24,7 +25,10 @@ public:
     explicit ExportDialog(const QList<QSqlRecord>&, QWidget *parent = nullptr);
     ~ExportDialog();
 
+    bool contactsChanged() const;
+
 public slots:
+    void reject() override;
     void browse();
     void toggleDateRange();
     void toggleMyCallsign();
@@ -61,6 +65,8 @@ private:
     LogbookModel logbookmodel;
     QSettings settings;
     const QList<QSqlRecord> qsos4export;
+    LogFormatWorker *activeWorker;
+    bool contactsUpdated;
 
     void setProgress(float);
     void fillQSLSendViaCombo();
@@ -10,7 +10,7 @@
 #include "logformat/AdiFormat.h"
 #include "core/debug.h"
 #include "ui/ShowUploadDialog.h"
-#include "core/HRDLog.h"
+#include "core/UploadOutbox.h"
 
 MODULE_IDENTIFICATION("qlog.ui.hrdlogdialog");
 
@@ -71,7 +71,7 @@ void HRDLogDialog::upload()
     qCDebug(runtime) << query_string;
 
     QSqlQuery query(query_string);
-    QList<QSqlRecord> qsos;
+    QList<int> contactIDs;
 
     while (query.next())
     {
@@ -83,10 +83,10 @@ void HRDLogDialog::upload()
                        + "\t" + record.value("mode").toString()
                        + "\n");
 
-        qsos.append(record);
+        contactIDs.append(record.value("id").toInt());
     }
 
-    count = qsos.count();
+    count = contactIDs.count();
 
     if (count > 0)
     {
@@ -102,50 +102,56 @@ void HRDLogDialog::upload()
             dialog->setAttribute(Qt::WA_DeleteOnClose, true);
             dialog->show();
 
-            HRDLog *hrdlog = new HRDLog(dialog);
+            /* QSOs are uploaded by the Upload Outbox, the dialog only shows their progress */
+            UploadOutboxWatcher *watcher = new UploadOutboxWatcher(UploadOutbox::HRDLOG, contactIDs, dialog);
 
-            connect(hrdlog, &HRDLog::uploadedQSO, this, [hrdlog, dialog](int qsoID)
-            {
-                QString query_string = "UPDATE contacts "
-                                       "SET hrdlog_qso_upload_status='Y', hrdlog_qso_upload_date = strftime('%Y-%m-%d',DATETIME('now', 'utc')) "
-                                       "WHERE id = :qsoID";
-
-                qCDebug(runtime) << query_string;
+            connect(watcher, &UploadOutboxWatcher::progress, dialog, &QProgressDialog::setValue);
 
-                QSqlQuery query_update;
+            connect(watcher, &UploadOutboxWatcher::finished, dialog, [this, dialog](int uploaded)
+            {
+                dialog->disconnect(this);
+                dialog->done(QDialog::Accepted);
+                qCDebug(runtime) << "HRDLog.com Upload OK";
 
-                query_update.prepare(query_string);
-                query_update.bindValue(":qsoID", qsoID);
+                const QString failed = UploadOutbox::failedSummary(UploadOutbox::HRDLOG);
 
-                if ( ! query_update.exec() )
+                if ( failed.isEmpty() )
                 {
-                    qInfo() << "Cannot Update HRDLog status for QSO number " << qsoID << " " << query_update.lastError().text();
-                    hrdlog->abortRequest();
-                    hrdlog->deleteLater();
+                    QMessageBox::information(this, tr("QLog Information"),
+                                             tr("%n QSO(s) uploaded.", "", uploaded));
+                }
+                else
+                {
+                    QMessageBox::warning(this, tr("QLog Warning"),
+                                         tr("%n QSO(s) uploaded.", "", uploaded) + "\n" + failed);
                 }
-                dialog->setValue(dialog->value() + 1);
             });
 
-            connect(hrdlog, &HRDLog::uploadFinished, this, [this, hrdlog, dialog, count](bool)
+            connect(watcher, &UploadOutboxWatcher::failed, dialog, [this, dialog](const QString &msg, int notUploaded)
             {
+                dialog->disconnect(this);
                 dialog->done(QDialog::Accepted);
-                QMessageBox::information(this, tr("QLog Information"),
-                                         tr("%n QSO(s) uploaded.", "", count));
-                hrdlog->deleteLater();
+                qCInfo(runtime) << "HRDLog.com Upload Error: " << msg;
+
+                QString text = tr("Cannot upload the QSO(s): ") + msg + "\n"
+                               + tr("%n QSO(s) stay in the upload queue and will be retried later.", "", notUploaded);
+                const QString failed = UploadOutbox::failedSummary(UploadOutbox::HRDLOG);
+
+                if ( !failed.isEmpty() )
+                {
+                    text.append("\n" + failed);
+                }
+
+                QMessageBox::warning(this, tr("QLog Warning"), text);
             });
 
-            connect(hrdlog, &HRDLog::uploadError, this, [this, hrdlog, dialog](const QString &msg)
+            connect(dialog, &QProgressDialog::canceled, this, [watcher]()
             {
-                dialog->done(QDialog::Accepted);
-                qCInfo(runtime) << "HRDLog.com Upload Error: " << msg;
-                QMessageBox::warning(this, tr("QLog Warning"),
-                                     tr("Cannot upload the QSO(s): ") + msg);
-                hrdlog->deleteLater();
+                qCDebug(runtime)<< "Operation canceled";
+                watcher->cancel();
             });
 
-            connect(dialog, &QProgressDialog::canceled, hrdlog, &HRDLog::abortRequest);
-
-            hrdlog->uploadContacts(qsos);
+            watcher->start();
         }
     }
     else
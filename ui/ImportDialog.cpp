@@ -1,5 +1,7 @@
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QPushButton>
+#include <QEventLoop>
 #include "ImportDialog.h"
 #include "ui_ImportDialog.h"
 #include "logformat/LogFormat.h"
@@ -13,7 +15,9 @@ MODULE_IDENTIFICATION("qlog.ui.importdialog");
 
 ImportDialog::ImportDialog(QWidget *parent) :
     QDialog(parent),
-    ui(new Ui::ImportDialog)
+    ui(new Ui::ImportDialog),
+    activeWorker(nullptr),
+    importedCount(0L)
 {
     FCT_IDENTIFICATION;
 
@@ -111,7 +115,28 @@ void ImportDialog::computeProgress(qint64 position)
 
     int progress = (int)(position * 100 / size);
     ui->progressBar->setValue(progress);
-    QCoreApplication::processEvents();
+}
+
+long ImportDialog::importedContacts() const
+{
+    FCT_IDENTIFICATION;
+
+    return importedCount;
+}
+
+void ImportDialog::reject()
+{
+    FCT_IDENTIFICATION;
+
+    /* the import is running - cancel it, the dialog is closed when the import finishes */
+    if ( activeWorker )
+    {
+        qCDebug(runtime) << "Cancelling import";
+        activeWorker->cancel();
+        return;
+    }
+
+    QDialog::reject();
 }
 
 void ImportDialog::stationProfileTextChanged(const QString &newProfileName)
@@ -188,8 +213,17 @@ void ImportDialog::runImport() {
         return;
     }
 
+    /* the file is opened in binary mode, the parsers handle CR/LF themselves
+     * and only a binary file can be mapped to memory (large ADIF files) */
     QFile file(ui->fileEdit->text());
-    file.open(QFile::ReadOnly | QFile::Text);
+
+    if ( !file.open(QFile::ReadOnly) )
+    {
+        QMessageBox::warning(nullptr, QMessageBox::tr("QLog Warning"),
+                             QMessageBox::tr("Cannot open the file - ") + file.errorString());
+        return;
+    }
+
     QTextStream in(&file);
 
     size = file.size();
@@ -298,17 +332,47 @@ void ImportDialog::runImport() {
     ui->commentEdit->setEnabled(false);
     ui->updateDxccCheckBox->setEnabled(false);
 
+    // only Cancel is available during the import
+    ui->buttonBox->setEnabled(true);
+    ui->buttonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
+
     QString s;
-    QTextStream out(&s);
-    unsigned long errors = 0L;
-    unsigned long warnings = 0L;
 
-    int count = format->runImport(out, &warnings, &errors);
+    connect(format, &LogFormat::importLogLines, this, [&s](const QStringList &lines)
+    {
+        s.append(lines.join('\n')).append('\n');
+    });
+
+    /* the import runs in a worker thread, the GUI is still responsive */
+    LogFormatWorker worker(format, LogFormatWorker::IMPORT);
+    QEventLoop loop;
+
+    connect(&worker, &LogFormatWorker::workFinished, &loop, &QEventLoop::quit);
+
+    activeWorker = &worker;
+    worker.start();
+    loop.exec();
+    worker.wait();
+    activeWorker = nullptr;
+
+    int count = worker.count();
+    unsigned long errors = worker.errors();
+    unsigned long warnings = worker.warnings();
+    const bool cancelled = worker.isCancelled();
+
+    importedCount = count;
+
+    delete format;
 
     QString report = QObject::tr("<b>Imported</b>: %n contact(s)", "", count) + "<br/>" +
                      QObject::tr("<b>Warning(s)</b>: %n", "", warnings) + "<br/>" +
                      QObject::tr("<b>Error(s)</b>: %n", "", errors);
 
+    if ( cancelled )
+    {
+        report += "<br/>" + tr("<b>Import was cancelled</b>");
+    }
+
     QMessageBox msgBox;
     msgBox.setWindowTitle(tr("Import Result"));
     msgBox.setText(report);
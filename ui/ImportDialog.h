@@ -4,6 +4,7 @@
 #include <QDialog>
 #include <QSqlRecord>
 #include <logformat/LogFormat.h>
+#include "logformat/LogFormatWorker.h"
 #include "data/StationProfile.h"
 #include "core/LogLocale.h"
 
@@ -19,6 +20,11 @@ public:
     explicit ImportDialog(QWidget *parent = 0);
     ~ImportDialog();
 
+    long importedContacts() const;
+
+public slots:
+    void reject() override;
+
 private slots:
     void browse();
     void toggleAll();
@@ -36,6 +42,8 @@ private:
     qint64 size;
     StationProfile selectedStationProfile;
     LogLocale locale;
+    LogFormatWorker *activeWorker;
+    long importedCount;
 
     static LogFormat::duplicateQSOBehaviour showDuplicateDialog(QSqlRecord *, QSqlRecord *);
 };
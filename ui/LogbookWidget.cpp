@@ -25,6 +25,7 @@
 #include "ui/QSODetailDialog.h"
 #include "core/MembershipQE.h"
 #include "core/GenericCallbook.h"
+#include "data/CallsignSearchIndex.h"
 
 MODULE_IDENTIFICATION("qlog.ui.logbookwidget");
 
@@ -554,7 +555,7 @@ void LogbookWidget::updateTable()
 
     if ( !callsignFilterValue.isEmpty() )
     {
-        filterString.append(QString("callsign LIKE '%%1%'").arg(callsignFilterValue.toUpper()));
+        filterString.append(CallsignSearchIndex::containsFilter(callsignFilterValue));
     }
 
     QString bandFilterValue = ui->bandFilter->currentText();
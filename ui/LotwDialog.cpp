@@ -1,4 +1,3 @@
-#include <QTextStream>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QSqlRecord>
@@ -6,11 +5,12 @@
 #include <QProgressDialog>
 #include <QSettings>
 #include <QNetworkReply>
+#include <QSharedPointer>
 
 #include "LotwDialog.h"
 #include "ui_LotwDialog.h"
-#include "logformat/AdiFormat.h"
 #include "core/Lotw.h"
+#include "core/LotwUploadJob.h"
 #include "core/debug.h"
 #include "ui/QSLImportStatDialog.h"
 #include "models/SqlListModel.h"
@@ -94,12 +94,8 @@ void LotwDialog::download() {
 void LotwDialog::upload() {
     FCT_IDENTIFICATION;
 
-    QByteArray data;
-    QTextStream stream(&data, QIODevice::ReadWrite);
-
-    AdiFormat adi(stream);
     QString QSOList;
-    int count = 0;
+    QList<int> contactIDs;
 
     QStringList qslSentStatuses = {"'R'", "'Q'"};
 
@@ -113,11 +109,7 @@ void LotwDialog::upload() {
         qslSentStatuses << "'N'";
     }
 
-    QString query_string = "SELECT callsign, freq, band, freq_rx, "
-                           "       mode, submode, start_time, prop_mode, "
-                           "       sat_name, station_callsign, operator, "
-                           "       rst_sent, rst_rcvd, my_state, my_cnty, "
-                           "       my_vucc_grids "
+    QString query_string = "SELECT id, callsign, mode, start_time "
                            "FROM contacts ";
     QString query_where =  QString("WHERE (upper(lotw_qsl_sent) in (%1) OR lotw_qsl_sent is NULL) "
                            "               AND (upper(prop_mode) NOT IN ('INTERNET', 'RPT', 'ECH', 'IRL') OR prop_mode IS NULL) ").arg(qslSentStatuses.join(","));
@@ -151,42 +143,70 @@ void LotwDialog::upload() {
                        + "\t" + record.value("mode").toString()
                        + "\n");
 
-        adi.exportContact(record);
-        count++;
+        contactIDs << record.value("id").toInt();
     }
 
-    stream.flush();
-
-    if (count > 0)
+    if ( contactIDs.size() > 0 )
     {
         ShowUploadDialog showDialog(QSOList);
 
         if ( showDialog.exec() == QDialog::Accepted )
         {
-            Lotw lotw;
-            QString ErrorString;
+            QProgressDialog* dialog = new QProgressDialog(tr("Uploading to LoTW"), tr("Cancel"), 0, contactIDs.size(), this);
+            dialog->setWindowModality(Qt::WindowModal);
+            dialog->setAutoClose(false);
+            dialog->setAutoReset(false);
+            dialog->setAttribute(Qt::WA_DeleteOnClose, true);
+            dialog->show();
+
+            /* TQSL runs in the background, its output is shown in the dialog */
+            LotwUploadJob *job = new LotwUploadJob(contactIDs, dialog);
+            QSharedPointer<QStringList> tqslOutput(new QStringList);
+
+            connect(job, &LotwUploadJob::output, dialog, [dialog, tqslOutput](const QString &line)
+            {
+                tqslOutput->append(line);
+                dialog->setLabelText(line);
+            });
+
+            connect(job, &LotwUploadJob::progress, dialog, [dialog](int uploadedQSOs, int)
+            {
+                dialog->setValue(uploadedQSOs);
+            });
 
-            if ( lotw.uploadAdif(data, ErrorString) == 0 )
+            connect(job, &LotwUploadJob::finished, dialog, [this, dialog, tqslOutput](int uploadedQSOs, const QString &error)
             {
-                QMessageBox::information(this, tr("QLog Information"), tr("%n QSO(s) uploaded.", "", count));
+                const QString details = tqslOutput->join("\n");
 
-                query_string = "UPDATE contacts "
-                               "SET lotw_qsl_sent='Y', lotw_qslsdate = strftime('%Y-%m-%d',DATETIME('now', 'utc')) "
-                               + query_where;
+                dialog->disconnect(this);
+                dialog->done(QDialog::Accepted);
 
-                qCDebug(runtime) << query_string;
+                QMessageBox msgBox(this);
+                msgBox.setDetailedText(details);
 
-                QSqlQuery query_update(query_string);
-                if ( ! query_update.exec() )
+                if ( error.isEmpty() )
                 {
-                    qWarning() << "Cannot execute update query" << query_update.lastError().text();
-                    return;
+                    msgBox.setIcon(QMessageBox::Information);
+                    msgBox.setWindowTitle(tr("QLog Information"));
+                    msgBox.setText(tr("%n QSO(s) uploaded.", "", uploadedQSOs));
                 }
-            }
-            else
+                else
+                {
+                    msgBox.setIcon(QMessageBox::Critical);
+                    msgBox.setWindowTitle(tr("LoTW Error"));
+                    msgBox.setText(error + "\n" + tr("%n QSO(s) uploaded.", "", uploadedQSOs));
+                }
+
+                msgBox.exec();
+            });
+
+            connect(dialog, &QProgressDialog::canceled, this, [job]()
             {
-                QMessageBox::critical(this, tr("LoTW Error"), ErrorString);
-            }
+                qCDebug(runtime)<< "Operation canceled";
+                job->cancel();
+            });
+
+            job->start();
         }
     }
     else {
@@ -158,6 +158,8 @@ MainWindow::MainWindow(QWidget* parent) :
     connect(this, &MainWindow::settingsChanged, ui->rotatorWidget, &RotatorWidget::redrawMap);
     connect(this, &MainWindow::settingsChanged, ui->onlineMapWidget, &OnlineMapWidget::flyToMyQTH);
     connect(this, &MainWindow::settingsChanged, ui->logbookWidget, &LogbookWidget::reloadSetting);
+    connect(this, &MainWindow::settingsChanged, &callbookPrefetcher, &CallbookPrefetcher::initCallbooks);
+    connect(this, &MainWindow::settingsChanged, &networknotification, &NetworkNotification::reloadSettings);
     connect(this, &MainWindow::layoutChanged, ui->newContactWidget, &NewContactWidget::setupCustomUi);
     connect(this, &MainWindow::alertRulesChanged, &alertEvaluator, &AlertEvaluator::loadRules);
     connect(this, &MainWindow::altBackslash, Rig::instance(), &Rig::setPTT);
@@ -165,6 +167,11 @@ MainWindow::MainWindow(QWidget* parent) :
 
     //ClubLog* clublog = new ClubLog(this);
 
+    // DXCC Status Index must be updated before other receivers evaluate DXCC Status
+    connect(ui->logbookWidget, &LogbookWidget::contactUpdated, Data::instance(), &Data::dxccStatusContactSaved);
+    connect(ui->logbookWidget, &LogbookWidget::contactDeleted, Data::instance(), &Data::dxccStatusContactDeleted);
+    connect(ui->newContactWidget, &NewContactWidget::contactAdded, Data::instance(), &Data::dxccStatusContactSaved);
+
     connect(ui->logbookWidget, &LogbookWidget::logbookUpdated, stats, &StatisticsWidget::refreshGraph);
     connect(ui->logbookWidget, &LogbookWidget::contactUpdated, &networknotification, &NetworkNotification::QSOUpdated);
     connect(ui->logbookWidget, &LogbookWidget::contactDeleted, &networknotification, &NetworkNotification::QSODeleted);
@@ -173,6 +180,7 @@ MainWindow::MainWindow(QWidget* parent) :
     connect(ui->newContactWidget, &NewContactWidget::contactAdded, &networknotification, &NetworkNotification::QSOInserted);
     connect(ui->newContactWidget, &NewContactWidget::contactAdded, ui->bandmapWidget, &BandmapWidget::spotsDxccStatusRecal);
     connect(ui->newContactWidget, &NewContactWidget::contactAdded, ui->dxWidget, &DxWidget::setLastQSO);
+    connect(ui->newContactWidget, &NewContactWidget::contactAdded, &uploadOutbox, &UploadOutbox::contactAdded);
 
     connect(ui->newContactWidget, &NewContactWidget::newTarget, ui->mapWidget, &MapWidget::setTarget);
     connect(ui->newContactWidget, &NewContactWidget::newTarget, ui->onlineMapWidget, &OnlineMapWidget::setTarget);
@@ -189,6 +197,7 @@ MainWindow::MainWindow(QWidget* parent) :
     connect(ui->newContactWidget, &NewContactWidget::rigProfileChanged, ui->rigWidget, &RigWidget::refreshRigProfileCombo);
 
     connect(ui->dxWidget, &DxWidget::newFilteredSpot, ui->bandmapWidget, &BandmapWidget::addSpot);
+    connect(ui->dxWidget, &DxWidget::newFilteredSpot, &callbookPrefetcher, &CallbookPrefetcher::prefetchSpot);
     connect(ui->dxWidget, &DxWidget::newSpot, &networknotification, &NetworkNotification::dxSpot);
     connect(ui->dxWidget, &DxWidget::newSpot, &alertEvaluator, &AlertEvaluator::dxSpot);
     connect(ui->dxWidget, &DxWidget::newWCYSpot, &networknotification, &NetworkNotification::wcySpot);
@@ -203,6 +212,7 @@ MainWindow::MainWindow(QWidget* parent) :
     connect(ui->bandmapWidget, &BandmapWidget::nearestSpotFound, ui->newContactWidget, &NewContactWidget::nearestSpot);
 
     connect(ui->wsjtxWidget, &WsjtxWidget::showDxDetails, ui->newContactWidget, &NewContactWidget::showDx);
+    connect(ui->wsjtxWidget, &WsjtxWidget::CQSpot, &callbookPrefetcher, &CallbookPrefetcher::prefetchWsjtxEntry);
 
     connect(ui->rigWidget, &RigWidget::rigProfileChanged, ui->newContactWidget, &NewContactWidget::refreshRigProfileCombo);
 
@@ -232,6 +242,10 @@ MainWindow::MainWindow(QWidget* parent) :
     {
         MembershipQE::instance()->updateLists();
     }
+
+    /* upload QSOs left in the Outbox */
+    uploadOutbox.start();
+
     /*************/
     /* SHORTCUTs */
     /*************/
@@ -680,7 +694,12 @@ void MainWindow::importLog() {
 
     ImportDialog dialog;
     dialog.exec();
-    ui->logbookWidget->updateTable();
+
+    // the logbook is reloaded only when it was changed
+    if ( dialog.importedContacts() > 0 )
+    {
+        ui->logbookWidget->updateTable();
+    }
 }
 
 void MainWindow::exportLog() {
@@ -688,7 +707,12 @@ void MainWindow::exportLog() {
 
     ExportDialog dialog;
     dialog.exec();
-    ui->logbookWidget->updateTable();
+
+    // the logbook is reloaded only when QSOs were marked as sent
+    if ( dialog.contactsChanged() )
+    {
+        ui->logbookWidget->updateTable();
+    }
 }
 
 void MainWindow::showLotw()
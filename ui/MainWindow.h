@@ -9,6 +9,8 @@
 #include "ui/AlertWidget.h"
 #include "core/PropConditions.h"
 #include "core/MembershipQE.h"
+#include "core/CallbookPrefetcher.h"
+#include "core/UploadOutbox.h"
 
 namespace Ui {
 class MainWindow;
@@ -88,7 +90,9 @@ private:
     StatisticsWidget* stats;
     AlertWidget* alertWidget;
     NetworkNotification networknotification;
+    UploadOutbox uploadOutbox;
     AlertEvaluator alertEvaluator;
+    CallbookPrefetcher callbookPrefetcher;
     PropConditions *conditions;
     QSettings settings;
     bool isFusionStyle;
@@ -25,6 +25,7 @@
 #include "logformat/AdiFormat.h"
 #include "data/MainLayoutProfile.h"
 #include "models/LogbookModel.h"
+#include "models/ReferenceSnapshotModel.h"
 
 MODULE_IDENTIFICATION("qlog.ui.newcontactwidget");
 
@@ -154,19 +155,19 @@ NewContactWidget::NewContactWidget(QWidget *parent) :
     /***************/
     /* Completers  */
     /***************/
-    wwffCompleter = new QCompleter(Data::instance()->wwffIDList(), this);
+    wwffCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::WWFF, this), this);
     wwffCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     wwffCompleter->setFilterMode(Qt::MatchStartsWith);
     wwffCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     uiDynamic->wwffEdit->setCompleter(nullptr);
 
-    potaCompleter = new QCompleter(Data::instance()->potaIDList(), this);
+    potaCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::POTA, this), this);
     potaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     potaCompleter->setFilterMode(Qt::MatchStartsWith);
     potaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     uiDynamic->potaEdit->setCompleter(nullptr);
 
-    sotaCompleter = new QCompleter(Data::instance()->sotaIDList(), this);
+    sotaCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::SOTA, this), this);
     sotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     sotaCompleter->setFilterMode(Qt::MatchStartsWith);
     sotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -3054,7 +3055,7 @@ NewContactDynamicWidgets::NewContactDynamicWidgets(bool allocateWidgets,
         dokEdit->setToolTip(QCoreApplication::translate("NewContactWidget", "the contacted station's DARC DOK (District Location Code) (ex. A01)", nullptr));
 
         //iotaEdit->setMaximumSize(QSize(200, 16777215));
-        QCompleter *iotaCompleter = new QCompleter(Data::instance()->iotaIDList(), iotaEdit);
+        QCompleter *iotaCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::IOTA, iotaEdit), iotaEdit);
         iotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
         iotaCompleter->setFilterMode(Qt::MatchContains);
         iotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -14,6 +14,7 @@
 #include "PaperQSLDialog.h"
 #include "core/Eqsl.h"
 #include "models/SqlListModel.h"
+#include "models/ReferenceSnapshotModel.h"
 #include "core/Gridsquare.h"
 #include "core/Callsign.h"
 
@@ -124,56 +125,56 @@ QSODetailDialog::QSODetailDialog(const QSqlRecord &qso,
     modeModel->select();
 
     /* IOTA Completer */
-    iotaCompleter.reset(new QCompleter(Data::instance()->iotaIDList(), this));
+    iotaCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::IOTA, this), this));
     iotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     iotaCompleter->setFilterMode(Qt::MatchContains);
     iotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->iotaEdit->setCompleter(iotaCompleter.data());
 
     /* SOTA Completer */
-    sotaCompleter.reset(new QCompleter(Data::instance()->sotaIDList(), this));
+    sotaCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::SOTA, this), this));
     sotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     sotaCompleter->setFilterMode(Qt::MatchStartsWith);
     sotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->sotaEdit->setCompleter(nullptr);
 
     /* POTA Completer */
-    potaCompleter.reset(new QCompleter(Data::instance()->potaIDList(), this));
+    potaCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::POTA, this), this));
     potaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     potaCompleter->setFilterMode(Qt::MatchStartsWith);
     potaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->potaEdit->setCompleter(nullptr);
 
     /* WWFF Completer */
-    wwffCompleter.reset(new QCompleter(Data::instance()->wwffIDList(), this));
+    wwffCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::WWFF, this), this));
     wwffCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     wwffCompleter->setFilterMode(Qt::MatchStartsWith);
     wwffCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->wwffEdit->setCompleter(nullptr);
 
     /* MyIOTA Completer */
-    myIotaCompleter.reset(new QCompleter(Data::instance()->iotaIDList(), this));
+    myIotaCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::IOTA, this), this));
     myIotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     myIotaCompleter->setFilterMode(Qt::MatchContains);
     myIotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->myIOTAEdit->setCompleter(myIotaCompleter.data());
 
     /* MySOTA Completer */
-    mySotaCompleter.reset(new QCompleter(Data::instance()->sotaIDList(), this));
+    mySotaCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::SOTA, this), this));
     mySotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     mySotaCompleter->setFilterMode(Qt::MatchStartsWith);
     mySotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->mySOTAEdit->setCompleter(nullptr);
 
     /* MyPOTA Completer */
-    myPotaCompleter.reset(new QCompleter(Data::instance()->potaIDList(), this));
+    myPotaCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::POTA, this), this));
     myPotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     myPotaCompleter->setFilterMode(Qt::MatchStartsWith);
     myPotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->myPOTAEdit->setCompleter(nullptr);
 
     /* MyWWFF Completer */
-    myWWFFCompleter.reset(new QCompleter(Data::instance()->wwffIDList(), this));
+    myWWFFCompleter.reset(new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::WWFF, this), this));
     myWWFFCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     myWWFFCompleter->setFilterMode(Qt::MatchStartsWith);
     myWWFFCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -8,7 +8,7 @@
 #include "QrzDialog.h"
 #include "ui_QrzDialog.h"
 #include "core/debug.h"
-#include "core/QRZ.h"
+#include "core/UploadOutbox.h"
 #include "models/SqlListModel.h"
 #include "ui/ShowUploadDialog.h"
 #include "logformat/AdiFormat.h"
@@ -72,7 +72,7 @@ void QRZDialog::upload()
     qCDebug(runtime) << query_string;
 
     QSqlQuery query(query_string);
-    QList<QSqlRecord> qsos;
+    QList<int> contactIDs;
 
     while (query.next())
     {
@@ -84,10 +84,10 @@ void QRZDialog::upload()
                        + "\t" + record.value("mode").toString()
                        + "\n");
 
-        qsos.append(record);
+        contactIDs.append(record.value("id").toInt());
     }
 
-    count = qsos.count();
+    count = contactIDs.count();
 
     if (count > 0)
     {
@@ -103,50 +103,56 @@ void QRZDialog::upload()
             dialog->setAttribute(Qt::WA_DeleteOnClose, true);
             dialog->show();
 
-            QRZ *qrz = new QRZ(dialog);
+            /* QSOs are uploaded by the Upload Outbox, the dialog only shows their progress */
+            UploadOutboxWatcher *watcher = new UploadOutboxWatcher(UploadOutbox::QRZCOM, contactIDs, dialog);
 
-            connect(qrz, &QRZ::uploadedQSO, this, [qrz, dialog](int qsoID)
-            {
-                QString query_string = "UPDATE contacts "
-                                       "SET qrzcom_qso_upload_status='Y', qrzcom_qso_upload_date = strftime('%Y-%m-%d',DATETIME('now', 'utc')) "
-                                       "WHERE id = :qsoID";
-
-                qCDebug(runtime) << query_string;
+            connect(watcher, &UploadOutboxWatcher::progress, dialog, &QProgressDialog::setValue);
 
-                QSqlQuery query_update;
+            connect(watcher, &UploadOutboxWatcher::finished, dialog, [this, dialog](int uploaded)
+            {
+                dialog->disconnect(this);
+                dialog->done(QDialog::Accepted);
+                qCDebug(runtime) << "QRZ.com Upload OK";
 
-                query_update.prepare(query_string);
-                query_update.bindValue(":qsoID", qsoID);
+                const QString failed = UploadOutbox::failedSummary(UploadOutbox::QRZCOM);
 
-                if ( ! query_update.exec() )
+                if ( failed.isEmpty() )
                 {
-                    qInfo() << "Cannot Update QRZCOM status for QSO number " << qsoID << " " << query_update.lastError().text();
-                    qrz->abortQuery();
-                    qrz->deleteLater();
+                    QMessageBox::information(this, tr("QLog Information"),
+                                             tr("%n QSO(s) uploaded.", "", uploaded));
+                }
+                else
+                {
+                    QMessageBox::warning(this, tr("QLog Warning"),
+                                         tr("%n QSO(s) uploaded.", "", uploaded) + "\n" + failed);
                 }
-                dialog->setValue(dialog->value() + 1);
             });
 
-            connect(qrz, &QRZ::uploadFinished, this, [this, qrz, dialog, count](bool)
+            connect(watcher, &UploadOutboxWatcher::failed, dialog, [this, dialog](const QString &msg, int notUploaded)
             {
+                dialog->disconnect(this);
                 dialog->done(QDialog::Accepted);
-                QMessageBox::information(this, tr("QLog Information"),
-                                         tr("%n QSO(s) uploaded.", "", count));
-                qrz->deleteLater();
+                qCInfo(runtime) << "QRZ.com Upload Error: " << msg;
+
+                QString text = tr("Cannot upload the QSO(s): ") + msg + "\n"
+                               + tr("%n QSO(s) stay in the upload queue and will be retried later.", "", notUploaded);
+                const QString failed = UploadOutbox::failedSummary(UploadOutbox::QRZCOM);
+
+                if ( !failed.isEmpty() )
+                {
+                    text.append("\n" + failed);
+                }
+
+                QMessageBox::warning(this, tr("QLog Warning"), text);
             });
 
-            connect(qrz, &QRZ::uploadError, this, [this, qrz, dialog](const QString &msg)
+            connect(dialog, &QProgressDialog::canceled, this, [watcher]()
             {
-                dialog->done(QDialog::Accepted);
-                qCInfo(runtime) << "QRZ.com Upload Error: " << msg;
-                QMessageBox::warning(this, tr("QLog Warning"),
-                                     tr("Cannot upload the QSO(s): ") + msg);
-                qrz->deleteLater();
+                qCDebug(runtime)<< "Operation canceled";
+                watcher->cancel();
             });
 
-            connect(dialog, &QProgressDialog::canceled, qrz, &QRZ::abortQuery);
-
-            qrz->uploadContacts(qsos);
+            watcher->start();
         }
     }
     else
@@ -36,7 +36,9 @@
 #include "core/CWKeyer.h"
 #include "core/MembershipQE.h"
 #include "models/SqlListModel.h"
+#include "models/ReferenceSnapshotModel.h"
 #include "core/GenericCallbook.h"
+#include "core/CallbookPrefetcher.h"
 #include "core/KSTChat.h"
 
 #define STACKED_WIDGET_SERIAL_SETTING  0
@@ -125,6 +127,12 @@ SettingsDialog::SettingsDialog(QWidget *parent) :
     ui->modeTableView->setItemDelegateForColumn(5,new CheckBoxDelegate(ui->modeTableView));
     modeTableModel->select();
 
+    // modes are stored immediately (OnFieldChange)
+    connect(modeTableModel, &QSqlTableModel::dataChanged, this, []()
+    {
+        Data::invalidateDxccStatus();
+    });
+
     bandTableModel = new QSqlTableModel(this);
     bandTableModel->setTable("bands");
     bandTableModel->setEditStrategy(QSqlTableModel::OnFieldChange);
@@ -144,6 +152,12 @@ SettingsDialog::SettingsDialog(QWidget *parent) :
 
     bandTableModel->select();
 
+    // bands are stored immediately (OnFieldChange)
+    connect(bandTableModel, &QSqlTableModel::dataChanged, this, []()
+    {
+        Data::invalidateBands();
+    });
+
     ui->stationCallsignEdit->setValidator(new QRegularExpressionValidator(Callsign::callsignRegEx(), this));
     ui->stationLocatorEdit->setValidator(new QRegularExpressionValidator(Gridsquare::gridRegEx(), this));
     ui->stationVUCCEdit->setValidator(new QRegularExpressionValidator(Gridsquare::gridVUCCRegEx(), this));
@@ -165,25 +179,25 @@ SettingsDialog::SettingsDialog(QWidget *parent) :
 
     ui->wsjtMulticastAddressEdit->setValidator(new QRegularExpressionValidator(multicastAddress, this));
 
-    iotaCompleter = new QCompleter(Data::instance()->iotaIDList(), this);
+    iotaCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::IOTA, this), this);
     iotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     iotaCompleter->setFilterMode(Qt::MatchContains);
     iotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->stationIOTAEdit->setCompleter(iotaCompleter);
 
-    sotaCompleter = new QCompleter(Data::instance()->sotaIDList(), this);
+    sotaCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::SOTA, this), this);
     sotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     sotaCompleter->setFilterMode(Qt::MatchStartsWith);
     sotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->stationSOTAEdit->setCompleter(nullptr);
 
-    wwffCompleter = new QCompleter(Data::instance()->wwffIDList(), this);
+    wwffCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::WWFF, this), this);
     wwffCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     wwffCompleter->setFilterMode(Qt::MatchStartsWith);
     wwffCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->stationWWFFEdit->setCompleter(nullptr);
 
-    potaCompleter = new QCompleter(Data::instance()->potaIDList(), this);
+    potaCompleter = new QCompleter(new ReferenceSnapshotModel(ReferenceSnapshot::POTA, this), this);
     potaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     potaCompleter->setFilterMode(Qt::MatchStartsWith);
     potaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -2036,6 +2050,8 @@ void SettingsDialog::readSettings() {
 
     ui->secondaryCallbookCombo->setCurrentIndex(secondaryCallbookIndex);
 
+    ui->callbookPrefetchCheckBox->setChecked(settings.value(CallbookPrefetcher::CONFIG_PREFETCH_ENABLED_KEY, false).toBool());
+
     ui->hamQthUsernameEdit->setText(HamQTH::getUsername());
     ui->hamQthPasswordEdit->setText(HamQTH::getPassword());
 
@@ -2152,6 +2168,8 @@ void SettingsDialog::writeSettings() {
                       ui->primaryCallbookCombo->itemData(ui->primaryCallbookCombo->currentIndex()).toString());
     settings.setValue(GenericCallbook::CONFIG_SECONDARY_CALLBOOK_KEY,
                       ui->secondaryCallbookCombo->itemData(ui->secondaryCallbookCombo->currentIndex()).toString());
+    settings.setValue(CallbookPrefetcher::CONFIG_PREFETCH_ENABLED_KEY,
+                      ui->callbookPrefetchCheckBox->isChecked());
 
     settings.setValue(GenericCallbook::CONFIG_WEB_LOOKUP_URL,
                       ui->webLookupURLEdit->text());
@@ -2206,6 +2224,8 @@ void SettingsDialog::writeSettings() {
         settings.setValue("dxcc/start", QVariant());
     }
 
+    Data::invalidateDxccStatus();
+
     /*************/
     /* Paper QSL */
     /*************/
@@ -16,6 +16,8 @@
 
 MODULE_IDENTIFICATION("qlog.ui.wsjtxswidget");
 
+#define DECODE_CYCLE_COMMIT_TIME 200
+
 WsjtxWidget::WsjtxWidget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::WsjtxWidget),
@@ -40,6 +42,10 @@ WsjtxWidget::WsjtxWidget(QWidget *parent) :
 
     contregexp.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
 
+    decodeCycleTimer.setInterval(DECODE_CYCLE_COMMIT_TIME);
+    decodeCycleTimer.setSingleShot(true);
+    connect(&decodeCycleTimer, &QTimer::timeout, this, &WsjtxWidget::commitDecodeCycle);
+
     reloadSetting();
 }
 
@@ -142,10 +148,19 @@ void WsjtxWidget::decodeReceived(WsjtxDecode decode)
         }
     }
 
-    wsjtxTableModel->spotAging();
-    proxyModel->sort(4, Qt::DescendingOrder);
+    // decodes of one decode cycle are shown together
+    if ( !decodeCycleTimer.isActive() )
+    {
+        decodeCycleTimer.start();
+    }
+}
 
-    ui->tableView->repaint();
+void WsjtxWidget::commitDecodeCycle()
+{
+    FCT_IDENTIFICATION;
+
+    wsjtxTableModel->commitUpdates();
+    proxyModel->sort(4, Qt::DescendingOrder);
 
     setSelectedCallsign(lastSelectedCallsign);
 }
@@ -181,8 +196,6 @@ void WsjtxWidget::statusReceived(WsjtxStatus newStatus)
     }
 
     status = newStatus;
-    wsjtxTableModel->spotAging();
-    ui->tableView->repaint();
 }
 
 void WsjtxWidget::tableViewDoubleClicked(QModelIndex index)
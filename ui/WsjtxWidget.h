@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
+#include <QTimer>
 #include "data/WsjtxEntry.h"
 #include "models/WsjtxTableModel.h"
 
@@ -29,6 +30,7 @@ public slots:
 private slots:
     void displayedColumns();
     void actionFilter();
+    void commitDecodeCycle();
 
 signals:
     void showDxDetails(QString callsign, QString grid);
@@ -56,6 +58,7 @@ private:
     int snrFilter;
     uint dxccStatusFilter;
     QSet<QString> dxMemberFilter;
+    QTimer decodeCycleTimer;
     void saveTableHeaderState();
     void restoreTableHeaderState();
 };